@@ -34,6 +34,20 @@ namespace noise
   {
   };
 
+  /// Cancelled exception
+  ///
+  /// The application cancelled a libnoise operation before it completed.
+  class ExceptionCancelled: public Exception
+  {
+  };
+
+  /// Invalid format exception
+  ///
+  /// Serialized data passed to a libnoise function or method is malformed.
+  class ExceptionInvalidFormat: public Exception
+  {
+  };
+
   /// Invalid parameter exception
   ///
   /// An invalid parameter was passed to a libnoise function or method.
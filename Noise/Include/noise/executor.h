@@ -0,0 +1,347 @@
+// executor.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+#ifndef NOISE_EXECUTOR_H
+#define NOISE_EXECUTOR_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+#include "module/modulebase.h"
+
+namespace noise
+{
+
+	/// @addtogroup libnoise
+	/// @{
+
+	/// Default number of threads used by the Noise::RasterExecutor class.
+	const int DEFAULT_EXECUTOR_THREAD_COUNT = 1;
+
+	/// Evaluates a graph of Noise modules over a tile of input values, one
+	/// Noise module at a time.
+	///
+	/// Calling GetValues() on the root of a graph evaluates every path
+	/// through the graph separately, so a Noise module that is shared by
+	/// several Noise modules is evaluated once for each of them.  This
+	/// class instead sorts the Noise modules of a graph in topological order
+	/// and evaluates each of them once over the whole tile, storing its
+	/// output values in a buffer that is read by the Noise modules that
+	/// depend on it.
+	///
+	/// Only Noise modules whose IsPointwise() method returns @a true are
+	/// split up this way.  Generator modules, and Noise modules that
+	/// evaluate their source modules at other input values, such as
+	/// Noise::module::Displace or Noise::module::Turbulence, are evaluated
+	/// by their own GetValues() method.
+	///
+	/// Buffers are assigned when the graph is planned.  A buffer is returned
+	/// to a free list as soon as the last Noise module that reads it has
+	/// been evaluated, and is then reused by the next Noise module, so the
+	/// number of buffers depends on the width of the graph rather than its
+	/// size.
+	///
+	/// For each tile, Noise modules such as Noise::module::Select may use
+	/// the range of their control module to report that some of their
+	/// source modules are not needed; those source modules, and every Noise
+	/// module that is only needed by them, are skipped for that tile.
+	///
+	/// The output values are identical to those returned by GetValues().
+	/// The graph is planned again whenever its combined version, returned
+	/// by Noise::GetGraphVersion(), changes.
+	///
+	/// The noise map builders in the Noise::utils namespace use this class
+	/// to evaluate each row of a Noise map.
+	///
+	/// <b>Evaluating several roots at once</b>
+	///
+	/// Applications often need several outputs from graphs that share large
+	/// subgraphs, such as an elevation and the surface, moisture or
+	/// temperature derived from it.  Pass all of the roots to the
+	/// SetModules() method, then call the GetValues() method that takes one
+	/// output array per root.  The roots are planned as a single graph, so
+	/// a Noise module that several roots depend on is evaluated once per
+	/// tile, and a root may itself be a source module of another root.
+	///
+	/// <b>Evaluating independent subgraphs concurrently</b>
+	///
+	/// Graphs are often wide: several subgraphs, such as the continents,
+	/// the terrain types and the rivers of a planet, are only combined near
+	/// the root.  Passing a value greater than one to the SetThreadCount()
+	/// method evaluates the steps of a tile as a task graph on a pool of
+	/// worker threads, so that steps whose inputs are ready run at the same
+	/// time.  A step waits for the steps that produce its inputs, and for
+	/// the steps that last used the buffer it writes to.  This reduces the
+	/// latency of small tiles, for which splitting the tile itself between
+	/// threads scales poorly.
+	///
+	/// Noise modules that are evaluated by their own GetValues() method may
+	/// be called from several threads at once, so they must not modify
+	/// shared state.  Two such steps are never run at the same time if
+	/// their subgraphs share a Noise module that has source modules, since
+	/// that Noise module may be a caching module.  Generator modules are
+	/// assumed to be safe to call from several threads at once.
+	class RasterExecutor
+	{
+
+	public:
+
+		/// Constructor.
+		///
+		/// Before an application can call the GetValues() method, it must
+		/// pass the root of a graph to the SetModule() method.
+		RasterExecutor();
+
+		/// Constructor.
+		///
+		/// @param root The Noise module at the root of the graph.
+		///
+		/// @throw Noise::ExceptionNoModule A Noise module in the graph is
+		/// missing a source module.
+		explicit RasterExecutor(const module::Module& root);
+
+		/// Constructor.
+		///
+		/// @param roots The Noise modules at the roots of the graphs.
+		///
+		/// @throw Noise::ExceptionInvalidParam No root was specified.
+		/// @throw Noise::ExceptionNoModule A Noise module in the graphs is
+		/// missing a source module.
+		explicit RasterExecutor(const std::vector<const module::Module*>& roots);
+
+		/// Destructor.
+		~RasterExecutor();
+
+		RasterExecutor(const RasterExecutor&) = delete;
+
+		RasterExecutor& operator=(const RasterExecutor&) = delete;
+
+		/// Returns the number of intermediate buffers used by the plan.
+		///
+		/// @returns The number of buffers.
+		int GetBufferCount() const
+		{
+			return (int)m_buffers.size();
+		}
+
+		/// Returns the number of roots.
+		///
+		/// @returns The number of output arrays filled in by GetValues().
+		int GetRootCount() const
+		{
+			return (int)m_roots.size();
+		}
+
+		/// Returns the number of Noise modules evaluated separately for each
+		/// tile, including the roots.
+		///
+		/// @returns The number of steps in the plan.
+		int GetStepCount() const
+		{
+			return (int)m_steps.size();
+		}
+
+		/// Returns the number of threads that evaluate the steps of a tile.
+		///
+		/// @returns The number of threads, including the calling thread.
+		int GetThreadCount() const
+		{
+			return m_threadCount;
+		}
+
+		/// Generates the output values of the graph for a tile of input
+		/// values.
+		///
+		/// @param count The number of input values.
+		/// @param x The @a x coordinates of the input values.
+		/// @param y The @a y coordinates of the input values.
+		/// @param z The @a z coordinates of the input values.
+		/// @param out On exit, the output values.
+		///
+		/// @pre The root of a graph was passed to the SetModule() method.
+		///
+		/// @throw Noise::ExceptionNoModule A Noise module in the graph is
+		/// missing a source module.
+		///
+		/// If several roots were passed to the SetModules() method, only the
+		/// output values of the first root are generated.
+		void GetValues(int count, const double* x, const double* y,
+			const double* z, double* out);
+
+		/// Generates the output values of every root for a tile of input
+		/// values.
+		///
+		/// @param count The number of input values.
+		/// @param x The @a x coordinates of the input values.
+		/// @param y The @a y coordinates of the input values.
+		/// @param z The @a z coordinates of the input values.
+		/// @param out For each root, in the order passed to the SetModules()
+		/// method, an array that receives its output values.
+		///
+		/// @pre The roots of the graphs were passed to the SetModules()
+		/// method.
+		///
+		/// @throw Noise::ExceptionNoModule A Noise module in the graphs is
+		/// missing a source module.
+		///
+		/// The output arrays must not overlap.
+		void GetValues(int count, const double* x, const double* y,
+			const double* z, double* const* out);
+
+		/// Sets the graph to evaluate.
+		///
+		/// @param root The Noise module at the root of the graph.
+		///
+		/// @throw Noise::ExceptionNoModule A Noise module in the graph is
+		/// missing a source module.
+		///
+		/// The Noise modules in the graph must exist for as long as this
+		/// object evaluates them.
+		void SetModule(const module::Module& root);
+
+		/// Sets several graphs to evaluate together.
+		///
+		/// @param roots The Noise modules at the roots of the graphs.
+		///
+		/// @pre At least one root is specified.
+		///
+		/// @throw Noise::ExceptionInvalidParam An invalid parameter was
+		/// specified; see the preconditions for more information.
+		/// @throw Noise::ExceptionNoModule A Noise module in the graphs is
+		/// missing a source module.
+		///
+		/// The Noise modules in the graphs must exist for as long as this
+		/// object evaluates them.
+		void SetModules(const std::vector<const module::Module*>& roots);
+
+		/// Sets the number of threads that evaluate the steps of a tile.
+		///
+		/// @param threadCount The number of threads, including the calling
+		/// thread.
+		///
+		/// @pre The number of threads is positive.
+		///
+		/// @throw Noise::ExceptionInvalidParam An invalid parameter was
+		/// specified; see the preconditions for more information.
+		///
+		/// The worker threads are started by this method and wait for tiles
+		/// until this object is destroyed or the number of threads changes.
+		void SetThreadCount(int threadCount);
+
+	private:
+
+		/// A Noise module evaluated over the whole tile.
+		struct Step
+		{
+
+			/// The Noise module.
+			const module::Module* pModule;
+
+			/// For a pointwise Noise module, the step of each source module;
+			/// otherwise empty.
+			std::vector<int> sources;
+
+			/// Index of the first flag of this step in the array of needed
+			/// source modules.
+			int firstFlag;
+
+			/// Index of the buffer receiving the output values, or -1 for a
+			/// root.
+			int buffer;
+
+			/// Index of the output array receiving the output values if the
+			/// Noise module is a root, or -1.
+			int output;
+
+			/// The steps that must wait for this step to finish.
+			std::vector<int> dependents;
+
+			/// Number of steps this step must wait for.
+			int dependencyCount;
+
+		};
+
+		/// Pool of threads that evaluates the steps of a tile concurrently.
+		class WorkerPool;
+
+		/// Adds a Noise module and the source modules it combines to the
+		/// plan.
+		///
+		/// @returns The index of the step that evaluates the Noise module.
+		int AddStep(const module::Module& module,
+			std::map<const module::Module*, int>& stepIndex);
+
+		/// Sorts the graph into steps and assigns their buffers.
+		void Plan();
+
+		/// Determines the steps that each step must wait for when the steps
+		/// run concurrently.
+		void PlanDependencies();
+
+		/// Evaluates one step over a tile of input values.
+		///
+		/// The step is skipped if it is not needed for the tile.
+		void RunStep(int index, int count, const double* x, const double* y,
+			const double* z, double* const* out);
+
+		/// The buffers holding the output values of each step.
+		std::vector<std::vector<double>> m_buffers;
+
+		/// For each step, whether it is needed for the current tile.
+		std::vector<char> m_isStepNeeded;
+
+		/// For each source module of each step, whether it is needed for the
+		/// current tile.
+		std::unique_ptr<bool[]> m_isSourceNeeded;
+
+		/// The combined version of the graph when it was planned.
+		std::uint64_t m_planVersion;
+
+		/// The Noise modules at the roots of the graphs.
+		std::vector<const module::Module*> m_roots;
+
+		/// The step that evaluates each root.
+		std::vector<int> m_rootSteps;
+
+		/// The worker threads, or an empty pointer if only the calling
+		/// thread evaluates the steps.
+		std::unique_ptr<WorkerPool> m_pWorkers;
+
+		/// Pointers to the output values of the source modules of each
+		/// step, indexed like the flags of needed source modules.
+		std::vector<const double*> m_sourceValues;
+
+		/// The steps, in topological order.
+		std::vector<Step> m_steps;
+
+		/// Number of threads that evaluate the steps of a tile.
+		int m_threadCount;
+
+	};
+
+	/// @}
+
+}
+
+#endif
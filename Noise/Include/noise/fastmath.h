@@ -0,0 +1,329 @@
+// fastmath.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#ifndef NOISE_FASTMATH_H
+#define NOISE_FASTMATH_H
+
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include "mathconsts.h"
+
+namespace noise
+{
+
+	/// @addtogroup libnoise
+	/// @{
+
+	/// Largest relative error of FastExp().
+	const double FAST_EXP_MAX_ERROR = 1.0e-14;
+
+	/// Largest error of FastLog(), relative to one plus the magnitude of the
+	/// logarithm.
+	const double FAST_LOG_MAX_ERROR = 1.0e-14;
+
+	/// Largest relative error of FastPow(), relative to one plus the
+	/// magnitude of the exponent multiplied by the logarithm of the base.
+	const double FAST_POW_MAX_ERROR = 3.0e-14;
+
+	/// Largest absolute error of the values calculated by FastSinCos().
+	const double FAST_SINCOS_MAX_ERROR = 4.0e-16;
+
+	/// Largest magnitude of the argument to FastExp().
+	const double FAST_EXP_MAX_ARGUMENT = 708.0;
+
+	/// Largest magnitude of the angle passed to FastSinCos().
+	const double FAST_SINCOS_MAX_ANGLE = 100000.0;
+
+	/// Calculates an approximation of the exponential function.
+	///
+	/// @param x The exponent.
+	///
+	/// @returns An approximation of @b e raised to the power of @a x.
+	///
+	/// @pre The magnitude of @a x is less than
+	/// Noise::FAST_EXP_MAX_ARGUMENT.
+	///
+	/// The exponent is reduced to the range -ln (2) / 2 to +ln (2) / 2 and
+	/// the exponential function is evaluated on that range by a polynomial
+	/// of degree 11.  The relative error is at most
+	/// Noise::FAST_EXP_MAX_ERROR.
+	///
+	/// This function contains no branches, so loops that call it can be
+	/// vectorized.
+	inline double FastExp (double x)
+	{
+		// Split the exponent into an integer multiple of ln (2) and a
+		// remainder.  Adding and subtracting 1.5 * 2^52 rounds to the nearest
+		// integer.  The high part of ln (2) has enough trailing zeros that
+		// its product with the multiple is exact.
+		const double LN2_HI = 6.93147180369123816490e-01;
+		const double LN2_LO = 1.90821492927058770002e-10;
+		const double ROUND = 6755399441055744.0;
+		double k = (x * 1.44269504088896340736 + ROUND) - ROUND;
+		double r = (x - k * LN2_HI) - k * LN2_LO;
+
+		// Evaluate the polynomial with Estrin's scheme, which shortens the
+		// chain of dependent operations.
+		double r2 = r * r;
+		double r4 = r2 * r2;
+		double r8 = r4 * r4;
+		double p = ((1.0 + r) + r2 * (1.0 / 2.0 + r * (1.0 / 6.0)))
+			+ r4 * ((1.0 / 24.0 + r * (1.0 / 120.0))
+				+ r2 * (1.0 / 720.0 + r * (1.0 / 5040.0)))
+			+ r8 * ((1.0 / 40320.0 + r * (1.0 / 362880.0))
+				+ r2 * (1.0 / 3628800.0 + r * (1.0 / 39916800.0)));
+
+		// Multiply by two raised to the power of the multiple by building
+		// the bits of that power directly.
+		std::uint64_t bits = (std::uint64_t)((std::int64_t)k + 1023) << 52;
+		double scale;
+		std::memcpy (&scale, &bits, sizeof (scale));
+		return p * scale;
+	}
+
+	/// Calculates an approximation of the natural logarithm.
+	///
+	/// @param x The value.
+	///
+	/// @returns An approximation of the natural logarithm of @a x.
+	///
+	/// @pre @a x is a positive, finite, normalized floating-point value.
+	///
+	/// The mantissa of @a x is reduced to the range sqrt (0.5) to sqrt (2),
+	/// where the logarithm is evaluated by an odd polynomial of degree 17 in
+	/// (m - 1) / (m + 1).  The absolute error is at most
+	/// Noise::FAST_LOG_MAX_ERROR * (1 + |ln (@a x)|).
+	///
+	/// This function contains no branches, so loops that call it can be
+	/// vectorized.
+	inline double FastLog (double x)
+	{
+		const double LN2_HI = 6.93147180369123816490e-01;
+		const double LN2_LO = 1.90821492927058770002e-10;
+
+		// Subtracting the bits of sqrt (0.5) before extracting the exponent
+		// places the mantissa in the range sqrt (0.5) to sqrt (2).
+		std::uint64_t bits;
+		std::memcpy (&bits, &x, sizeof (bits));
+		std::int64_t e = (std::int64_t)(bits - 0x3fe6a09e667f3bcdULL) >> 52;
+		bits -= (std::uint64_t)e << 52;
+		double m;
+		std::memcpy (&m, &bits, sizeof (m));
+
+		double s = (m - 1.0) / (m + 1.0);
+		double s2 = s * s;
+		double s4 = s2 * s2;
+		double s8 = s4 * s4;
+		double q = ((1.0 + s2 * (1.0 / 3.0))
+			+ s4 * (1.0 / 5.0 + s2 * (1.0 / 7.0)))
+			+ s8 * (((1.0 / 9.0 + s2 * (1.0 / 11.0))
+				+ s4 * (1.0 / 13.0 + s2 * (1.0 / 15.0)))
+				+ s8 * (1.0 / 17.0));
+		return e * LN2_HI + (2.0 * s * q + e * LN2_LO);
+	}
+
+	/// Calculates approximations of the sine and cosine of an angle.
+	///
+	/// @param angle The angle, in radians.
+	/// @param sinValue On exit, an approximation of the sine of the angle.
+	/// @param cosValue On exit, an approximation of the cosine of the angle.
+	///
+	/// @pre The magnitude of @a angle is less than
+	/// Noise::FAST_SINCOS_MAX_ANGLE.
+	///
+	/// The angle is reduced to the range -pi / 4 to +pi / 4 with a
+	/// three-part representation of pi / 2, and both functions are
+	/// evaluated on that range by polynomials of degree 15 and 16 that share
+	/// the reduction.  The absolute error of each value is at most
+	/// Noise::FAST_SINCOS_MAX_ERROR.
+	///
+	/// This function contains no branches, so loops that call it can be
+	/// vectorized.
+	inline void FastSinCos (double angle, double& sinValue, double& cosValue)
+	{
+		// Each part of pi / 2 has 33 significant bits, so that its product
+		// with the quadrant number is exact.
+		const double PIO2_1 = 1.57079632673412561417e+00;
+		const double PIO2_2 = 6.07710050650619224932e-11;
+		const double PIO2_3 = 2.02226624871116645580e-21;
+		const double ROUND = 6755399441055744.0;
+		double k = (angle * (2.0 / PI) + ROUND) - ROUND;
+		double r = ((angle - k * PIO2_1) - k * PIO2_2) - k * PIO2_3;
+
+		double r2 = r * r;
+		double s = r + r * r2 * (-1.0 / 6.0 + r2 * (1.0 / 120.0
+			+ r2 * (-1.0 / 5040.0 + r2 * (1.0 / 362880.0
+			+ r2 * (-1.0 / 39916800.0 + r2 * (1.0 / 6227020800.0
+			+ r2 * (-1.0 / 1307674368000.0)))))));
+		double c = 1.0 - 0.5 * r2 + r2 * r2 * (1.0 / 24.0
+			+ r2 * (-1.0 / 720.0 + r2 * (1.0 / 40320.0
+			+ r2 * (-1.0 / 3628800.0 + r2 * (1.0 / 479001600.0
+			+ r2 * (-1.0 / 87178291200.0 + r2 * (1.0 / 20922789888000.0)))))));
+
+		// Rotate the results into the quadrant of the angle.
+		std::int64_t quadrant = (std::int64_t)k;
+		double sinReduced = (quadrant & 1)? c: s;
+		double cosReduced = (quadrant & 1)? s: c;
+		sinValue = (quadrant & 2)? -sinReduced: sinReduced;
+		cosValue = ((quadrant + 1) & 2)? -cosReduced: cosReduced;
+	}
+
+	/// Calculates an approximation of a value raised to a power.
+	///
+	/// @param base The base.
+	/// @param exponent The exponent.
+	///
+	/// @returns An approximation of @a base raised to the power of
+	/// @a exponent.
+	///
+	/// The power is calculated as FastExp (@a exponent * FastLog (@a base)).
+	/// The relative error is at most Noise::FAST_POW_MAX_ERROR *
+	/// (1 + |@a exponent * ln (@a base)|).  Bases that are zero, negative,
+	/// denormalized, infinite or NaN, and results that would overflow or
+	/// underflow, are calculated by pow() so that the special cases match the
+	/// C library.
+	inline double FastPow (double base, double exponent)
+	{
+		if (base >= DBL_MIN && base < HUGE_VAL) {
+			double y = exponent * FastLog (base);
+			if (fabs (y) < FAST_EXP_MAX_ARGUMENT) {
+				return FastExp (y);
+			}
+		}
+		return pow (base, exponent);
+	}
+
+	/// Raises a value to a power.
+	///
+	/// @param base The base.
+	/// @param exponent The exponent.
+	///
+	/// @returns @a base raised to the power of @a exponent.
+	///
+	/// Noise modules call this function instead of pow().  If libnoise is
+	/// built with the @b NOISE_FAST_MATH option, it calls FastPow();
+	/// otherwise, it calls pow().
+	inline double MathPow (double base, double exponent)
+	{
+#ifdef NOISE_FAST_MATH
+		return FastPow (base, exponent);
+#else
+		return pow (base, exponent);
+#endif
+	}
+
+	/// Raises several values to a power.
+	///
+	/// @param count The number of values.
+	/// @param base The bases.
+	/// @param exponent The exponent.
+	/// @param out On exit, each base raised to the power of @a exponent.
+	///
+	/// The @a out array may be the same array as the @a base array.  If
+	/// libnoise is built with the @b NOISE_FAST_MATH option, the powers are
+	/// calculated in a vectorizable loop, and the values outside of the
+	/// domain of FastPow() are then recalculated by pow().
+	void MathPow (int count, const double* base, double exponent, double* out);
+
+	/// Raises several values to several powers.
+	///
+	/// @param count The number of values.
+	/// @param base The bases.
+	/// @param exponent The exponents.
+	/// @param out On exit, each base raised to the power of its exponent.
+	///
+	/// The @a out array may be the same array as the @a base or the
+	/// @a exponent array.  If libnoise is built with the @b NOISE_FAST_MATH
+	/// option, the powers are calculated in a vectorizable loop, and the
+	/// values outside of the domain of FastPow() are then recalculated by
+	/// pow().
+	void MathPow (int count, const double* base, const double* exponent,
+		double* out);
+
+	/// Returns the largest relative difference between the values returned
+	/// by MathPow() and pow().
+	///
+	/// @param base The base.
+	/// @param exponent The exponent.
+	///
+	/// @returns The largest relative difference, which is zero unless
+	/// libnoise is built with the @b NOISE_FAST_MATH option.
+	///
+	/// Noise modules use this function to widen the ranges of output values
+	/// that they calculate with pow(), so that the ranges contain every
+	/// value that MathPow() can return.
+	inline double MathPowError ([[maybe_unused]] double base,
+		[[maybe_unused]] double exponent)
+	{
+#ifdef NOISE_FAST_MATH
+		if (!(base >= DBL_MIN && base < HUGE_VAL && fabs (exponent) < HUGE_VAL)) {
+			return 0.0;
+		}
+		return FAST_POW_MAX_ERROR * (1.0 + fabs (exponent * log (base)));
+#else
+		return 0.0;
+#endif
+	}
+
+	/// Calculates the sine and cosine of an angle.
+	///
+	/// @param angle The angle, in radians.
+	/// @param sinValue On exit, the sine of the angle.
+	/// @param cosValue On exit, the cosine of the angle.
+	///
+	/// Noise models and Noise-map builders call this function instead of
+	/// sin() and cos().  If libnoise is built with the @b NOISE_FAST_MATH
+	/// option, it calls FastSinCos() for angles within its domain;
+	/// otherwise, it calls sin() and cos().
+	inline void MathSinCos (double angle, double& sinValue, double& cosValue)
+	{
+#ifdef NOISE_FAST_MATH
+		if (fabs (angle) < FAST_SINCOS_MAX_ANGLE) {
+			FastSinCos (angle, sinValue, cosValue);
+			return;
+		}
+#endif
+		sinValue = sin (angle);
+		cosValue = cos (angle);
+	}
+
+	/// Calculates the sines and cosines of several angles.
+	///
+	/// @param count The number of angles.
+	/// @param angle The angles, in radians.
+	/// @param sinValue On exit, the sines of the angles.
+	/// @param cosValue On exit, the cosines of the angles.
+	///
+	/// The output arrays must not overlap the @a angle array.  If libnoise
+	/// is built with the @b NOISE_FAST_MATH option, the values are
+	/// calculated in a vectorizable loop, and the angles outside of the
+	/// domain of FastSinCos() are then recalculated by sin() and cos().
+	void MathSinCos (int count, const double* angle, double* sinValue,
+		double* cosValue);
+
+	/// @}
+
+}
+
+#endif
@@ -0,0 +1,189 @@
+// graph.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+#ifndef NOISE_GRAPH_H
+#define NOISE_GRAPH_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "module/modulebase.h"
+
+namespace noise
+{
+
+	class ModuleGraph;
+
+	/// @addtogroup libnoise
+	/// @{
+
+	/// The class and parameters of a Noise module.
+	///
+	/// A description holds everything needed to recreate a Noise module
+	/// except its source modules.  Parameters are stored as named numbers;
+	/// integer, enumerated and boolean parameters are converted to double.
+	/// The control points of Noise::module::Curve and Noise::module::Terrace
+	/// Noise modules are stored separately, as consecutive input and output
+	/// values for a curve and as plain values for a terrace.
+	struct ModuleDescription
+	{
+
+		/// The name of the class, without its namespace.
+		std::string className;
+
+		/// The parameters, as ( name, value ) pairs.
+		std::vector<std::pair<std::string, double>> parameters;
+
+		/// The control points.
+		std::vector<double> controlPoints;
+
+	};
+
+	/// Returns the number of distinct Noise modules in a graph.
+	///
+	/// @param root The Noise module at the root of the graph.
+	///
+	/// @returns The number of Noise modules, including the root.
+	///
+	/// @throw Noise::ExceptionNoModule A Noise module in the graph is
+	/// missing a source module.
+	///
+	/// A Noise module that is shared by several Noise modules is counted
+	/// once.
+	int CountModules(const module::Module& root);
+
+	/// Creates a Noise module from its description.
+	///
+	/// @param description The class and parameters of the Noise module.
+	///
+	/// @returns The new Noise module.
+	///
+	/// @pre The description names a class that is part of libnoise.
+	/// @pre Every parameter is known to that class and has a valid value.
+	///
+	/// @throw Noise::ExceptionInvalidParam An invalid parameter was
+	/// specified; see the preconditions for more information.
+	///
+	/// Parameters missing from the description keep their default values.
+	/// None of the source modules of the new Noise module are set.
+	std::unique_ptr<module::Module> CreateModule(
+		const ModuleDescription& description);
+
+	/// Creates a copy of a Noise module.
+	///
+	/// @param original The Noise module to copy.
+	///
+	/// @returns The copy, or an empty pointer if the class of the Noise
+	/// module is not part of libnoise.
+	///
+	/// The copy has the same parameters as the original Noise module, but
+	/// none of its source modules are set.  The internal state of caching
+	/// Noise modules is not copied.
+	std::unique_ptr<module::Module> CopyModule(const module::Module& original);
+
+	/// Describes the class and parameters of a Noise module.
+	///
+	/// @param module The Noise module.
+	/// @param description The description to fill in.
+	///
+	/// @returns
+	/// - @a true if the description was filled in.
+	/// - @a false if the class of the Noise module is not part of libnoise.
+	///
+	/// The parameters are listed in the same order for every Noise module
+	/// of a class.
+	bool DescribeModule(const module::Module& module,
+		ModuleDescription& description);
+
+	/// Returns the combined version of a graph of Noise modules.
+	///
+	/// @param root The Noise module at the root of the graph.
+	///
+	/// @returns The greatest version of any Noise module in the graph.
+	///
+	/// @throw Noise::ExceptionNoModule A Noise module in the graph is
+	/// missing a source module.
+	///
+	/// Since a new version is greater than every version handed out before
+	/// it, the combined version changes whenever a parameter or a source
+	/// module of any Noise module in the graph changes.  An application can
+	/// store the combined version alongside values generated by the graph,
+	/// such as a Noise map, and regenerate those values only when the
+	/// combined version differs.
+	///
+	/// Like Noise::CountModules(), this function visits every Noise module
+	/// in the graph.
+	std::uint64_t GetGraphVersion(const module::Module& root);
+
+	/// Returns the class name of a Noise module.
+	///
+	/// @param module The Noise module.
+	///
+	/// @returns The name of the class, without its namespace, or an
+	/// implementation-defined name if the class is not part of libnoise.
+	std::string GetModuleClassName(const module::Module& module);
+
+	/// Creates a copy of a graph of Noise modules whose fractal generators
+	/// stop at a given level of detail.
+	///
+	/// @param root The Noise module at the root of the graph.
+	/// @param maxFrequency The highest frequency to keep, measured in cycles
+	/// per unit of the input coordinates passed to the root.
+	///
+	/// @returns The copy of the graph.
+	///
+	/// @pre The maximum frequency is positive.
+	///
+	/// @throw Noise::ExceptionInvalidParam An invalid parameter was
+	/// specified, or the graph contains a Noise module whose class is not
+	/// part of libnoise.
+	/// @throw Noise::ExceptionNoModule A Noise module in the graph is
+	/// missing a source module.
+	///
+	/// Octaves whose frequency is higher than the spacing of the input
+	/// values can resolve only add aliasing, yet each of them costs as much
+	/// to evaluate as the first.  In the copy, the octave count of each
+	/// Noise::module::Perlin, Noise::module::Billow and
+	/// Noise::module::RidgedMulti Noise module, and the roughness of each
+	/// Noise::module::Turbulence Noise module, is reduced so that its last
+	/// octave does not exceed the maximum frequency.  At least one octave is
+	/// always kept, and no octave count is increased.
+	///
+	/// The frequency of an octave is the frequency of its Noise module,
+	/// multiplied by the largest scale that the Noise::module::ScalePoint
+	/// and Noise::module::TransformPoint Noise modules between it and the
+	/// root apply to the input coordinates.  Other Noise modules are assumed
+	/// not to scale the input coordinates.
+	///
+	/// Every other parameter of the copy is identical to the original graph,
+	/// which is not modified.
+	std::unique_ptr<ModuleGraph> LimitGraphDetail(const module::Module& root,
+		double maxFrequency);
+
+	/// @}
+
+}
+
+#endif
@@ -0,0 +1,224 @@
+// interval.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#ifndef NOISE_INTERVAL_H
+#define NOISE_INTERVAL_H
+
+#include <cmath>
+
+namespace noise
+{
+
+	/// @addtogroup libnoise
+	/// @{
+
+	/// A closed range of values.
+	///
+	/// Intervals are used to describe a conservative range of output values
+	/// that a Noise module can generate.  An unbounded interval is
+	/// represented by infinite bounds.
+	struct Interval
+	{
+
+		/// The lower bound of the interval.
+		double lower;
+
+		/// The upper bound of the interval.
+		double upper;
+
+	};
+
+	/// An axis-aligned box of input values.
+	struct Box
+	{
+
+		/// The range of @a x coordinates.
+		Interval x;
+
+		/// The range of @a y coordinates.
+		Interval y;
+
+		/// The range of @a z coordinates.
+		Interval z;
+
+	};
+
+	/// Returns an interval that contains every value.
+	///
+	/// @returns The unbounded interval.
+	inline Interval UnboundedInterval ()
+	{
+		return Interval {-HUGE_VAL, HUGE_VAL};
+	}
+
+	/// Returns a box that contains every input value.
+	///
+	/// @returns The unbounded box.
+	inline Box UnboundedBox ()
+	{
+		return Box {UnboundedInterval (), UnboundedInterval (),
+			UnboundedInterval ()};
+	}
+
+	/// Returns the smallest box that contains a set of input values.
+	///
+	/// @param count The number of input values.
+	/// @param x The @a x coordinates of the input values.
+	/// @param y The @a y coordinates of the input values.
+	/// @param z The @a z coordinates of the input values.
+	///
+	/// @returns The bounding box.
+	///
+	/// @pre @a count is positive.
+	inline Box MakeBoundingBox (int count, const double* x, const double* y,
+		const double* z)
+	{
+		Box box {{x[0], x[0]}, {y[0], y[0]}, {z[0], z[0]}};
+		for (int i = 1; i < count; i++) {
+			box.x.lower = std::fmin (box.x.lower, x[i]);
+			box.x.upper = std::fmax (box.x.upper, x[i]);
+			box.y.lower = std::fmin (box.y.lower, y[i]);
+			box.y.upper = std::fmax (box.y.upper, y[i]);
+			box.z.lower = std::fmin (box.z.lower, z[i]);
+			box.z.upper = std::fmax (box.z.upper, z[i]);
+		}
+		return box;
+	}
+
+	/// Returns the sum of two intervals.
+	inline Interval IntervalAdd (const Interval& a, const Interval& b)
+	{
+		return Interval {a.lower + b.lower, a.upper + b.upper};
+	}
+
+	/// Returns an interval shifted by a constant.
+	inline Interval IntervalAdd (const Interval& a, double b)
+	{
+		return Interval {a.lower + b, a.upper + b};
+	}
+
+	/// Returns the product of two intervals.
+	///
+	/// Products of zero and infinity are treated as unbounded.
+	inline Interval IntervalMultiply (const Interval& a, const Interval& b)
+	{
+		double p0 = a.lower * b.lower;
+		double p1 = a.lower * b.upper;
+		double p2 = a.upper * b.lower;
+		double p3 = a.upper * b.upper;
+		if (std::isnan (p0) || std::isnan (p1) || std::isnan (p2)
+			|| std::isnan (p3)) {
+			return UnboundedInterval ();
+		}
+		return Interval {
+			std::fmin (std::fmin (p0, p1), std::fmin (p2, p3)),
+			std::fmax (std::fmax (p0, p1), std::fmax (p2, p3))};
+	}
+
+	/// Returns an interval multiplied by a constant.
+	inline Interval IntervalMultiply (const Interval& a, double b)
+	{
+		return IntervalMultiply (a, Interval {b, b});
+	}
+
+	/// Returns the absolute values of an interval.
+	inline Interval IntervalAbs (const Interval& a)
+	{
+		if (a.lower >= 0.0) {
+			return a;
+		} else if (a.upper <= 0.0) {
+			return Interval {-a.upper, -a.lower};
+		} else {
+			return Interval {0.0, std::fmax (-a.lower, a.upper)};
+		}
+	}
+
+	/// Returns the range of distances from the origin to the points of a
+	/// box.
+	///
+	/// The distances are calculated as sqrt (x * x + y * y + z * z), in
+	/// that order, from the bounds of the box.  Since every step of that
+	/// calculation is monotonic, even after rounding, the range contains
+	/// the distance calculated the same way for any point of the box.
+	inline Interval IntervalDistance (const Box& box)
+	{
+		Interval x = IntervalAbs (box.x);
+		Interval y = IntervalAbs (box.y);
+		Interval z = IntervalAbs (box.z);
+		return Interval {
+			std::sqrt (x.lower * x.lower + y.lower * y.lower + z.lower * z.lower),
+			std::sqrt (x.upper * x.upper + y.upper * y.upper + z.upper * z.upper)};
+	}
+
+	/// Returns the range of output values of the Noise::module::Spheres and
+	/// Noise::module::Cylinders Noise modules over a range of distances.
+	///
+	/// @param distance The range of distances from the center of the
+	/// shells, in units of the shell spacing.
+	///
+	/// @returns The range of output values.
+	///
+	/// The output value is a triangle wave of the distance, with a peak of
+	/// +1.0 at every whole distance and a trough of -1.0 halfway between.
+	/// If the distances span less than half a period, the output value is
+	/// monotonic between the bounds of the distance except across a single
+	/// peak or trough.
+	inline Interval ShellValueRange (const Interval& distance)
+	{
+		if (!(distance.upper - distance.lower < 0.5)) {
+			return Interval {-1.0, 1.0};
+		}
+		auto getShellValue = [] (double distFromCenter) {
+			double distFromSmallerShell = distFromCenter
+				- std::floor (distFromCenter);
+			double distFromLargerShell = 1.0 - distFromSmallerShell;
+			double nearestDist = std::fmin (distFromSmallerShell,
+				distFromLargerShell);
+			return 1.0 - (nearestDist * 4.0);
+		};
+		double lowerValue = getShellValue (distance.lower);
+		double upperValue = getShellValue (distance.upper);
+		Interval range = {std::fmin (lowerValue, upperValue),
+			std::fmax (lowerValue, upperValue)};
+		double wholeDist = std::floor (distance.lower);
+		if (distance.upper >= wholeDist + 1.0) {
+			range.upper = 1.0;
+		}
+		if (distance.lower <= wholeDist + 0.5
+			&& distance.upper >= wholeDist + 0.5) {
+			range.lower = -1.0;
+		}
+		return range;
+	}
+
+	/// Returns the smallest interval containing two intervals.
+	inline Interval IntervalUnion (const Interval& a, const Interval& b)
+	{
+		return Interval {std::fmin (a.lower, b.lower),
+			std::fmax (a.upper, b.upper)};
+	}
+
+	/// @}
+
+}
+
+#endif
@@ -34,6 +34,10 @@ namespace noise::model
 	/// @addtogroup models
 	/// @{
 
+	/// Default tolerance for the Noise::model::Line::FindIntersection()
+	/// method.
+	const double DEFAULT_LINE_TOLERANCE = 0.0001;
+
 	/// Model that defines the displacement of a line segment.
 	///
     /// This model returns an output value from a Noise module given the
@@ -61,6 +65,52 @@ namespace noise::model
 		/// values.
 		explicit Line(const module::Module& module);
 
+        /// Finds the first position along the line segment at which the output
+        /// value reaches a height that varies linearly along the segment.
+        ///
+        /// @param startHeight The height at the start of the line segment.
+        /// @param endHeight The height at the end of the line segment.
+        /// @param p On exit, if the output value reaches the height, the
+        /// distance along the line segment (ranging from 0.0 to 1.0) at
+        /// which it does so.
+        /// @param tolerance The shortest step along the line segment.
+        ///
+        /// @returns
+        /// - @a true if the output value reaches the height somewhere on the
+        ///   line segment.
+        /// - @a false if not.
+        ///
+        /// @pre A Noise module was passed to the SetModule() method.
+        /// @pre The tolerance is positive.
+        ///
+        /// @throw Noise::ExceptionInvalidParam An invalid parameter was
+        /// specified; see the preconditions for more information.
+        ///
+        /// This method intersects a ray with a height field.  For example,
+        /// to test the line of sight between two points above a terrain
+        /// whose height at ( @a x, @a z ) is the output value of the Noise
+        /// module at ( @a x, 0, @a z ), set the start and end points of the
+        /// line segment to the positions of the two points projected onto
+        /// the ( @a x, 0, @a z ) plane, and pass the heights of the two
+        /// points to this method.  To find where the output value crosses a
+        /// constant threshold, pass that threshold as both heights.
+        ///
+        /// The search is a sphere trace: the gap between the height and the
+        /// output value, divided by the value returned by GetLipschitzBound()
+        /// plus the slope of the height, is a distance that the search can
+        /// step without skipping over an intersection.  Far from the height
+        /// field this takes long steps; near it, the steps shrink to the
+        /// tolerance.  Features narrower than the tolerance may be missed
+        /// where the step is clamped to it, and the position returned lies
+        /// within the tolerance of the first intersection.  If the Noise
+        /// module has no finite Lipschitz bound, the search takes steps of
+        /// the tolerance along the whole line segment.
+        ///
+        /// If the output value is attenuated, the search intersects the
+        /// attenuated output value.
+        bool FindIntersection (double startHeight, double endHeight,
+          double& p, double tolerance = DEFAULT_LINE_TOLERANCE) const;
+
         /// Returns a flag indicating whether the output value is to be
         /// attenuated (moved toward 0.0) as the ends of the line segment are
         /// approached by the input value.
@@ -73,6 +123,21 @@ namespace noise::model
           return m_attenuate;
         }
 
+        /// Returns a conservative bound on the rate of change of the output
+        /// value along the line segment.
+        ///
+        /// @returns A bound on the derivative of the value returned by
+        /// GetValue() with respect to @a p, for @a p ranging from 0.0 to
+        /// 1.0.
+        ///
+        /// @pre A Noise module was passed to the SetModule() method.
+        ///
+        /// The bound is the Lipschitz bound of the Noise module times the
+        /// length of the line segment.  If the output value is attenuated,
+        /// four times the largest magnitude of the output value along the
+        /// line segment is added to it.
+        double GetLipschitzBound () const;
+
         /// Returns the Noise module that is used to generate the output
         /// values.
         ///
@@ -52,6 +52,9 @@ namespace noise::module
         /// Constructor.
         Add ();
 
+		void CombineValues(int count, const double* const* sourceValues,
+			double* out) const override;
+
 		int GetSourceModuleCount() const override
 		{
 			return 2;
@@ -59,6 +62,18 @@ namespace noise::module
 
 		double GetValue(double x, double y, double z) const override;
 
+		double GetLipschitzBound() const override;
+
+		Interval GetValueRange(const Box& box) const override;
+
+		void GetValues(int count, const double* x, const double* y,
+			const double* z, double* out) const override;
+
+		bool IsPointwise() const override
+		{
+			return true;
+		}
+
     };
 
     /// @}
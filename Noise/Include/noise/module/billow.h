@@ -161,11 +161,16 @@ namespace noise::module
 
 		double GetValue(double x, double y, double z) const override;
 
+		double GetLipschitzBound() const override;
+
+		Interval GetValueRange(const Box& box) const override;
+
         /// Sets the frequency of the first octave.
         ///
         /// @param frequency The frequency of the first octave.
         void SetFrequency (double frequency)
         {
+          IncrementVersion ();
           m_frequency = frequency;
         }
 
@@ -180,6 +185,7 @@ namespace noise::module
         /// 3.5.
         void SetLacunarity (double lacunarity)
         {
+          IncrementVersion ();
           m_lacunarity = lacunarity;
         }
 
@@ -191,6 +197,7 @@ namespace noise::module
         /// coherent-Noise qualities.
         void SetNoiseQuality (noise::NoiseQuality noiseQuality)
         {
+          IncrementVersion ();
           m_noiseQuality = noiseQuality;
         }
 
@@ -212,6 +219,7 @@ namespace noise::module
         /// calculate the billowy-Noise value.
         void SetOctaveCount (int octaveCount)
         {
+          IncrementVersion ();
           if (octaveCount < 1 || octaveCount > BILLOW_MAX_OCTAVE) {
             throw noise::ExceptionInvalidParam ();
           }
@@ -228,6 +236,7 @@ namespace noise::module
         /// 0.0 and 1.0.
         void SetPersistence (double persistence)
         {
+          IncrementVersion ();
           m_persistence = persistence;
         }
 
@@ -236,6 +245,7 @@ namespace noise::module
         /// @param seed The seed value.
         void SetSeed (int seed)
         {
+          IncrementVersion ();
           m_seed = seed;
         }
 
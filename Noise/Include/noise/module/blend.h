@@ -63,6 +63,11 @@ namespace noise::module
     /// This Noise module uses linear interpolation to perform the blending
     /// operation.
     ///
+    /// When generating a batch of output values, this Noise module evaluates
+    /// the control module first.  Where the output value from the control
+    /// module is exactly -1.0 or +1.0, only one of the source modules is
+    /// evaluated.
+    ///
     /// This Noise module requires three source modules.
     class Blend: public Module
     {
@@ -96,6 +101,9 @@ namespace noise::module
           return *(m_pSourceModule[2]);
         }
 
+		void CombineValues(int count, const double* const* sourceValues,
+			double* out) const override;
+
 		int GetSourceModuleCount() const override
 		{
 			return 3;
@@ -103,6 +111,18 @@ namespace noise::module
 
 		double GetValue(double x, double y, double z) const override;
 
+		double GetLipschitzBound() const override;
+
+		Interval GetValueRange(const Box& box) const override;
+
+		void GetValues(int count, const double* x, const double* y,
+			const double* z, double* out) const override;
+
+		bool IsPointwise() const override
+		{
+			return true;
+		}
+
         /// Sets the control module.
         ///
         /// @param controlModule The control module.
@@ -123,6 +143,7 @@ namespace noise::module
         /// module.
         void SetControlModule (const Module& controlModule)
 		{
+			IncrementVersion ();
 			assert (m_pSourceModule != nullptr);
 			m_pSourceModule[2] = &controlModule;
 		}
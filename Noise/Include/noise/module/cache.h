@@ -23,6 +23,8 @@
 #ifndef NOISE_MODULE_CACHE_H
 #define NOISE_MODULE_CACHE_H
 
+#include <vector>
+#include "../threadstate.h"
 #include "modulebase.h"
 
 namespace noise::module
@@ -52,9 +54,16 @@ namespace noise::module
     /// module returns the cached output value without having the source
     /// module recalculate the output value.
     ///
+    /// The GetValues() method caches the last batch of output values in the
+    /// same way: if a batch of input values is equal to the previous batch,
+    /// the cached batch of output values is copied to the output array.
+    ///
     /// If an application passes a new source module to the SetSourceModule()
     /// method, the cache is invalidated.
     ///
+    /// Each thread that evaluates this Noise module has its own cache, so
+    /// several threads may evaluate it at once.
+    ///
     /// Caching a Noise module is useful if it is used as a source module for
     /// multiple Noise modules.  If a source module is not cached, the source
     /// module will redundantly calculate the same output value once for each
@@ -69,6 +78,9 @@ namespace noise::module
         /// Constructor.
         Cache ();
 
+		void CombineValues(int count, const double* const* sourceValues,
+			double* out) const override;
+
 		int GetSourceModuleCount() const override
 		{
 			return 1;
@@ -76,29 +88,77 @@ namespace noise::module
 
 		double GetValue(double x, double y, double z) const override;
 
-		void SetSourceModule(int index, const Module& sourceModule) override
+		double GetLipschitzBound() const override;
+
+		Interval GetValueRange(const Box& box) const override;
+
+		void GetValues(int count, const double* x, const double* y,
+			const double* z, double* out) const override;
+
+		bool IsPointwise() const override
 		{
-			Module::SetSourceModule(index, sourceModule);
-			m_isCached = false;
+			return true;
 		}
 
       protected:
 
-        /// The cached output value at the cached input value.
-        mutable double m_cachedValue;
+        /// The contents of the cache of one thread.
+        struct State
+        {
+
+          /// The version of this Noise module when the contents were
+          /// stored.
+          std::uint64_t version = 0;
+
+          /// The cached output value at the cached input value.
+          double cachedValue = 0.0;
+
+          /// Determines if a cached output value is stored.
+          bool isCached = false;
+
+          /// @a x coordinate of the cached input value.
+          double xCache = 0.0;
+
+          /// @a y coordinate of the cached input value.
+          double yCache = 0.0;
+
+          /// @a z coordinate of the cached input value.
+          double zCache = 0.0;
+
+          /// Determines if a cached batch of output values is stored.
+          bool isBatchCached = false;
+
+          /// The cached batch of output values.
+          std::vector<double> batchValues;
+
+          /// @a x coordinates of the cached batch of input values.
+          std::vector<double> xBatchCache;
+
+          /// @a y coordinates of the cached batch of input values.
+          std::vector<double> yBatchCache;
+
+          /// @a z coordinates of the cached batch of input values.
+          std::vector<double> zBatchCache;
+
+          /// Determines if a cached output range is stored.
+          bool isRangeCached = false;
+
+          /// The cached output range within the cached box of input values.
+          Interval rangeCache;
 
-        /// Determines if a cached output value is stored in this Noise
-        /// module.
-        mutable double m_isCached;
+          /// The cached box of input values.
+          Box boxCache;
 
-        /// @a x coordinate of the cached input value.
-        mutable double m_xCache;
+        };
 
-        /// @a y coordinate of the cached input value.
-        mutable double m_yCache;
+        /// Returns the cache of the calling thread.
+        ///
+        /// @returns The cache, which is emptied if it was filled before the
+        /// source module or a parameter of this Noise module changed.
+        State& GetState () const;
 
-        /// @a z coordinate of the cached input value.
-        mutable double m_zCache;
+        /// The cache of each thread.
+        ThreadState<State> m_states;
 
     };
 
@@ -63,6 +63,10 @@ namespace noise::module
 
 		double GetValue(double x, double y, double z) const override;
 
+		double GetLipschitzBound() const override;
+
+		Interval GetValueRange(const Box& box) const override;
+
     };
 
     /// @}
@@ -89,6 +89,9 @@ namespace noise::module
           return m_lowerBound;
         }
 
+		void CombineValues(int count, const double* const* sourceValues,
+			double* out) const override;
+
 		int GetSourceModuleCount() const override
 		{
 			return 1;
@@ -108,6 +111,18 @@ namespace noise::module
 
 		double GetValue(double x, double y, double z) const override;
 
+		double GetLipschitzBound() const override;
+
+		Interval GetValueRange(const Box& box) const override;
+
+		void GetValues(int count, const double* x, const double* y,
+			const double* z, double* out) const override;
+
+		bool IsPointwise() const override
+		{
+			return true;
+		}
+
         /// Sets the lower and upper bounds of the clamping range.
         ///
         /// @param lowerBound The lower bound.
@@ -80,11 +80,16 @@ namespace noise::module
 			return m_constValue;
 		}
 
+		double GetLipschitzBound() const override;
+
+		Interval GetValueRange(const Box& box) const override;
+
         /// Sets the constant output value for this Noise module.
         ///
         /// @param constValue The constant output value for this Noise module.
         void SetConstValue (double constValue)
         {
+          IncrementVersion ();
           m_constValue = constValue;
         }
 
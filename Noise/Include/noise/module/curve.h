@@ -23,7 +23,9 @@
 #ifndef NOISE_MODULE_CURVE_H
 #define NOISE_MODULE_CURVE_H
 
+#include <vector>
 #include "modulebase.h"
+#include "../segmentindex.h"
 
 namespace noise::module
 {
@@ -127,6 +129,9 @@ namespace noise::module
           return m_controlPointCount;
         }
 
+		void CombineValues(int count, const double* const* sourceValues,
+			double* out) const override;
+
 		int GetSourceModuleCount() const override
 		{
 			return 1;
@@ -134,8 +139,46 @@ namespace noise::module
 
 		double GetValue(double x, double y, double z) const override;
 
+		double GetLipschitzBound() const override;
+
+		Interval GetValueRange(const Box& box) const override;
+
+		void GetValues(int count, const double* x, const double* y,
+			const double* z, double* out) const override;
+
+		bool IsPointwise() const override
+		{
+			return true;
+		}
+
       protected:
 
+        /// The coefficients of the cubic polynomial that maps the output
+        /// values from the source module between two control points.
+        struct Segment
+        {
+
+          /// The input value of the control point at the start of the
+          /// segment.
+          double input0;
+
+          /// The input value of the control point at the end of the segment.
+          double input1;
+
+          /// The coefficient of the cubed alpha value.
+          double p;
+
+          /// The coefficient of the squared alpha value.
+          double q;
+
+          /// The coefficient of the alpha value.
+          double r;
+
+          /// The constant term.
+          double s;
+
+        };
+
         /// Determines the array index in which to insert the control point
         /// into the internal control point array.
         ///
@@ -173,12 +216,36 @@ namespace noise::module
         void InsertAtPos (int insertionPos, double inputValue,
           double outputValue);
 
+        /// Maps an output value from the source module onto the curve.
+        ///
+        /// @param sourceModuleValue The output value from the source module.
+        ///
+        /// @returns The mapped value.
+        double MapValue (double sourceModuleValue) const;
+
+        /// Rebuilds the segment table and the segment index from the
+        /// control points.
+        ///
+        /// Every method that modifies the control points calls this method.
+        void UpdateSegments ();
+
         /// Number of control points on the curve.
         int m_controlPointCount;
 
         /// Array that stores the control points.
         ControlPoint* m_pControlPoints;
 
+        /// Locates the segment of the curve that contains an output value
+        /// from the source module.
+        SegmentIndex m_segmentIndex;
+
+        /// The coefficients of each segment of the curve, indexed by the
+        /// number of control points with input values less than or equal to
+        /// the mapped value.  The first and last segments lie outside of the
+        /// control points; their constant terms hold the output values of the
+        /// nearest control points.
+        std::vector<Segment> m_segments;
+
     };
 
     /// @}
@@ -95,6 +95,10 @@ namespace noise::module
 
 		double GetValue(double x, double y, double z) const override;
 
+		double GetLipschitzBound() const override;
+
+		Interval GetValueRange(const Box& box) const override;
+
         /// Sets the frequenct of the concentric cylinders.
         ///
         /// @param frequency The frequency of the concentric cylinders.
@@ -103,6 +107,7 @@ namespace noise::module
         /// cylinders, reducing the distances between them.
         void SetFrequency (double frequency)
         {
+          IncrementVersion ();
           m_frequency = frequency;
         }
 
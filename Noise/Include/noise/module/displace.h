@@ -78,6 +78,13 @@ namespace noise::module
 
 		double GetValue(double x, double y, double z) const override;
 
+		double GetLipschitzBound() const override;
+
+		Interval GetValueRange(const Box& box) const override;
+
+		void GetValues(int count, const double* x, const double* y,
+			const double* z, double* out) const override;
+
       /// Returns the @a x displacement module.
       ///
       /// @returns A reference to the @a x displacement module.
@@ -167,6 +174,7 @@ namespace noise::module
       void SetDisplaceModules (const Module& xDisplaceModule,
         const Module& yDisplaceModule, const Module& zDisplaceModule)
       {
+        IncrementVersion ();
         SetXDisplaceModule (xDisplaceModule);
         SetYDisplaceModule (yDisplaceModule);
         SetZDisplaceModule (zDisplaceModule);
@@ -191,6 +199,7 @@ namespace noise::module
       /// Noise module unless another displacement module replaces it.
       void SetXDisplaceModule (const Module& xDisplaceModule)
       {
+        IncrementVersion ();
         assert (m_pSourceModule != NULL);
         m_pSourceModule[1] = &xDisplaceModule;
       }
@@ -214,6 +223,7 @@ namespace noise::module
       /// Noise module unless another displacement module replaces it.
       void SetYDisplaceModule (const Module& yDisplaceModule)
       {
+        IncrementVersion ();
         assert (m_pSourceModule != NULL);
         m_pSourceModule[2] = &yDisplaceModule;
       }
@@ -237,6 +247,7 @@ namespace noise::module
       /// Noise module unless another displacement module replaces it.
       void SetZDisplaceModule (const Module& zDisplaceModule)
       {
+        IncrementVersion ();
         assert (m_pSourceModule != NULL);
         m_pSourceModule[3] = &zDisplaceModule;
       }
@@ -75,6 +75,9 @@ namespace noise::module
           return m_exponent;
         }
 
+		void CombineValues(int count, const double* const* sourceValues,
+			double* out) const override;
+
 		int GetSourceModuleCount() const override
 		{
 			return 1;
@@ -82,6 +85,18 @@ namespace noise::module
 
 		double GetValue(double x, double y, double z) const override;
 
+		double GetLipschitzBound() const override;
+
+		Interval GetValueRange(const Box& box) const override;
+
+		void GetValues(int count, const double* x, const double* y,
+			const double* z, double* out) const override;
+
+		bool IsPointwise() const override
+		{
+			return true;
+		}
+
         /// Sets the exponent value to apply to the output value from the
         /// source module.
         ///
@@ -93,6 +108,7 @@ namespace noise::module
         /// curve, then rescales that value back to the original range.
         void SetExponent (double exponent)
         {
+          IncrementVersion ();
           m_exponent = exponent;
         }
 
@@ -0,0 +1,282 @@
+// hashcache.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#ifndef NOISE_MODULE_HASHCACHE_H
+#define NOISE_MODULE_HASHCACHE_H
+
+#include <cstdint>
+#include <vector>
+#include "../threadstate.h"
+#include "modulebase.h"
+
+namespace noise::module
+{
+
+	/// @addtogroup libnoise
+	/// @{
+
+	/// @addtogroup modules
+	/// @{
+
+	/// @addtogroup miscmodules
+	/// @{
+
+	/// Default number of entries stored by the Noise::module::HashCache
+	/// Noise module.
+	const int DEFAULT_HASH_CACHE_CAPACITY = 256;
+
+	/// Maximum number of entries stored by the Noise::module::HashCache
+	/// Noise module.
+	const int MAX_HASH_CACHE_CAPACITY = 1 << 30;
+
+	/// Default quantization step for the Noise::module::HashCache Noise
+	/// module.
+	const double DEFAULT_HASH_CACHE_QUANTUM = 0.0;
+
+	/// Number of entries in each set of the Noise::module::HashCache Noise
+	/// module.
+	const int HASH_CACHE_WAYS = 4;
+
+	/// Noise module that caches several recent output values generated by a
+	/// source module.
+	///
+	/// Unlike Noise::module::Cache, which only remembers the last input
+	/// value, this Noise module stores its output values in a small
+	/// set-associative table.  The ( @a x, @a y, @a z ) coordinates of an
+	/// input value are hashed to select a set of Noise::module::HASH_CACHE_WAYS
+	/// entries; if one of those entries holds the same coordinates, the
+	/// cached output value is returned without having the source module
+	/// recalculate it.  Otherwise the oldest entry in the set is replaced.
+	///
+	/// This makes caching effective when the source module is shared by
+	/// several Noise modules that do not request the same input value
+	/// back-to-back, such as a Noise::module::Displace module whose
+	/// displacement modules share a subgraph, or a seamless planar Noise map
+	/// that samples four positions for each point.
+	///
+	/// To change the number of entries stored by this Noise module, call the
+	/// SetCapacity() method.
+	///
+	/// By default, coordinates must match exactly for a cached value to be
+	/// returned.  Passing a positive value to the SetQuantum() method snaps
+	/// the coordinates onto a grid with that spacing before they are
+	/// compared, so that all input values within the same grid cell share a
+	/// cached output value.  This trades accuracy for a higher hit rate.
+	///
+	/// Call the GetHitCount() and GetMissCount() methods to determine how
+	/// effective the cache is.
+	///
+	/// If an application passes a new source module to the SetSourceModule()
+	/// method, the cache is invalidated.
+	///
+	/// Each thread that evaluates this Noise module has its own table, so
+	/// several threads may evaluate it at once.  The capacity applies to the
+	/// table of each thread, and the hit and miss counters add up the
+	/// lookups of every thread.  With a positive quantization step, the
+	/// output value shared by a grid cell is the one generated for the
+	/// first input value that the calling thread looked up in that cell.
+	///
+	/// This Noise module requires one source module.
+	class HashCache: public Module
+	{
+
+	public:
+
+		/// Constructor.
+		///
+		/// The default capacity is set to
+		/// Noise::module::DEFAULT_HASH_CACHE_CAPACITY.
+		///
+		/// The default quantization step is set to
+		/// Noise::module::DEFAULT_HASH_CACHE_QUANTUM.
+		HashCache();
+
+		/// Invalidates every entry in the cache.
+		///
+		/// The hit and miss counters are not reset.  This method must not be
+		/// called while other threads evaluate this Noise module.
+		void Clear();
+
+		/// Returns the number of entries stored by this Noise module.
+		///
+		/// @returns The number of entries.
+		int GetCapacity() const
+		{
+			return m_capacity;
+		}
+
+		/// Returns the number of output values returned from the cache.
+		///
+		/// @returns The number of cache hits.
+		std::uint64_t GetHitCount() const;
+
+		/// Returns the number of output values that were calculated by the
+		/// source module.
+		///
+		/// @returns The number of cache misses.
+		std::uint64_t GetMissCount() const;
+
+		/// Returns the quantization step applied to the input coordinates.
+		///
+		/// @returns The quantization step, or zero if the coordinates must
+		/// match exactly.
+		double GetQuantum() const
+		{
+			return m_quantum;
+		}
+
+		int GetSourceModuleCount() const override
+		{
+			return 1;
+		}
+
+		double GetValue(double x, double y, double z) const override;
+
+		double GetLipschitzBound() const override;
+
+		Interval GetValueRange(const Box& box) const override;
+
+		/// Resets the hit and miss counters to zero.
+		///
+		/// This method must not be called while other threads evaluate this
+		/// Noise module.
+		void ResetStats();
+
+		/// Sets the number of entries stored by this Noise module.
+		///
+		/// @param capacity The number of entries.
+		///
+		/// @pre The capacity is positive.
+		/// @pre The capacity does not exceed
+		/// Noise::module::MAX_HASH_CACHE_CAPACITY.
+		///
+		/// @throw Noise::ExceptionInvalidParam An invalid parameter was
+		/// specified; see the preconditions for more information.
+		///
+		/// The capacity is rounded up to a power-of-two multiple of
+		/// Noise::module::HASH_CACHE_WAYS.  Changing the capacity invalidates
+		/// the cache.
+		void SetCapacity(int capacity);
+
+		/// Sets the quantization step applied to the input coordinates.
+		///
+		/// @param quantum The quantization step.
+		///
+		/// @pre The quantization step is not negative.
+		///
+		/// @throw Noise::ExceptionInvalidParam An invalid parameter was
+		/// specified; see the preconditions for more information.
+		///
+		/// A quantization step of zero requires the coordinates to match
+		/// exactly.  A positive quantization step causes all input values
+		/// that lie in the same grid cell of that size to share a cached
+		/// output value.  Changing the quantization step invalidates the
+		/// cache.
+		void SetQuantum(double quantum);
+
+	protected:
+
+		/// An entry in the cache.
+		struct Entry
+		{
+
+			/// The key generated from the @a x coordinate of the input value.
+			std::uint64_t xKey;
+
+			/// The key generated from the @a y coordinate of the input value.
+			std::uint64_t yKey;
+
+			/// The key generated from the @a z coordinate of the input value.
+			std::uint64_t zKey;
+
+			/// The output value from the source module.
+			double value;
+
+			/// Determines if this entry holds an output value.
+			bool isValid;
+
+		};
+
+		/// The cache table of one thread.
+		struct State
+		{
+
+			/// The version of this Noise module when the table was
+			/// allocated.
+			std::uint64_t version = 0;
+
+			/// The cache entries, stored as consecutive sets of
+			/// Noise::module::HASH_CACHE_WAYS entries.
+			std::vector<Entry> entries;
+
+			/// Index of the entry to replace next within each set.
+			std::vector<std::uint8_t> nextVictim;
+
+			/// Number of cache hits.
+			std::uint64_t hitCount = 0;
+
+			/// Number of cache misses.
+			std::uint64_t missCount = 0;
+
+		};
+
+		/// Invalidates every entry in a table.
+		///
+		/// @param state The table.
+		static void ClearState(State& state);
+
+		/// Returns the table of the calling thread.
+		///
+		/// @returns The table, which is emptied if it was filled before the
+		/// source module or a parameter of this Noise module changed.
+		State& GetState() const;
+
+		/// Generates the key for one coordinate of an input value.
+		///
+		/// @param n The coordinate.
+		///
+		/// @returns The key.
+		std::uint64_t MakeKey(double n) const;
+
+		/// Number of entries in the table of each thread.
+		int m_capacity;
+
+		/// Quantization step applied to the input coordinates.
+		double m_quantum;
+
+		/// One less than the number of sets; used to mask the hash value.
+		std::uint64_t m_setMask;
+
+		/// The table of each thread.
+		ThreadState<State> m_states;
+
+	};
+
+	/// @}
+
+	/// @}
+
+	/// @}
+
+}
+
+#endif
@@ -35,6 +35,7 @@
 #include "cylinders.h"
 #include "displace.h"
 #include "exponent.h"
+#include "hashcache.h"
 #include "invert.h"
 #include "max.h"
 #include "min.h"
@@ -48,6 +49,7 @@
 #include "select.h"
 #include "spheres.h"
 #include "terrace.h"
+#include "transformpoint.h"
 #include "translatepoint.h"
 #include "turbulence.h"
 #include "voronoi.h"
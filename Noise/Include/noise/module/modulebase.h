@@ -25,9 +25,11 @@
 
 #include <cstdlib>
 #include <cassert>
+#include <cstdint>
 #include <cmath>
 #include "../basictypes.h"
 #include "../exception.h"
+#include "../interval.h"
 #include "../noisegen.h"
 
 namespace noise::module
@@ -214,6 +216,12 @@ namespace noise::module
     /// attempts to call the GetValue() method, your module will raise an
     /// assertion.
     ///
+    /// If the output value of your Noise module only depends on the output
+    /// values of its source modules at the same input value, also override
+    /// the IsPointwise() and CombineValues() methods.  This allows
+    /// Noise::RasterExecutor to evaluate your Noise module over a whole tile
+    /// of input values at once.
+    ///
     /// It shouldn't be too difficult to create your own Noise module.  If you
     /// still have some problems, take a look at the source code for
     /// Noise::module::Add, which is a very simple Noise module.
@@ -228,6 +236,62 @@ namespace noise::module
         /// Destructor.
         virtual ~Module ();
 
+        /// Combines the output values of the source modules into the output
+        /// values of this Noise module.
+        ///
+        /// @param count The number of input values.
+        /// @param sourceValues For each source module, the output values
+        /// generated by that source module from the input values, or a null
+        /// pointer if GetNeededSources() reported the source module as not
+        /// needed.
+        /// @param out On exit, the output values.
+        ///
+        /// @pre IsPointwise() returns @a true.
+        ///
+        /// Each output value is equal to the value returned by GetValue()
+        /// for the corresponding input value.  The @a out array may be one
+        /// of the arrays in @a sourceValues.
+        ///
+        /// The default implementation raises a debug assertion.
+        virtual void CombineValues (int count, const double* const* sourceValues,
+          double* out) const;
+
+        /// Returns a conservative bound on the rate of change of the output
+        /// value of this Noise module.
+        ///
+        /// @returns A bound on the magnitude of the gradient of the output
+        /// value, or +infinity if the output value may change abruptly.
+        ///
+        /// @pre All source modules required by this Noise module have been
+        /// passed to the SetSourceModule() method.
+        ///
+        /// Two input values a distance @a d apart generate output values
+        /// that differ by at most @a d times this bound; the bound is a
+        /// Lipschitz constant of the Noise module.  Noise modules compose the
+        /// bounds of their source modules, so the bound may be larger than
+        /// the actual rate of change, but it is never smaller.
+        /// Noise::model::Line uses it to step along a ray without stepping
+        /// over a surface.
+        ///
+        /// The bound does not account for the wrapping of very large
+        /// coordinates by the MakeInt32Range() function.
+        ///
+        /// The default implementation returns +infinity.
+        virtual double GetLipschitzBound () const;
+
+        /// Determines which source modules are needed to generate the output
+        /// values within a box of input values.
+        ///
+        /// @param box The box of input values.
+        /// @param isNeeded On exit, for each source module, @a true if the
+        /// output values of that source module must be passed to
+        /// CombineValues().
+        ///
+        /// @pre IsPointwise() returns @a true.
+        ///
+        /// The default implementation reports every source module as needed.
+        virtual void GetNeededSources (const Box& box, bool* isNeeded) const;
+
         /// Returns a reference to a source module connected to this Noise
         /// module.
         ///
@@ -292,6 +356,88 @@ namespace noise::module
         /// module, call the GetSourceModuleCount() method.
         virtual double GetValue (double x, double y, double z) const = 0;
 
+        /// Returns a conservative range of the output values that this Noise
+        /// module can generate within a box of input values.
+        ///
+        /// @param box The box of input values.
+        ///
+        /// @returns An interval that contains every output value generated
+        /// from an input value within the box.
+        ///
+        /// @pre All source modules required by this Noise module have been
+        /// passed to the SetSourceModule() method.
+        ///
+        /// The range is computed with interval arithmetic from the ranges of
+        /// the source modules, so it may be wider than the actual range of
+        /// output values, but it is never narrower.  The batch evaluators use
+        /// it to skip source modules whose output value cannot affect the
+        /// result within a batch of input values.
+        ///
+        /// Noise::module::Spheres, Noise::module::Cylinders and
+        /// Noise::module::Checkerboard calculate their range from the
+        /// geometry of the box.  The coherent-Noise generators, such as
+        /// Noise::module::Perlin, bound the output value at the center of
+        /// the box by their Lipschitz bound, so their range narrows as the
+        /// box shrinks; see GetLocalValueRange().
+        ///
+        /// The default implementation returns an unbounded interval.
+        virtual Interval GetValueRange (const Box& box) const;
+
+        /// Generates the output values for a batch of input values.
+        ///
+        /// @param count The number of input values.
+        /// @param x The @a x coordinates of the input values.
+        /// @param y The @a y coordinates of the input values.
+        /// @param z The @a z coordinates of the input values.
+        /// @param out On exit, the output values.
+        ///
+        /// @pre All source modules required by this Noise module have been
+        /// passed to the SetSourceModule() method.
+        ///
+        /// Each output value is equal to the value returned by GetValue()
+        /// for the corresponding input value.  Noise modules override this
+        /// method to process the batch one source module at a time over
+        /// contiguous arrays, and to skip source modules that cannot affect
+        /// the output values within the batch.
+        ///
+        /// The default implementation calls GetValue() for each input value.
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* out) const;
+
+        /// Returns the version of this Noise module.
+        ///
+        /// @returns The version of this Noise module.
+        ///
+        /// The version changes whenever a parameter of this Noise module is
+        /// modified or a source module is connected to it.  Versions are
+        /// drawn from a counter shared by all Noise modules, so a new
+        /// version is always greater than any version handed out before it.
+        /// To determine whether the output values of a Noise module or any
+        /// Noise module it depends on may have changed, compare the value
+        /// returned by the Noise::GetGraphVersion() function instead.
+        ///
+        /// The contents of caching Noise modules do not affect the version.
+        std::uint64_t GetVersion () const
+        {
+          return m_version;
+        }
+
+        /// Determines if the output value of this Noise module only depends
+        /// on the output values of its source modules at the same input
+        /// value.
+        ///
+        /// @returns
+        /// - @a true if the output values can be generated by the
+        ///   CombineValues() method.
+        /// - @a false if this Noise module is a generator module, or if it
+        ///   evaluates its source modules at other input values.
+        ///
+        /// The default implementation returns @a false.
+        virtual bool IsPointwise () const
+        {
+          return false;
+        }
+
         /// Connects a source module to this Noise module.
         ///
         /// @param index An index value to assign to this source module.
@@ -329,14 +475,89 @@ namespace noise::module
             throw noise::ExceptionInvalidParam ();
           }
           m_pSourceModule[index] = &sourceModule;
+          IncrementVersion ();
         }
 
       protected:
 
+        /// Narrows the range of output values of a generator module to the
+        /// values it can generate within a box.
+        ///
+        /// @param box The range of input values.
+        /// @param range The range of every value the Noise module can
+        /// generate.
+        /// @param scale The largest factor applied to the coordinates of the
+        /// input value before they are passed to the MakeInt32Range()
+        /// function.
+        ///
+        /// @returns The range of output values within the box.
+        ///
+        /// The output value at the center of the box differs from any other
+        /// output value within the box by at most the Lipschitz bound times
+        /// half the diagonal of the box.  The returned range is the
+        /// intersection of the resulting interval with @a range.  If the
+        /// Lipschitz bound is infinite, or if MakeInt32Range() may wrap the
+        /// coordinates within the box, @a range is returned unchanged.
+        ///
+        /// Coherent-Noise generators call this method from their
+        /// GetValueRange() method.  It calls GetValue() once.
+        Interval GetLocalValueRange (const Box& box, const Interval& range,
+          double scale) const;
+
+        /// Returns the product of a factor and a Lipschitz bound.
+        ///
+        /// @param factor A factor that is not negative.
+        /// @param bound A Lipschitz bound.
+        ///
+        /// @returns The product, which is zero if either operand is zero,
+        /// even if the other one is infinite.
+        static double ScaleLipschitzBound (double factor, double bound)
+        {
+          if (factor == 0.0 || bound == 0.0) {
+            return 0.0;
+          }
+          return factor * bound;
+        }
+
+        /// Generates the output values of a source module for a subset of a
+        /// batch of input values.
+        ///
+        /// @param index The index value assigned to the source module.
+        /// @param laneCount The number of input values in the subset.
+        /// @param lanes The indices of the input values in the subset, in
+        /// increasing order.
+        /// @param count The number of input values in the batch.
+        /// @param x The @a x coordinates of the input values in the batch.
+        /// @param y The @a y coordinates of the input values in the batch.
+        /// @param z The @a z coordinates of the input values in the batch.
+        /// @param out On exit, the output values at the indices in @a lanes;
+        /// the other output values are not modified.
+        ///
+        /// @pre The source module has been passed to the SetSourceModule()
+        /// method.
+        ///
+        /// Selector modules call this method so that each source module is
+        /// only evaluated for the input values whose output value depends on
+        /// it.  The input values in the subset are packed into contiguous
+        /// arrays before they are passed to the GetValues() method of the
+        /// source module, and the output values are scattered back.
+        void GetSourceValues (int index, int laneCount, const int* lanes,
+          int count, const double* x, const double* y, const double* z,
+          double* out) const;
+
+        /// Assigns a new version to this Noise module.
+        ///
+        /// Every method that modifies a parameter of a Noise module calls
+        /// this method.
+        void IncrementVersion ();
+
         /// An array containing the pointers to each source module required by
         /// this Noise module.
         const Module** m_pSourceModule;
 
+        /// The version of this Noise module.
+        std::uint64_t m_version;
+
       private:
 
         /// Assignment operator.
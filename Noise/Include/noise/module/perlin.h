@@ -246,11 +246,16 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual double GetLipschitzBound () const;
+
+        virtual Interval GetValueRange (const Box& box) const;
+
         /// Sets the frequency of the first octave.
         ///
         /// @param frequency The frequency of the first octave.
         void SetFrequency (double frequency)
         {
+          IncrementVersion ();
           m_frequency = frequency;
         }
 
@@ -265,6 +270,7 @@ namespace noise
         /// 3.5.
         void SetLacunarity (double lacunarity)
         {
+          IncrementVersion ();
           m_lacunarity = lacunarity;
         }
 
@@ -276,6 +282,7 @@ namespace noise
         /// coherent-Noise qualities.
         void SetNoiseQuality (noise::NoiseQuality noiseQuality)
         {
+          IncrementVersion ();
           m_noiseQuality = noiseQuality;
         }
 
@@ -297,6 +304,7 @@ namespace noise
         /// calculate the Perlin-Noise value.
         void SetOctaveCount (int octaveCount)
         {
+          IncrementVersion ();
           if (octaveCount < 1 || octaveCount > PERLIN_MAX_OCTAVE) {
             throw noise::ExceptionInvalidParam ();
           }
@@ -313,6 +321,7 @@ namespace noise
         /// 1.0.
         void SetPersistence (double persistence)
         {
+          IncrementVersion ();
           m_persistence = persistence;
         }
 
@@ -321,6 +330,7 @@ namespace noise
         /// @param seed The seed value.
         void SetSeed (int seed)
         {
+          IncrementVersion ();
           m_seed = seed;
         }
 
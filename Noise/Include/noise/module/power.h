@@ -58,6 +58,9 @@ namespace noise
         /// Constructor.
         Power ();
 
+        virtual void CombineValues (int count,
+          const double* const* sourceValues, double* out) const;
+
         virtual int GetSourceModuleCount () const
         {
           return 2;
@@ -65,6 +68,18 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual double GetLipschitzBound () const;
+
+        virtual Interval GetValueRange (const Box& box) const;
+
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* out) const;
+
+        virtual bool IsPointwise () const
+        {
+          return true;
+        }
+
     };
 
     /// @}
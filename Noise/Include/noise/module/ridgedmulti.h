@@ -204,11 +204,16 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual double GetLipschitzBound () const;
+
+        virtual Interval GetValueRange (const Box& box) const;
+
         /// Sets the frequency of the first octave.
         ///
         /// @param frequency The frequency of the first octave.
         void SetFrequency (double frequency)
         {
+          IncrementVersion ();
           m_frequency = frequency;
         }
 
@@ -223,6 +228,7 @@ namespace noise
         /// 3.5.
         void SetLacunarity (double lacunarity)
         {
+          IncrementVersion ();
           m_lacunarity = lacunarity;
           CalcSpectralWeights ();
         }
@@ -235,6 +241,7 @@ namespace noise
         /// coherent-Noise qualities.
         void SetNoiseQuality (noise::NoiseQuality noiseQuality)
         {
+          IncrementVersion ();
           m_noiseQuality = noiseQuality;
         }
 
@@ -257,6 +264,7 @@ namespace noise
         /// calculate the ridged-multifractal-Noise value.
         void SetOctaveCount (int octaveCount)
         {
+          IncrementVersion ();
           if (octaveCount > RIDGED_MAX_OCTAVE) {
             throw noise::ExceptionInvalidParam ();
           }
@@ -269,6 +277,7 @@ namespace noise
         /// @param seed The seed value.
         void SetSeed (int seed)
         {
+          IncrementVersion ();
           m_seed = seed;
         }
 
@@ -93,6 +93,34 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual double GetLipschitzBound () const;
+
+        virtual Interval GetValueRange (const Box& box) const;
+
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* out) const;
+
+        /// Returns the rotation matrix applied to the input value.
+        ///
+        /// @param matrix The array that receives the nine elements of the
+        /// rotation matrix, in row-major order.
+        ///
+        /// The rotated @a x coordinate is the dot product of the first row
+        /// and the ( @a x, @a y, @a z ) coordinates of the input value, and
+        /// so on for the @a y and @a z coordinates.
+        void GetMatrix (double matrix[9]) const
+        {
+          matrix[0] = m_x1Matrix;
+          matrix[1] = m_y1Matrix;
+          matrix[2] = m_z1Matrix;
+          matrix[3] = m_x2Matrix;
+          matrix[4] = m_y2Matrix;
+          matrix[5] = m_z2Matrix;
+          matrix[6] = m_x3Matrix;
+          matrix[7] = m_y3Matrix;
+          matrix[8] = m_z3Matrix;
+        }
+
         /// Returns the rotation angle around the @a x axis to apply to the
         /// input value.
         ///
@@ -142,6 +170,7 @@ namespace noise
         /// source module.
         void SetXAngle (double xAngle)
         {
+          IncrementVersion ();
           SetAngles (xAngle, m_yAngle, m_zAngle);
         }
 
@@ -155,6 +184,7 @@ namespace noise
         /// source module.
         void SetYAngle (double yAngle)
         {
+          IncrementVersion ();
           SetAngles (m_xAngle, yAngle, m_zAngle);
         }
 
@@ -168,6 +198,7 @@ namespace noise
         /// source module.
         void SetZAngle (double zAngle)
         {
+          IncrementVersion ();
           SetAngles (m_xAngle, m_yAngle, zAngle);
         }
 
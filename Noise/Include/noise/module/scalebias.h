@@ -94,6 +94,9 @@ namespace noise
           return m_scale;
         }
 
+        virtual void CombineValues (int count,
+          const double* const* sourceValues, double* out) const;
+
         virtual int GetSourceModuleCount () const
         {
           return 1;
@@ -101,6 +104,18 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual double GetLipschitzBound () const;
+
+        virtual Interval GetValueRange (const Box& box) const;
+
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* out) const;
+
+        virtual bool IsPointwise () const
+        {
+          return true;
+        }
+
         /// Sets the bias to apply to the scaled output value from the source
         /// module.
         ///
@@ -111,6 +126,7 @@ namespace noise
         /// it, then outputs the value.
         void SetBias (double bias)
         {
+          IncrementVersion ();
           m_bias = bias;
         }
 
@@ -124,6 +140,7 @@ namespace noise
         /// it, then outputs the value.
         void SetScale (double scale)
         {
+          IncrementVersion ();
           m_scale = scale;
         }
 
@@ -89,6 +89,13 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual double GetLipschitzBound () const;
+
+        virtual Interval GetValueRange (const Box& box) const;
+
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* out) const;
+
         /// Returns the scaling factor applied to the @a x coordinate of the
         /// input value.
         ///
@@ -125,6 +132,7 @@ namespace noise
         /// returning the output value from the source module.
         void SetScale (double scale)
         {
+          IncrementVersion ();
           m_xScale = scale;
           m_yScale = scale;
           m_zScale = scale;
@@ -142,6 +150,7 @@ namespace noise
         /// returning the output value from the source module.
         void SetScale (double xScale, double yScale, double zScale)
         {
+          IncrementVersion ();
           m_xScale = xScale;
           m_yScale = yScale;
           m_zScale = zScale;
@@ -157,6 +166,7 @@ namespace noise
         /// returning the output value from the source module.
         void SetXScale (double xScale)
         {
+          IncrementVersion ();
           m_xScale = xScale;
         }
 
@@ -170,6 +180,7 @@ namespace noise
         /// returning the output value from the source module.
         void SetYScale (double yScale)
         {
+          IncrementVersion ();
           m_yScale = yScale;
         }
 
@@ -183,6 +194,7 @@ namespace noise
         /// returning the output value from the source module.
         void SetZScale (double zScale)
         {
+          IncrementVersion ();
           m_zScale = zScale;
         }
 
@@ -80,6 +80,10 @@ namespace noise
     /// smooth the transition, pass a non-zero value to the SetEdgeFalloff()
     /// method.  Higher values result in a smoother transition.
     ///
+    /// When generating a batch of output values, this Noise module evaluates
+    /// the control module first, then evaluates each source module only for
+    /// the input values that select it.
+    ///
     /// This Noise module requires three source modules.
     class Select: public Module
     {
@@ -150,6 +154,11 @@ namespace noise
           return m_lowerBound;
         }
 
+        virtual void CombineValues (int count,
+          const double* const* sourceValues, double* out) const;
+
+        virtual void GetNeededSources (const Box& box, bool* isNeeded) const;
+
         virtual int GetSourceModuleCount () const
         {
           return 3;
@@ -170,6 +179,31 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual double GetLipschitzBound () const;
+
+        virtual Interval GetValueRange (const Box& box) const;
+
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* out) const;
+
+        virtual bool IsPointwise () const
+        {
+          return true;
+        }
+
+        /// Determines if a source module is the only one selected for every
+        /// control value within a range.
+        ///
+        /// @param index The index value of the source module (0 or 1).
+        /// @param controlRange The range of output values from the control
+        /// module.
+        ///
+        /// @returns
+        /// - @a true if every control value within the range selects the
+        ///   output value from that source module alone.
+        /// - @a false if another source module may contribute.
+        bool IsSourceSelected (int index, const Interval& controlRange) const;
+
         /// Sets the lower and upper bounds of the selection range.
         ///
         /// @param lowerBound The lower bound.
@@ -208,6 +242,7 @@ namespace noise
         /// module.
         void SetControlModule (const Module& controlModule)
         {
+          IncrementVersion ();
           assert (m_pSourceModule != NULL);
           m_pSourceModule[2] = &controlModule;
         }
@@ -243,6 +278,20 @@ namespace noise
 
       protected:
 
+        /// Returns the output value selected by a control value.
+        ///
+        /// @param controlValue The output value from the control module.
+        /// @param x The @a x coordinate of the input value.
+        /// @param y The @a y coordinate of the input value.
+        /// @param z The @a z coordinate of the input value.
+        ///
+        /// @returns The output value.
+        ///
+        /// Only the source modules that contribute to the output value are
+        /// evaluated.
+        double GetSelectedValue (double controlValue, double x, double y,
+          double z) const;
+
         /// Edge-falloff value.
         double m_edgeFalloff;
 
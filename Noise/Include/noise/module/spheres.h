@@ -96,6 +96,10 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual double GetLipschitzBound () const;
+
+        virtual Interval GetValueRange (const Box& box) const;
+
         /// Sets the frequenct of the concentric spheres.
         ///
         /// @param frequency The frequency of the concentric spheres.
@@ -104,6 +108,7 @@ namespace noise
         /// spheres, reducing the distances between them.
         void SetFrequency (double frequency)
         {
+          IncrementVersion ();
           m_frequency = frequency;
         }
 
@@ -24,6 +24,7 @@
 #define NOISE_MODULE_TERRACE_H
 
 #include "modulebase.h"
+#include "../segmentindex.h"
 
 namespace noise
 {
@@ -132,6 +133,9 @@ namespace noise
 	        return m_controlPointCount;
 	      }
 
+    	  virtual void CombineValues (int count,
+    	    const double* const* sourceValues, double* out) const;
+
     	  virtual int GetSourceModuleCount () const
 	      {
 	        return 1;
@@ -144,6 +148,7 @@ namespace noise
         /// control points.
 	      void InvertTerraces (bool invert = true)
 	      {
+	        IncrementVersion ();
 	        m_invertTerraces = invert;
 	      }
 
@@ -161,6 +166,18 @@ namespace noise
 
     	  virtual double GetValue (double x, double y, double z) const;
 
+    	  virtual double GetLipschitzBound () const;
+
+    	  virtual Interval GetValueRange (const Box& box) const;
+
+    	  virtual void GetValues (int count, const double* x, const double* y,
+    	    const double* z, double* out) const;
+
+    	  virtual bool IsPointwise () const
+    	  {
+    	    return true;
+    	  }
+
 	      /// Creates a number of equally-spaced control points that range from
         /// -1 to +1.
 	      ///
@@ -217,6 +234,14 @@ namespace noise
         /// order is still preserved.
 	      void InsertAtPos (int insertionPos, double value);
 
+	      /// Maps an output value from the source module onto the
+	      /// terrace-forming curve.
+	      ///
+	      /// @param sourceModuleValue The output value from the source module.
+	      ///
+	      /// @returns The mapped value.
+	      double MapValue (double sourceModuleValue) const;
+
 	      /// Number of control points stored in this Noise module.
 	      int m_controlPointCount;
 
@@ -227,6 +252,10 @@ namespace noise
 	      /// Array that stores the control points.
 	      double* m_pControlPoints;
 
+	      /// Locates the control points on either side of an output value from
+	      /// the source module.
+	      SegmentIndex m_segmentIndex;
+
     };
 
     /// @}
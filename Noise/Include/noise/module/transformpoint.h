@@ -0,0 +1,114 @@
+// transformpoint.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+#ifndef NOISE_MODULE_TRANSFORMPOINT_H
+#define NOISE_MODULE_TRANSFORMPOINT_H
+
+#include "modulebase.h"
+
+namespace noise::module
+{
+
+	/// @addtogroup libnoise
+	/// @{
+
+	/// @addtogroup modules
+	/// @{
+
+	/// @addtogroup transformermodules
+	/// @{
+
+	/// Noise module that applies an affine transformation to the coordinates
+	/// of the input value before returning the output value from a source
+	/// module.
+	///
+	/// The GetValue() method multiplies the ( @a x, @a y, @a z ) coordinates
+	/// of the input value with a 3x4 matrix before returning the output
+	/// value from the source module.  The first three columns of the matrix
+	/// hold the linear part of the transformation and the fourth column
+	/// holds the translation.  To set the matrix, call the SetMatrix()
+	/// method.
+	///
+	/// A single instance of this Noise module can replace any chain of
+	/// Noise::module::ScalePoint, Noise::module::TranslatePoint and
+	/// Noise::module::RotatePoint Noise modules.  The Noise::GraphOptimizer
+	/// class uses it for this purpose.
+	///
+	/// This Noise module requires one source module.
+	class TransformPoint: public Module
+	{
+
+	public:
+
+		/// Constructor.
+		///
+		/// The default matrix is the identity transformation.
+		TransformPoint();
+
+		/// Returns the matrix applied to the input value.
+		///
+		/// @param matrix The array that receives the twelve elements of the
+		/// matrix, in row-major order.
+		void GetMatrix(double matrix[12]) const;
+
+		int GetSourceModuleCount() const override
+		{
+			return 1;
+		}
+
+		double GetValue(double x, double y, double z) const override;
+
+		double GetLipschitzBound() const override;
+
+		Interval GetValueRange(const Box& box) const override;
+
+		void GetValues(int count, const double* x, const double* y,
+			const double* z, double* out) const override;
+
+		/// Sets the matrix to apply to the input value.
+		///
+		/// @param matrix The twelve elements of the matrix, in row-major
+		/// order.
+		///
+		/// The transformed @a x coordinate is calculated as
+		/// <i>m0 x + m1 y + m2 z + m3</i>, the transformed @a y coordinate
+		/// as <i>m4 x + m5 y + m6 z + m7</i>, and the transformed @a z
+		/// coordinate as <i>m8 x + m9 y + m10 z + m11</i>.
+		void SetMatrix(const double matrix[12]);
+
+	protected:
+
+		/// The matrix applied to the input value, in row-major order.
+		double m_matrix[12];
+
+	};
+
+	/// @}
+
+	/// @}
+
+	/// @}
+
+}
+
+#endif
@@ -90,6 +90,13 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual double GetLipschitzBound () const;
+
+        virtual Interval GetValueRange (const Box& box) const;
+
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* out) const;
+
         /// Returns the translation amount to apply to the @a x coordinate of
         /// the input value.
         ///
@@ -126,6 +133,7 @@ namespace noise
         /// output value from the source module
         void SetTranslation (double translation)
         {
+          IncrementVersion ();
           m_xTranslation = translation;
           m_yTranslation = translation;
           m_zTranslation = translation;
@@ -147,6 +155,7 @@ namespace noise
         void SetTranslation (double xTranslation, double yTranslation,
           double zTranslation)
         {
+          IncrementVersion ();
           m_xTranslation = xTranslation;
           m_yTranslation = yTranslation;
           m_zTranslation = zTranslation;
@@ -163,6 +172,7 @@ namespace noise
         /// output value from the source module
         void SetXTranslation (double xTranslation)
         {
+          IncrementVersion ();
           m_xTranslation = xTranslation;
         }
 
@@ -177,6 +187,7 @@ namespace noise
         /// output value from the source module
         void SetYTranslation (double yTranslation)
         {
+          IncrementVersion ();
           m_yTranslation = yTranslation;
         }
 
@@ -191,6 +202,7 @@ namespace noise
         /// output value from the source module
         void SetZTranslation (double zTranslation)
         {
+          IncrementVersion ();
           m_zTranslation = zTranslation;
         }
 
@@ -179,6 +179,13 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual double GetLipschitzBound () const;
+
+        virtual Interval GetValueRange (const Box& box) const;
+
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* out) const;
+
         /// Sets the frequency of the turbulence.
         ///
         /// @param frequency The frequency of the turbulence.
@@ -187,6 +194,7 @@ namespace noise
         /// displacement amount changes.
         void SetFrequency (double frequency)
         {
+          IncrementVersion ();
           // Set the frequency of each Perlin-Noise module.
           m_xDistortModule.SetFrequency (frequency);
           m_yDistortModule.SetFrequency (frequency);
@@ -201,6 +209,7 @@ namespace noise
         /// applied to the displacement amount.
         void SetPower (double power)
         {
+          IncrementVersion ();
           m_power = power;
         }
 
@@ -220,6 +229,7 @@ namespace noise
         /// modules.
         void SetRoughness (int roughness)
         {
+          IncrementVersion ();
           // Set the octave count for each Perlin-Noise module.
           m_xDistortModule.SetOctaveCount (roughness);
           m_yDistortModule.SetOctaveCount (roughness);
@@ -242,6 +252,26 @@ namespace noise
 
       protected:
 
+        /// Calculates the displaced coordinates of several input values.
+        ///
+        /// @param count The number of input values.
+        /// @param x The @a x coordinates of the input values.
+        /// @param y The @a y coordinates of the input values.
+        /// @param z The @a z coordinates of the input values.
+        /// @param xDistort On exit, the displaced @a x coordinates.
+        /// @param yDistort On exit, the displaced @a y coordinates.
+        /// @param zDistort On exit, the displaced @a z coordinates.
+        ///
+        /// The three Noise::module::Perlin Noise modules share every
+        /// parameter except their seeds, so this method evaluates them
+        /// together in a single octave loop, passing all of their
+        /// coherent-Noise lookups to one call of GradientCoherentNoise3D().
+        /// The displaced coordinates are identical to those produced by
+        /// evaluating each Noise::module::Perlin Noise module separately.
+        void GetDistortion (int count, const double* x, const double* y,
+          const double* z, double* xDistort, double* yDistort,
+          double* zDistort) const;
+
         /// The power (scale) of the displacement.
         double m_power;
 
@@ -118,6 +118,7 @@ namespace noise
         /// formations.
         void EnableDistance (bool enable = true)
         {
+          IncrementVersion ();
           m_enableDistance = enable;
         }
 
@@ -179,6 +180,10 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual double GetLipschitzBound () const;
+
+        virtual Interval GetValueRange (const Box& box) const;
+
         /// Sets the displacement value of the Voronoi cells.
         ///
         /// @param displacement The displacement value of the Voronoi cells.
@@ -189,6 +194,7 @@ namespace noise
         /// cell.  The range of random values is +/- the displacement value.
         void SetDisplacement (double displacement)
         {
+          IncrementVersion ();
           m_displacement = displacement;
         }
 
@@ -200,6 +206,7 @@ namespace noise
         /// distance between these cells.
         void SetFrequency (double frequency)
         {
+          IncrementVersion ();
           m_frequency = frequency;
         }
 
@@ -212,6 +219,7 @@ namespace noise
         /// of that function changes.
         void SetSeed (int seed)
         {
+          IncrementVersion ();
           m_seed = seed;
         }
 
@@ -70,5 +70,11 @@
 #include "module/module.h"
 #include "model/model.h"
 #include "misc.h"
+#include "executor.h"
+#include "graph.h"
+#include "optimizer.h"
+#include "profiler.h"
+#include "scheduler.h"
+#include "serialize.h"
 
 #endif
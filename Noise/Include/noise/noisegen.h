@@ -77,6 +77,62 @@ namespace noise
   double GradientCoherentNoise3D (double x, double y, double z, int seed = 0,
     NoiseQuality noiseQuality = QUALITY_STD);
 
+  /// Generates gradient-coherent-Noise values from the coordinates of
+  /// several three-dimensional input values.
+  ///
+  /// @param count The number of input values.
+  /// @param x The @a x coordinates of the input values.
+  /// @param y The @a y coordinates of the input values.
+  /// @param z The @a z coordinates of the input values.
+  /// @param seed The random number seed for each input value.
+  /// @param noiseQuality The quality of the coherent-Noise.
+  /// @param out On exit, the generated gradient-coherent-Noise values.
+  ///
+  /// Each output value is identical to the value that the single-value
+  /// version of this function returns for the same input value and seed.
+  /// The input values are processed in small groups, one stage of the
+  /// calculation at a time, so that the work for independent input values
+  /// overlaps and the compiler can vectorize the arithmetic across them.
+  void GradientCoherentNoise3D (int count, const double* x, const double* y,
+    const double* z, const int* seed, NoiseQuality noiseQuality, double* out);
+
+  /// The largest magnitude that GradientCoherentNoise3D() can return.
+  ///
+  /// Although the output value usually ranges from -1.0 to +1.0, it may
+  /// slightly exceed that range.  Each corner of the surrounding lattice cube
+  /// contributes at most 2.12 times its distance to the input value, and the
+  /// interpolation weights limit the weighted distance to sqrt (3) / 2, for
+  /// every Noise quality.  Noise modules use this constant to calculate
+  /// conservative bounds on their output values.
+  const double GRADIENT_COHERENT_NOISE_BOUND = 2.12 * 0.8660254037844386;
+
+  /// Returns the largest rate of change of GradientCoherentNoise3D().
+  ///
+  /// @param noiseQuality The quality of the coherent-Noise.
+  ///
+  /// @returns A bound on the magnitude of the gradient of the
+  /// gradient-coherent-Noise function.
+  ///
+  /// Within a lattice cube, the derivative of the output value along any
+  /// direction is linear in the eight gradient vectors at the corners of the
+  /// cube, so it is largest when each of those unit vectors points along its
+  /// coefficient.  The largest sum of the coefficient lengths over every
+  /// position within the cube and every direction is 2.806, 2.180 and 2.793
+  /// for linear, cubic and quintic S-curves.  The constants below are those
+  /// sums times 2.12, rounded up.  Noise modules use this function to
+  /// calculate their Lipschitz bounds.
+  inline double GradientCoherentNoiseLipschitzBound (NoiseQuality noiseQuality)
+  {
+    switch (noiseQuality) {
+      case QUALITY_FAST:
+        return 5.95;
+      case QUALITY_STD:
+        return 4.63;
+      default:
+        return 5.93;
+    }
+  }
+
   /// Generates a gradient-Noise value from the coordinates of a
   /// three-dimensional input value and the integer coordinates of a
   /// nearby three-dimensional value.
@@ -0,0 +1,194 @@
+// optimizer.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+#ifndef NOISE_OPTIMIZER_H
+#define NOISE_OPTIMIZER_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "module/modulebase.h"
+
+namespace noise
+{
+
+	/// @addtogroup libnoise
+	/// @{
+
+	/// Summary of the changes made by the Noise::GraphOptimizer class.
+	struct OptimizerReport
+	{
+
+		/// Number of distinct Noise modules in the original graph.
+		int inputModuleCount = 0;
+
+		/// Number of distinct Noise modules in the optimized graph.
+		int outputModuleCount = 0;
+
+		/// Number of Noise modules replaced by a Noise::module::Const
+		/// Noise module.
+		int foldedConstantCount = 0;
+
+		/// Number of affine output modules (Noise::module::ScaleBias,
+		/// Noise::module::Invert, and Noise::module::Add or
+		/// Noise::module::Multiply with a constant operand) merged into a
+		/// single Noise::module::ScaleBias Noise module.
+		int foldedAffineCount = 0;
+
+		/// Number of transformer modules merged into a single
+		/// Noise::module::TransformPoint Noise module.
+		int fusedTransformCount = 0;
+
+		/// Number of Noise modules removed because they do not change their
+		/// source module.
+		int removedIdentityCount = 0;
+
+		/// Number of Noise::module::Select and Noise::module::Blend Noise
+		/// modules replaced by the only source module they can output.
+		int resolvedSelectionCount = 0;
+
+		/// A human-readable description of each change.
+		std::vector<std::string> changes;
+
+	};
+
+	/// Rewrites a graph of Noise modules into an equivalent, smaller graph.
+	///
+	/// Each Noise module in a graph costs a virtual call per output value.
+	/// This class removes Noise modules that can be folded into their
+	/// neighbours:
+	/// - Chains of Noise::module::ScaleBias and Noise::module::Invert Noise
+	///   modules, and Noise::module::Add or Noise::module::Multiply Noise
+	///   modules with a Noise::module::Const operand, are folded into a
+	///   single Noise::module::ScaleBias Noise module.
+	/// - Chains of Noise::module::ScalePoint, Noise::module::TranslatePoint,
+	///   Noise::module::RotatePoint and Noise::module::TransformPoint Noise
+	///   modules are fused into a single Noise::module::TransformPoint Noise
+	///   module.
+	/// - Noise modules whose output values only depend on
+	///   Noise::module::Const Noise modules are replaced by a
+	///   Noise::module::Const Noise module.
+	/// - Noise::module::Select and Noise::module::Blend Noise modules with a
+	///   constant control module are replaced by the source module they
+	///   select.
+	/// - Noise modules that do not change their source module, such as a
+	///   Noise::module::ScaleBias Noise module with a scale of 1.0 and a
+	///   bias of 0.0, are removed.
+	///
+	/// The original graph is not modified.  Noise modules that are not
+	/// affected by a change are shared between the original graph and the
+	/// optimized graph; other Noise modules are copied.  The copies and the
+	/// new Noise modules are owned by this object.
+	///
+	/// Folding arithmetic changes the order of floating-point operations, so
+	/// the output values from the optimized graph may differ from the
+	/// original output values by a few units in the last place.
+	///
+	/// Optimize a graph after its parameters have been set; changes made to
+	/// the original Noise modules afterwards are not reflected in the copies.
+	/// Noise modules of application-defined classes are never rewritten,
+	/// and the graph below them is left unchanged.
+	class GraphOptimizer
+	{
+
+	public:
+
+		/// Constructor.
+		GraphOptimizer();
+
+		GraphOptimizer(const GraphOptimizer&) = delete;
+
+		GraphOptimizer& operator=(const GraphOptimizer&) = delete;
+
+		/// Destroys every Noise module created by this object.
+		///
+		/// Graphs returned by the Optimize() method become invalid.
+		void Clear();
+
+		/// Returns the summary of the changes made by the last call to the
+		/// Optimize() method.
+		///
+		/// @returns The report.
+		const OptimizerReport& GetReport() const
+		{
+			return m_report;
+		}
+
+		/// Optimizes a graph of Noise modules.
+		///
+		/// @param root The Noise module at the root of the graph.
+		///
+		/// @returns The Noise module at the root of the optimized graph.
+		///
+		/// @pre Every Noise module in the graph has all of its source modules
+		/// set.
+		///
+		/// @throw Noise::ExceptionNoModule A Noise module in the graph is
+		/// missing a source module.
+		///
+		/// The returned graph remains valid until this object is destroyed
+		/// or the Clear() method is called.  The Noise modules in the
+		/// original graph must exist for at least as long.
+		const module::Module& Optimize(const module::Module& root);
+
+	private:
+
+		/// Creates a Noise module owned by this object.
+		template <class T>
+		T& Create();
+
+		/// Creates a copy of a Noise module with new source modules.
+		///
+		/// @returns A pointer to the copy, or @a nullptr if the class of the
+		/// Noise module is unknown.
+		const module::Module* Copy(const module::Module& original,
+			const std::vector<const module::Module*>& sources);
+
+		/// Returns the optimized equivalent of a Noise module.
+		const module::Module& OptimizeModule(const module::Module& original);
+
+		/// Applies the rewrite rules to a Noise module.
+		///
+		/// @returns The replacement, or @a nullptr if no rule applies.
+		const module::Module* Rewrite(const module::Module& original,
+			const std::vector<const module::Module*>& sources);
+
+		/// The Noise modules created by this object.
+		std::vector<std::unique_ptr<module::Module>> m_modules;
+
+		/// The optimized equivalent of each Noise module visited by the
+		/// current call to the Optimize() method.
+		std::map<const module::Module*, const module::Module*> m_optimized;
+
+		/// The summary of the changes made by the last call to the
+		/// Optimize() method.
+		OptimizerReport m_report;
+
+	};
+
+	/// @}
+
+}
+
+#endif
@@ -0,0 +1,240 @@
+// profiler.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+#ifndef NOISE_PROFILER_H
+#define NOISE_PROFILER_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "module/modulebase.h"
+
+namespace noise
+{
+
+	/// @addtogroup libnoise
+	/// @{
+
+	/// Default number of evaluations between two timed evaluations for the
+	/// Noise::Profiler class.
+	const int DEFAULT_PROFILER_SAMPLING_INTERVAL = 1;
+
+	/// Profiling statistics for one Noise module.
+	struct ProfileRecord
+	{
+
+		/// The name of the Noise module.
+		std::string name;
+
+		/// Number of output values requested from the Noise module.
+		std::uint64_t callCount;
+
+		/// Number of output values whose evaluation was timed.
+		std::uint64_t sampledCallCount;
+
+		/// Estimated time spent in the Noise module and its source modules,
+		/// in seconds.
+		double inclusiveTime;
+
+		/// Estimated time spent in the Noise module itself, in seconds.
+		double exclusiveTime;
+
+	};
+
+	/// Records call counts and timings for every Noise module in a graph.
+	///
+	/// Pass the root of a graph to the Instrument() method, evaluate the
+	/// returned graph instead of the original, then write the statistics
+	/// with the WriteTable() or WriteJson() method:
+	///
+	/// @code
+	/// noise::Profiler profiler;
+	/// profiler.SetName (mountainTerrain, "mountains");
+	/// heightMapBuilder.SetSourceModule (profiler.Instrument (finalTerrain));
+	/// heightMapBuilder.Build ();
+	/// profiler.WriteTable (std::cout);
+	/// @endcode
+	///
+	/// The instrumented graph is a copy of the original graph in which every
+	/// Noise module is wrapped by a timing module.  A Noise module that is
+	/// shared by several Noise modules has one set of statistics.  Noise
+	/// modules without a name passed to the SetName() method are named after
+	/// their class.  Noise modules of application-defined classes are timed
+	/// together with their source modules.
+	///
+	/// The inclusive time of a Noise module includes the time spent in its
+	/// source modules; the exclusive time does not.
+	///
+	/// The instrumented graph is evaluated the same way as the original.
+	/// In particular, Noise::RasterExecutor and the noise map builders plan
+	/// it into the same steps, skip the same source modules for each tile
+	/// and time each step separately.  A pointwise Noise module, such as
+	/// Noise::module::Add, does not call its source modules in that case, so
+	/// its inclusive time equals its exclusive time.
+	///
+	/// Reading the clock for every output value slows down small Noise
+	/// modules noticeably.  To reduce this overhead, pass a value greater
+	/// than one to the SetSamplingInterval() method; only one in that many
+	/// evaluations of the graph is timed, and the times are extrapolated
+	/// from the call counts, which are always exact.
+	///
+	/// Profiling is only available if libnoise is built with the
+	/// NOISE_ENABLE_PROFILING option.  Otherwise the Instrument() method
+	/// returns the original graph and no statistics are recorded, so that
+	/// profiling code costs nothing at run time.
+	///
+	/// Several threads may evaluate an instrumented graph at once.  The
+	/// counters are updated atomically.
+	class Profiler
+	{
+
+	public:
+
+		/// Constructor.
+		///
+		/// The default sampling interval is set to
+		/// Noise::DEFAULT_PROFILER_SAMPLING_INTERVAL.
+		Profiler();
+
+		/// Destructor.
+		~Profiler();
+
+		Profiler(const Profiler&) = delete;
+
+		Profiler& operator=(const Profiler&) = delete;
+
+		/// Destroys every instrumented graph and its statistics.
+		///
+		/// Graphs returned by the Instrument() method become invalid.
+		void Clear();
+
+		/// Returns the statistics of every instrumented Noise module.
+		///
+		/// @returns The statistics, sorted by decreasing exclusive time.
+		std::vector<ProfileRecord> GetRecords() const;
+
+		/// Returns the number of evaluations between two timed evaluations.
+		///
+		/// @returns The sampling interval.
+		int GetSamplingInterval() const
+		{
+			return m_samplingInterval;
+		}
+
+		/// Creates an instrumented copy of a graph of Noise modules.
+		///
+		/// @param root The Noise module at the root of the graph.
+		///
+		/// @returns The Noise module at the root of the instrumented graph.
+		///
+		/// @pre Every Noise module in the graph has all of its source modules
+		/// set.
+		///
+		/// @throw Noise::ExceptionNoModule A Noise module in the graph is
+		/// missing a source module.
+		///
+		/// The returned graph remains valid until this object is destroyed
+		/// or the Clear() method is called.  The Noise modules in the
+		/// original graph must exist for at least as long.
+		const module::Module& Instrument(const module::Module& root);
+
+		/// Determines if libnoise was built with profiling support.
+		///
+		/// @returns
+		/// - @a true if the Instrument() method instruments graphs.
+		/// - @a false if it returns them unchanged.
+		static bool IsEnabled();
+
+		/// Resets the statistics of every instrumented Noise module.
+		void ResetStats();
+
+		/// Assigns a name to a Noise module.
+		///
+		/// @param module The Noise module in the original graph.
+		/// @param name The name under which its statistics are reported.
+		///
+		/// Names must be assigned before the graph is instrumented.
+		void SetName(const module::Module& module, const std::string& name);
+
+		/// Sets the number of evaluations between two timed evaluations.
+		///
+		/// @param samplingInterval The sampling interval.
+		///
+		/// @pre The sampling interval is positive.
+		///
+		/// @throw Noise::ExceptionInvalidParam An invalid parameter was
+		/// specified; see the preconditions for more information.
+		///
+		/// An evaluation is a call to the root of an instrumented graph, or
+		/// to a step of a Noise::RasterExecutor plan; all of the Noise
+		/// modules it reaches are timed together.  Each Noise module counts
+		/// the evaluations it starts separately.
+		void SetSamplingInterval(int samplingInterval);
+
+		/// Writes the statistics as a JSON document.
+		///
+		/// @param os The output stream.
+		void WriteJson(std::ostream& os) const;
+
+		/// Writes the statistics as a plain-text table.
+		///
+		/// @param os The output stream.
+		void WriteTable(std::ostream& os) const;
+
+	private:
+
+		/// Raw statistics of one Noise module.
+		struct Counters;
+
+		/// Noise module that records the statistics of its source module.
+		class TimingModule;
+
+		/// Returns the instrumented equivalent of a Noise module.
+		const module::Module& InstrumentModule(const module::Module& original);
+
+		/// The statistics of each instrumented Noise module.
+		std::vector<std::unique_ptr<Counters>> m_counters;
+
+		/// The instrumented equivalent of each Noise module visited by the
+		/// current call to the Instrument() method.
+		std::map<const module::Module*, const module::Module*> m_instrumented;
+
+		/// The copies of the original Noise modules and the timing modules.
+		std::vector<std::unique_ptr<module::Module>> m_modules;
+
+		/// The names assigned to the original Noise modules.
+		std::map<const module::Module*, std::string> m_names;
+
+		/// Number of evaluations between two timed evaluations.
+		int m_samplingInterval;
+
+	};
+
+	/// @}
+
+}
+
+#endif
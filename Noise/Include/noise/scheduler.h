@@ -0,0 +1,185 @@
+// scheduler.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#ifndef NOISE_SCHEDULER_H
+#define NOISE_SCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace noise
+{
+
+	/// @addtogroup libnoise
+	/// @{
+
+	/// Runs a batch of independent tasks on a pool of threads that steal
+	/// work from each other.
+	///
+	/// The tasks of a batch are numbered from zero, and the order of those
+	/// numbers is the order in which the application wants them to run;
+	/// for example, the tiles of an image sorted along a space-filling
+	/// curve.  The Run() method splits the numbers into one contiguous
+	/// range per thread.  Each thread takes its tasks from the front of its
+	/// own range, so neighbouring tasks run one after another on the same
+	/// thread.  A thread that runs out of tasks steals the back half of the
+	/// range that has the most tasks left, which keeps every thread busy
+	/// until the end of the batch even if some tasks take much longer than
+	/// others.
+	///
+	/// The threads are started by the constructor and wait for batches until
+	/// this object is destroyed.  The thread that calls Run() runs tasks as
+	/// well, so a scheduler with a thread count of one runs every task on
+	/// the calling thread.
+	///
+	/// Only one thread at a time may call the Run() method.
+	class TaskScheduler
+	{
+
+	public:
+
+		/// A task of a batch.
+		///
+		/// The function receives the number of the task and the index of the
+		/// thread that runs it, from zero to one less than the number of
+		/// threads.  The calling thread of Run() has the index zero.
+		using Task = std::function<void(int task, int thread)>;
+
+		/// Constructor.
+		///
+		/// @param threadCount The number of threads, including the thread
+		/// that calls Run().
+		///
+		/// @pre The number of threads is positive.
+		///
+		/// @throw Noise::ExceptionInvalidParam An invalid parameter was
+		/// specified; see the preconditions for more information.
+		explicit TaskScheduler(int threadCount);
+
+		/// Destructor.
+		///
+		/// Stops the threads.
+		~TaskScheduler();
+
+		TaskScheduler(const TaskScheduler&) = delete;
+
+		TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+		/// Returns the number of threads that run the tasks.
+		///
+		/// @returns The number of threads, including the thread that calls
+		/// Run().
+		int GetThreadCount() const
+		{
+			return (int)m_queues.size();
+		}
+
+		/// Runs a batch of tasks and waits for all of them to finish.
+		///
+		/// @param taskCount The number of tasks.
+		/// @param task The function that runs a task.
+		///
+		/// If a task throws an exception, the tasks that have not started
+		/// are abandoned, and the first exception is rethrown once the
+		/// running tasks have finished.
+		void Run(int taskCount, const Task& task);
+
+	private:
+
+		/// The tasks that remain in the range of a thread.
+		struct Queue
+		{
+
+			/// Protects the range.
+			std::mutex mutex;
+
+			/// The next task to run.
+			int begin = 0;
+
+			/// One past the last task to run.
+			int end = 0;
+
+		};
+
+		/// Runs tasks until no thread has any left.
+		///
+		/// @param thread The index of the calling thread.
+		void Work(int thread);
+
+		/// Takes the next task of a thread, stealing from another thread if
+		/// its own range is empty.
+		///
+		/// @param thread The index of the calling thread.
+		///
+		/// @returns The number of the task, or -1 if no task remains.
+		int TakeTask(int thread);
+
+		/// Entry point of a worker thread.
+		///
+		/// @param thread The index of the worker thread.
+		void WorkerMain(int thread);
+
+		/// Signalled when a batch starts, when a worker thread finishes it,
+		/// and when the scheduler stops.
+		std::condition_variable m_changed;
+
+		/// The first exception thrown by a task of the current batch.
+		std::exception_ptr m_error;
+
+		/// Increases by one each time a batch starts.
+		int m_generation;
+
+		/// Determines if a task of the current batch has thrown an
+		/// exception.
+		std::atomic<bool> m_isFailed;
+
+		/// Determines if the worker threads must stop.
+		bool m_isStopping;
+
+		/// Protects the batch state and the exception.
+		std::mutex m_mutex;
+
+		/// The range of tasks of each thread.
+		std::vector<std::unique_ptr<Queue>> m_queues;
+
+		/// Number of worker threads still running the current batch.
+		int m_runningCount;
+
+		/// The function that runs a task of the current batch.
+		const Task* m_pTask;
+
+		/// The worker threads.
+		std::vector<std::thread> m_threads;
+
+	};
+
+	/// @}
+
+}
+
+#endif
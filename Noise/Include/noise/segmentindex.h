@@ -0,0 +1,121 @@
+// segmentindex.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#ifndef NOISE_SEGMENTINDEX_H
+#define NOISE_SEGMENTINDEX_H
+
+#include <vector>
+
+namespace noise
+{
+
+	/// @addtogroup libnoise
+	/// @{
+
+	/// Locates the segment of a sorted array of breakpoints that contains a
+	/// value.
+	///
+	/// Noise modules that map their source values onto a piecewise function,
+	/// such as Noise::module::Curve and Noise::module::Terrace, use this
+	/// class instead of searching their control points on every output
+	/// value.  The range between the first and last breakpoints is divided
+	/// into uniform buckets; each bucket records the segment that contains
+	/// its lower edge, so that a lookup only steps across the breakpoints
+	/// that lie within one bucket.
+	///
+	/// The index must be rebuilt by calling Build() whenever the breakpoints
+	/// change.
+	class SegmentIndex
+	{
+
+	public:
+
+		/// Constructor.
+		SegmentIndex ();
+
+		/// Builds the index from an array of breakpoints.
+		///
+		/// @param breakpoints The breakpoints, sorted in increasing order
+		/// with no duplicates.
+		/// @param count The number of breakpoints.
+		///
+		/// The breakpoints are copied into the index.
+		void Build (const double* breakpoints, int count);
+
+		/// Returns the number of breakpoints that are less than or equal to a
+		/// value.
+		///
+		/// @param value The value.
+		///
+		/// @returns The number of breakpoints that are less than or equal to
+		/// @a value, or the number of breakpoints if @a value is not a
+		/// number.
+		///
+		/// @pre The index holds at least one breakpoint.
+		///
+		/// The returned value equals the position found by a linear search
+		/// for the first breakpoint greater than @a value.
+		int Find (double value) const
+		{
+			int last = (int)m_breakpoints.size () - 1;
+			if (value < m_breakpoints[0]) {
+				return 0;
+			} else if (!(value < m_breakpoints[last])) {
+				return last + 1;
+			}
+
+			int bucket = (int)((value - m_breakpoints[0]) * m_bucketScale);
+			if (bucket >= (int)m_bucketStart.size ()) {
+				bucket = (int)m_bucketStart.size () - 1;
+			}
+
+			// The bucket edges are subject to rounding, so step in either
+			// direction until the value lies within the segment.
+			int pos = m_bucketStart[bucket];
+			while (pos > 0 && value < m_breakpoints[pos - 1]) {
+				--pos;
+			}
+			while (!(value < m_breakpoints[pos])) {
+				++pos;
+			}
+			return pos;
+		}
+
+	private:
+
+		/// The breakpoints, sorted in increasing order.
+		std::vector<double> m_breakpoints;
+
+		/// The number of breakpoints less than or equal to the lower edge of
+		/// each bucket.
+		std::vector<int> m_bucketStart;
+
+		/// The number of buckets per unit of input value.
+		double m_bucketScale;
+
+	};
+
+	/// @}
+
+}
+
+#endif
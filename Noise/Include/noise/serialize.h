@@ -0,0 +1,168 @@
+// serialize.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+#ifndef NOISE_SERIALIZE_H
+#define NOISE_SERIALIZE_H
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <vector>
+#include "module/modulebase.h"
+
+namespace noise
+{
+
+	/// @addtogroup libnoise
+	/// @{
+
+	/// A graph of Noise modules read by the Noise::ReadGraph() function.
+	///
+	/// This object owns the Noise modules of the graph.  The Noise modules
+	/// are stored so that every Noise module comes after its source modules;
+	/// the last one is the root of the graph.
+	class ModuleGraph
+	{
+
+	public:
+
+		/// Constructor.
+		///
+		/// @param modules The Noise modules of the graph, with the root last.
+		///
+		/// @pre There is at least one Noise module.
+		explicit ModuleGraph(std::vector<std::unique_ptr<module::Module>> modules);
+
+		/// Returns a Noise module of the graph.
+		///
+		/// @param index The position of the Noise module.
+		///
+		/// @returns A reference to the Noise module.
+		///
+		/// @pre The position ranges from 0 to one less than the number of
+		/// Noise modules.
+		const module::Module& GetModule(int index) const
+		{
+			return *m_modules[index];
+		}
+
+		/// Returns the number of Noise modules in the graph.
+		///
+		/// @returns The number of Noise modules.
+		int GetModuleCount() const
+		{
+			return (int)m_modules.size();
+		}
+
+		/// Returns the Noise module at the root of the graph.
+		///
+		/// @returns A reference to the root.
+		const module::Module& GetRoot() const
+		{
+			return *m_modules.back();
+		}
+
+	private:
+
+		/// The Noise modules of the graph, with the root last.
+		std::vector<std::unique_ptr<module::Module>> m_modules;
+
+	};
+
+	/// Returns a hash of the structure and parameters of a graph of Noise
+	/// modules.
+	///
+	/// @param root The Noise module at the root of the graph.
+	///
+	/// @returns The 64-bit FNV-1a hash of the binary serialization of the
+	/// graph.
+	///
+	/// @throw Noise::ExceptionInvalidParam The graph contains a Noise module
+	/// whose class is not part of libnoise.
+	/// @throw Noise::ExceptionNoModule A Noise module in the graph is
+	/// missing a source module.
+	///
+	/// Two graphs have the same hash if they have the same wiring and their
+	/// Noise modules have the same classes and parameters, regardless of
+	/// where the Noise modules are stored in memory.  The hash is suitable
+	/// as a key for caching output values.
+	std::uint64_t HashGraph(const module::Module& root);
+
+	/// Reads a graph of Noise modules.
+	///
+	/// @param is The input stream.
+	///
+	/// @returns The graph.
+	///
+	/// @throw Noise::ExceptionInvalidFormat The stream does not contain a
+	/// valid graph.
+	///
+	/// Both the binary format written by the WriteGraph() function and the
+	/// text format written by the WriteGraphText() function are accepted.
+	std::unique_ptr<ModuleGraph> ReadGraph(std::istream& is);
+
+	/// Writes a graph of Noise modules in a compact binary format.
+	///
+	/// @param os The output stream, opened in binary mode.
+	/// @param root The Noise module at the root of the graph.
+	///
+	/// @throw Noise::ExceptionInvalidParam The graph contains a Noise module
+	/// whose class is not part of libnoise.
+	/// @throw Noise::ExceptionNoModule A Noise module in the graph is
+	/// missing a source module.
+	///
+	/// Every Noise module reachable from the root is written once, along
+	/// with its parameters, its control points and the positions of its
+	/// source modules.  The internal state of caching Noise modules is not
+	/// written.  Numbers are stored in little-endian byte order, so the
+	/// format does not depend on the platform.
+	void WriteGraph(std::ostream& os, const module::Module& root);
+
+	/// Writes a graph of Noise modules in a human-readable text format.
+	///
+	/// @param os The output stream.
+	/// @param root The Noise module at the root of the graph.
+	///
+	/// @throw Noise::ExceptionInvalidParam The graph contains a Noise module
+	/// whose class is not part of libnoise.
+	/// @throw Noise::ExceptionNoModule A Noise module in the graph is
+	/// missing a source module.
+	///
+	/// Each Noise module is written on its own line, for example:
+	///
+	/// @verbatim
+	/// noise-graph 1
+	/// 0 Perlin frequency=1 lacunarity=2 noiseQuality=1 octaveCount=6 seed=0 persistence=0.5
+	/// 1 Const constValue=0.25
+	/// 2 Add sources=0,1
+	/// @endverbatim
+	///
+	/// Values are written with enough digits to be read back exactly.
+	void WriteGraphText(std::ostream& os, const module::Module& root);
+
+	/// @}
+
+}
+
+#endif
@@ -0,0 +1,210 @@
+// threadstate.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#ifndef NOISE_THREADSTATE_H
+#define NOISE_THREADSTATE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace noise
+{
+
+	/// @addtogroup libnoise
+	/// @{
+
+	/// Base class of Noise::ThreadState.
+	///
+	/// This class keeps track of the ThreadState objects that exist, so that
+	/// the copies of a thread can be released when the thread exits.
+	class ThreadStateBase
+	{
+
+	public:
+
+		ThreadStateBase(const ThreadStateBase&) = delete;
+
+		ThreadStateBase& operator=(const ThreadStateBase&) = delete;
+
+	protected:
+
+		/// The identifier of a ThreadState object and the copy of a thread.
+		using Entry = std::pair<std::uint64_t, void*>;
+
+		/// Number of recently looked up entries remembered by each thread.
+		static const int RECENT_ENTRY_COUNT = 8;
+
+		/// Constructor.
+		///
+		/// Assigns a unique identifier to this object and registers it.
+		ThreadStateBase();
+
+		/// Destructor.
+		virtual ~ThreadStateBase();
+
+		/// Looks up the copy of the calling thread in its index.
+		///
+		/// @returns The copy, or a null pointer if the calling thread has no
+		/// copy yet.
+		void* FindEntry() const;
+
+		/// Adds the copy of the calling thread to its index.
+		///
+		/// @param pState The copy.
+		///
+		/// The index also drops the entries of the ThreadState objects that
+		/// were destroyed, so the caller must not hold the mutex of any
+		/// ThreadState object.
+		void InsertEntry(void* pState) const;
+
+		/// Returns the slot of this object among the entries recently looked
+		/// up by the calling thread.
+		Entry& RecentEntry() const;
+
+		/// Destroys the copy of a thread that has exited.
+		///
+		/// @param pState The copy.
+		virtual void Release(void* pState) = 0;
+
+		/// Removes this object from the registry.
+		///
+		/// Derived classes call this method at the start of their
+		/// destructor, before the copies are destroyed.
+		void Unregister();
+
+		/// The unique identifier of this object.
+		const std::uint64_t m_id;
+
+	private:
+
+		/// The index of the copies of a thread.
+		struct ThreadEntries;
+
+		/// Returns the index of the copies of the calling thread.
+		static ThreadEntries& GetThreadEntries();
+
+		/// Determines if this object is still in the registry.
+		bool m_isRegistered;
+
+	};
+
+	/// Stores a separate copy of some state for each thread.
+	///
+	/// Caching Noise modules, such as Noise::module::Cache, modify their
+	/// contents from their const methods.  They keep those contents in a
+	/// ThreadState object so that several threads can evaluate the same
+	/// graph at once, each thread reading and writing its own copy.
+	///
+	/// The Get() method returns the copy of the calling thread, creating it
+	/// with the default constructor of @a State the first time the thread
+	/// asks for it.  Each thread remembers the last few ThreadState objects
+	/// it looked up, so repeated calls from the same thread rarely search.
+	///
+	/// The copies belong to this object and are destroyed with it, or when
+	/// the thread that created them exits, whichever comes first.
+	template <class State>
+	class ThreadState: public ThreadStateBase
+	{
+
+	public:
+
+		/// Constructor.
+		ThreadState() = default;
+
+		/// Destructor.
+		~ThreadState() override
+		{
+			Unregister();
+		}
+
+		/// Calls a function on the copy of every thread.
+		///
+		/// @param function The function, which takes a reference to a
+		/// @a State object.
+		///
+		/// The copies must not be in use by other threads.
+		template <class Function>
+		void ForEach(const Function& function) const
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for (const std::unique_ptr<State>& pState : m_states)
+			{
+				function(*pState);
+			}
+		}
+
+		/// Returns the copy of the calling thread.
+		///
+		/// @returns A reference to the copy.
+		State& Get() const
+		{
+			Entry& recent = RecentEntry();
+			if (recent.first == m_id)
+			{
+				return *static_cast<State*>(recent.second);
+			}
+			void* pState = FindEntry();
+			if (pState == nullptr)
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_states.push_back(std::make_unique<State>());
+					pState = m_states.back().get();
+				}
+				InsertEntry(pState);
+			}
+			recent = Entry(m_id, pState);
+			return *static_cast<State*>(pState);
+		}
+
+	private:
+
+		void Release(void* pState) override
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto pos = std::find_if(m_states.begin(), m_states.end(),
+				[&](const std::unique_ptr<State>& p) {
+					return p.get() == pState;
+				});
+			if (pos != m_states.end())
+			{
+				m_states.erase(pos);
+			}
+		}
+
+		/// Protects the array of copies.
+		mutable std::mutex m_mutex;
+
+		/// The copy of every thread that has called Get().
+		mutable std::vector<std::unique_ptr<State>> m_states;
+
+	};
+
+	/// @}
+
+}
+
+#endif
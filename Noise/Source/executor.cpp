@@ -0,0 +1,646 @@
+// executor.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <set>
+#include <thread>
+#include "noise/exception.h"
+#include "noise/executor.h"
+#include "noise/graph.h"
+#include "noise/interval.h"
+
+using namespace noise;
+using namespace noise::module;
+
+class RasterExecutor::WorkerPool
+{
+
+public:
+
+	/// Constructor.
+	///
+	/// Starts one less worker thread than the number of threads, since the
+	/// calling thread also evaluates steps.
+	WorkerPool(RasterExecutor& executor, int threadCount);
+
+	/// Destructor.
+	///
+	/// Stops the worker threads.
+	~WorkerPool();
+
+	/// Evaluates every step of the plan over a tile of input values.
+	void Run(int count, const double* x, const double* y, const double* z,
+		double* const* out);
+
+private:
+
+	/// Evaluates ready steps until the tile is complete.
+	///
+	/// @param lock The lock on the pool, held on entry and on exit.
+	/// @param isCaller Determines if this is the thread that called Run().
+	void Work(std::unique_lock<std::mutex>& lock, bool isCaller);
+
+	/// Entry point of a worker thread.
+	void WorkerMain();
+
+	/// Signalled when a step becomes ready, when the tile is complete and
+	/// when the pool stops.
+	std::condition_variable m_changed;
+
+	/// Number of steps of the current tile that have finished.
+	int m_completedCount;
+
+	/// The first exception thrown by a step of the current tile.
+	std::exception_ptr m_error;
+
+	/// The executor whose plan is evaluated.
+	RasterExecutor& m_executor;
+
+	/// Determines if the worker threads must stop.
+	bool m_isStopping;
+
+	/// Protects every member of the pool.
+	std::mutex m_mutex;
+
+	/// For each step, the number of steps it still waits for.
+	std::vector<int> m_pendingCount;
+
+	/// The steps whose inputs are ready.
+	std::vector<int> m_ready;
+
+	/// The worker threads.
+	std::vector<std::thread> m_threads;
+
+	/// Number of input values in the current tile.
+	int m_count;
+
+	/// The input values and output arrays of the current tile.
+	const double* m_x;
+	const double* m_y;
+	const double* m_z;
+	double* const* m_out;
+
+};
+
+RasterExecutor::WorkerPool::WorkerPool(RasterExecutor& executor,
+	int threadCount):
+	m_completedCount(0),
+	m_executor(executor),
+	m_isStopping(false),
+	m_count(0),
+	m_x(nullptr),
+	m_y(nullptr),
+	m_z(nullptr),
+	m_out(nullptr)
+{
+	for (int i = 1; i < threadCount; i++)
+	{
+		m_threads.emplace_back(&WorkerPool::WorkerMain, this);
+	}
+}
+
+RasterExecutor::WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isStopping = true;
+	}
+	m_changed.notify_all();
+	for (std::thread& thread : m_threads)
+	{
+		thread.join();
+	}
+}
+
+void RasterExecutor::WorkerPool::Run(int count, const double* x,
+	const double* y, const double* z, double* const* out)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_count = count;
+	m_x = x;
+	m_y = y;
+	m_z = z;
+	m_out = out;
+	m_completedCount = 0;
+	m_error = nullptr;
+	const std::vector<Step>& steps = m_executor.m_steps;
+	m_pendingCount.resize(steps.size());
+	m_ready.clear();
+	for (int i = 0; i < (int)steps.size(); i++)
+	{
+		m_pendingCount[i] = steps[i].dependencyCount;
+		if (m_pendingCount[i] == 0)
+		{
+			m_ready.push_back(i);
+		}
+	}
+	m_changed.notify_all();
+
+	Work(lock, true);
+
+	if (m_error)
+	{
+		std::rethrow_exception(m_error);
+	}
+}
+
+void RasterExecutor::WorkerPool::Work(std::unique_lock<std::mutex>& lock,
+	bool isCaller)
+{
+	const std::vector<Step>& steps = m_executor.m_steps;
+	for (;;)
+	{
+		if (m_ready.empty())
+		{
+			if (m_isStopping
+				|| (isCaller && m_completedCount == (int)steps.size()))
+			{
+				return;
+			}
+			m_changed.wait(lock);
+			continue;
+		}
+
+		int index = m_ready.back();
+		m_ready.pop_back();
+		lock.unlock();
+		std::exception_ptr error;
+		try
+		{
+			m_executor.RunStep(index, m_count, m_x, m_y, m_z, m_out);
+		}
+		catch (...)
+		{
+			error = std::current_exception();
+		}
+		lock.lock();
+
+		if (error && !m_error)
+		{
+			m_error = error;
+		}
+		for (int dependent : steps[index].dependents)
+		{
+			if (--m_pendingCount[dependent] == 0)
+			{
+				m_ready.push_back(dependent);
+			}
+		}
+		m_completedCount++;
+		m_changed.notify_all();
+	}
+}
+
+void RasterExecutor::WorkerPool::WorkerMain()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	Work(lock, false);
+}
+
+RasterExecutor::RasterExecutor():
+	m_planVersion(0),
+	m_threadCount(DEFAULT_EXECUTOR_THREAD_COUNT)
+{
+}
+
+RasterExecutor::RasterExecutor(const Module& root):
+	RasterExecutor()
+{
+	SetModule(root);
+}
+
+RasterExecutor::RasterExecutor(const std::vector<const Module*>& roots):
+	RasterExecutor()
+{
+	SetModules(roots);
+}
+
+RasterExecutor::~RasterExecutor()
+{
+}
+
+int RasterExecutor::AddStep(const Module& module,
+	std::map<const Module*, int>& stepIndex)
+{
+	auto found = stepIndex.find(&module);
+	if (found != stepIndex.end())
+	{
+		return found->second;
+	}
+
+	Step step;
+	step.pModule = &module;
+	step.firstFlag = 0;
+	step.buffer = -1;
+	step.output = -1;
+	step.dependencyCount = 0;
+	if (module.IsPointwise())
+	{
+		for (int i = 0; i < module.GetSourceModuleCount(); i++)
+		{
+			step.sources.push_back(AddStep(module.GetSourceModule(i), stepIndex));
+		}
+	}
+
+	// The source modules are added first, so the steps are in topological
+	// order.
+	m_steps.push_back(step);
+	int index = (int)m_steps.size() - 1;
+	stepIndex[&module] = index;
+	return index;
+}
+
+void RasterExecutor::GetValues(int count, const double* x, const double* y,
+	const double* z, double* out)
+{
+	if (m_roots.size() == 1)
+	{
+		GetValues(count, x, y, z, &out);
+		return;
+	}
+
+	// Only the first root is requested; the other roots are evaluated into
+	// scratch arrays.
+	std::vector<std::vector<double>> scratch(m_roots.size() - 1,
+		std::vector<double>(count > 0? count: 0));
+	std::vector<double*> outputs(1, out);
+	for (std::vector<double>& values : scratch)
+	{
+		outputs.push_back(values.data());
+	}
+	GetValues(count, x, y, z, outputs.data());
+}
+
+void RasterExecutor::GetValues(int count, const double* x, const double* y,
+	const double* z, double* const* out)
+{
+	assert (!m_roots.empty());
+
+	if (count <= 0)
+	{
+		return;
+	}
+	std::uint64_t version = 0;
+	for (const Module* pRoot : m_roots)
+	{
+		version = std::max(version, GetGraphVersion(*pRoot));
+	}
+	if (version != m_planVersion)
+	{
+		Plan();
+	}
+
+	// Walk the steps from the roots down to determine which of them are
+	// needed for this tile.
+	Box box = MakeBoundingBox(count, x, y, z);
+	int stepCount = (int)m_steps.size();
+	std::fill(m_isStepNeeded.begin(), m_isStepNeeded.end(), 0);
+	for (int rootStep : m_rootSteps)
+	{
+		m_isStepNeeded[rootStep] = 1;
+	}
+	for (int i = stepCount - 1; i >= 0; i--)
+	{
+		const Step& step = m_steps[i];
+		if (!m_isStepNeeded[i] || step.sources.empty())
+		{
+			continue;
+		}
+		bool* isSourceNeeded = &m_isSourceNeeded[step.firstFlag];
+		step.pModule->GetNeededSources(box, isSourceNeeded);
+		for (int j = 0; j < (int)step.sources.size(); j++)
+		{
+			if (isSourceNeeded[j])
+			{
+				m_isStepNeeded[step.sources[j]] = 1;
+			}
+		}
+	}
+
+	for (std::vector<double>& buffer : m_buffers)
+	{
+		if ((int)buffer.size() < count)
+		{
+			buffer.resize(count);
+		}
+	}
+
+	// Evaluate the needed steps in topological order, or as a task graph if
+	// there are worker threads.  The roots write their output values
+	// directly into the output arrays.
+	if (m_pWorkers != nullptr && stepCount > 1)
+	{
+		m_pWorkers->Run(count, x, y, z, out);
+	}
+	else
+	{
+		for (int i = 0; i < stepCount; i++)
+		{
+			RunStep(i, count, x, y, z, out);
+		}
+	}
+
+	// A Noise module passed as several roots is evaluated into the first
+	// of its output arrays.
+	for (int k = 0; k < (int)m_roots.size(); k++)
+	{
+		int output = m_steps[m_rootSteps[k]].output;
+		if (output != k)
+		{
+			std::copy(out[output], out[output] + count, out[k]);
+		}
+	}
+}
+
+void RasterExecutor::Plan()
+{
+	m_steps.clear();
+	m_buffers.clear();
+	m_rootSteps.clear();
+	m_planVersion = 0;
+	for (const Module* pRoot : m_roots)
+	{
+		m_planVersion = std::max(m_planVersion, GetGraphVersion(*pRoot));
+	}
+
+	std::map<const Module*, int> stepIndex;
+	for (int k = 0; k < (int)m_roots.size(); k++)
+	{
+		int rootStep = AddStep(*m_roots[k], stepIndex);
+		m_rootSteps.push_back(rootStep);
+		if (m_steps[rootStep].output < 0)
+		{
+			m_steps[rootStep].output = k;
+		}
+	}
+	int stepCount = (int)m_steps.size();
+
+	// Find the last step that reads the output values of each step.
+	std::vector<int> lastUse(m_steps.size(), -1);
+	int flagCount = 0;
+	for (int i = 0; i < stepCount; i++)
+	{
+		Step& step = m_steps[i];
+		for (int source : step.sources)
+		{
+			lastUse[source] = i;
+		}
+		step.firstFlag = flagCount;
+		flagCount += (int)step.sources.size();
+	}
+
+	// Assign a buffer to every step except the roots, reusing the buffers of
+	// steps whose output values have been read for the last time.  A buffer
+	// is released only after the step that reads it last has been assigned
+	// its own buffer, so a step never writes over one of its inputs.
+	//
+	// When the steps run concurrently, reusing a buffer forces a step to
+	// wait for every step that used the buffer before.  A buffer is then
+	// only reused by a step that already depends on all of those steps, so
+	// that independent subgraphs keep their own buffers.
+	bool isConcurrent = (m_threadCount > 1);
+	std::vector<std::vector<char>> isAncestor;
+	std::vector<std::vector<int>> bufferUsers;
+	std::vector<int> freeBuffers;
+	std::vector<char> isReleased(m_steps.size(), 0);
+	int bufferCount = 0;
+	for (int i = 0; i < stepCount; i++)
+	{
+		Step& step = m_steps[i];
+		if (isConcurrent)
+		{
+			isAncestor.emplace_back(m_steps.size(), 0);
+			for (int source : step.sources)
+			{
+				isAncestor[i][source] = 1;
+				for (int j = 0; j < source; j++)
+				{
+					isAncestor[i][j] |= isAncestor[source][j];
+				}
+			}
+		}
+
+		// The roots write into the output arrays, which are never reused.
+		step.buffer = -1;
+		for (int j = (int)freeBuffers.size() - 1; j >= 0 && step.output < 0;
+			j--)
+		{
+			int buffer = freeBuffers[j];
+			bool isSafe = true;
+			if (isConcurrent)
+			{
+				for (int user : bufferUsers[buffer])
+				{
+					isSafe = isSafe && isAncestor[i][user];
+				}
+			}
+			if (isSafe)
+			{
+				step.buffer = buffer;
+				freeBuffers.erase(freeBuffers.begin() + j);
+				break;
+			}
+		}
+		if (step.buffer < 0 && step.output < 0)
+		{
+			step.buffer = bufferCount++;
+			bufferUsers.emplace_back();
+		}
+		if (step.buffer >= 0)
+		{
+			bufferUsers[step.buffer].assign(1, i);
+		}
+
+		for (int source : step.sources)
+		{
+			if (m_steps[source].buffer < 0)
+			{
+				continue;
+			}
+			bufferUsers[m_steps[source].buffer].push_back(i);
+			if (lastUse[source] == i && !isReleased[source])
+			{
+				freeBuffers.push_back(m_steps[source].buffer);
+				isReleased[source] = 1;
+			}
+		}
+	}
+
+	m_buffers.resize(bufferCount);
+	m_isStepNeeded.assign(m_steps.size(), 0);
+	m_isSourceNeeded.reset(new bool[flagCount > 0? flagCount: 1]);
+	m_sourceValues.assign(flagCount, nullptr);
+	PlanDependencies();
+}
+
+void RasterExecutor::PlanDependencies()
+{
+	std::vector<std::set<int>> dependencies(m_steps.size());
+
+	// The steps that have used each buffer since it was last assigned: the
+	// step that wrote it and the steps that read it.  A step that is
+	// assigned a buffer must wait for all of them.
+	std::vector<std::vector<int>> bufferUsers(m_buffers.size());
+
+	// The last step evaluated by its own GetValues() method whose subgraph
+	// contains each Noise module with source modules.
+	std::map<const Module*, int> lastCaller;
+
+	for (int i = 0; i < (int)m_steps.size(); i++)
+	{
+		Step& step = m_steps[i];
+		if (step.buffer >= 0)
+		{
+			for (int user : bufferUsers[step.buffer])
+			{
+				dependencies[i].insert(user);
+			}
+			bufferUsers[step.buffer].assign(1, i);
+		}
+		for (int source : step.sources)
+		{
+			dependencies[i].insert(source);
+			if (m_steps[source].buffer >= 0)
+			{
+				bufferUsers[m_steps[source].buffer].push_back(i);
+			}
+		}
+
+		// Serialize the steps whose subgraphs share a Noise module that may
+		// hold state.
+		if (step.sources.empty() && step.pModule->GetSourceModuleCount() > 0)
+		{
+			std::set<const Module*> visited;
+			std::vector<const Module*> pending(1, step.pModule);
+			while (!pending.empty())
+			{
+				const Module* pModule = pending.back();
+				pending.pop_back();
+				if (pModule->GetSourceModuleCount() == 0
+					|| !visited.insert(pModule).second)
+				{
+					continue;
+				}
+				auto found = lastCaller.find(pModule);
+				if (found != lastCaller.end())
+				{
+					dependencies[i].insert(found->second);
+				}
+				lastCaller[pModule] = i;
+				for (int j = 0; j < pModule->GetSourceModuleCount(); j++)
+				{
+					pending.push_back(&pModule->GetSourceModule(j));
+				}
+			}
+		}
+	}
+
+	for (int i = 0; i < (int)m_steps.size(); i++)
+	{
+		dependencies[i].erase(i);
+		m_steps[i].dependencyCount = (int)dependencies[i].size();
+		for (int dependency : dependencies[i])
+		{
+			m_steps[dependency].dependents.push_back(i);
+		}
+	}
+}
+
+void RasterExecutor::RunStep(int index, int count, const double* x,
+	const double* y, const double* z, double* const* out)
+{
+	const Step& step = m_steps[index];
+	if (!m_isStepNeeded[index])
+	{
+		return;
+	}
+	double* dest = (step.output >= 0)
+		? out[step.output]: m_buffers[step.buffer].data();
+	if (step.sources.empty())
+	{
+		step.pModule->GetValues(count, x, y, z, dest);
+		return;
+	}
+
+	// Each step has its own slice of source pointers, so that steps running
+	// on different threads do not share them.
+	const bool* isSourceNeeded = &m_isSourceNeeded[step.firstFlag];
+	const double** sourceValues = &m_sourceValues[step.firstFlag];
+	for (int j = 0; j < (int)step.sources.size(); j++)
+	{
+		const Step& source = m_steps[step.sources[j]];
+		if (!isSourceNeeded[j])
+		{
+			sourceValues[j] = nullptr;
+		}
+		else if (source.output >= 0)
+		{
+			sourceValues[j] = out[source.output];
+		}
+		else
+		{
+			sourceValues[j] = m_buffers[source.buffer].data();
+		}
+	}
+	step.pModule->CombineValues(count, sourceValues, dest);
+}
+
+void RasterExecutor::SetModule(const Module& root)
+{
+	SetModules(std::vector<const Module*>(1, &root));
+}
+
+void RasterExecutor::SetModules(const std::vector<const Module*>& roots)
+{
+	if (roots.empty())
+	{
+		throw noise::ExceptionInvalidParam();
+	}
+
+	m_roots = roots;
+	Plan();
+}
+
+void RasterExecutor::SetThreadCount(int threadCount)
+{
+	if (threadCount < 1)
+	{
+		throw noise::ExceptionInvalidParam();
+	}
+
+	m_pWorkers.reset();
+	m_threadCount = threadCount;
+	if (threadCount > 1)
+	{
+		m_pWorkers.reset(new WorkerPool(*this, threadCount));
+	}
+
+	// The assignment of buffers depends on the number of threads.
+	if (!m_roots.empty())
+	{
+		Plan();
+	}
+}
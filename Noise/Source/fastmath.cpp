@@ -0,0 +1,134 @@
+// fastmath.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#include "noise/fastmath.h"
+
+using namespace noise;
+
+namespace
+{
+
+	// Number of values that the batch functions approximate before checking
+	// their domains.
+	const int FAST_MATH_CHUNK_SIZE = 64;
+
+}
+
+void noise::MathPow (int count, const double* base, double exponent,
+	double* out)
+{
+#ifdef NOISE_FAST_MATH
+	for (int first = 0; first < count; first += FAST_MATH_CHUNK_SIZE) {
+		int chunkSize = count - first;
+		if (chunkSize > FAST_MATH_CHUNK_SIZE) {
+			chunkSize = FAST_MATH_CHUNK_SIZE;
+		}
+
+		// Approximate every power without branches.  Values outside of the
+		// domain produce meaningless approximations; the argument to
+		// FastExp() is clamped so that its conversions remain defined.
+		double y[FAST_MATH_CHUNK_SIZE];
+		double value[FAST_MATH_CHUNK_SIZE];
+		for (int i = 0; i < chunkSize; i++) {
+			double n = exponent * FastLog (base[first + i]);
+			y[i] = n;
+			n = fmin (fmax (n, -FAST_EXP_MAX_ARGUMENT), FAST_EXP_MAX_ARGUMENT);
+			value[i] = FastExp (n);
+		}
+
+		// Recalculate the values outside of the domain with pow().
+		for (int i = 0; i < chunkSize; i++) {
+			double b = base[first + i];
+			if (b >= DBL_MIN && b < HUGE_VAL
+				&& fabs (y[i]) < FAST_EXP_MAX_ARGUMENT) {
+				out[first + i] = value[i];
+			} else {
+				out[first + i] = pow (b, exponent);
+			}
+		}
+	}
+#else
+	for (int i = 0; i < count; i++) {
+		out[i] = pow (base[i], exponent);
+	}
+#endif
+}
+
+void noise::MathPow (int count, const double* base, const double* exponent,
+	double* out)
+{
+#ifdef NOISE_FAST_MATH
+	for (int first = 0; first < count; first += FAST_MATH_CHUNK_SIZE) {
+		int chunkSize = count - first;
+		if (chunkSize > FAST_MATH_CHUNK_SIZE) {
+			chunkSize = FAST_MATH_CHUNK_SIZE;
+		}
+
+		double y[FAST_MATH_CHUNK_SIZE];
+		double value[FAST_MATH_CHUNK_SIZE];
+		for (int i = 0; i < chunkSize; i++) {
+			double n = exponent[first + i] * FastLog (base[first + i]);
+			y[i] = n;
+			n = fmin (fmax (n, -FAST_EXP_MAX_ARGUMENT), FAST_EXP_MAX_ARGUMENT);
+			value[i] = FastExp (n);
+		}
+
+		for (int i = 0; i < chunkSize; i++) {
+			double b = base[first + i];
+			if (b >= DBL_MIN && b < HUGE_VAL
+				&& fabs (y[i]) < FAST_EXP_MAX_ARGUMENT) {
+				out[first + i] = value[i];
+			} else {
+				out[first + i] = pow (b, exponent[first + i]);
+			}
+		}
+	}
+#else
+	for (int i = 0; i < count; i++) {
+		out[i] = pow (base[i], exponent[i]);
+	}
+#endif
+}
+
+void noise::MathSinCos (int count, const double* angle, double* sinValue,
+	double* cosValue)
+{
+#ifdef NOISE_FAST_MATH
+	// Approximate every value without branches, substituting zero for the
+	// angles outside of the domain, then recalculate those values.
+	for (int i = 0; i < count; i++) {
+		double a = (fabs (angle[i]) < FAST_SINCOS_MAX_ANGLE)? angle[i]: 0.0;
+		FastSinCos (a, sinValue[i], cosValue[i]);
+	}
+	for (int i = 0; i < count; i++) {
+		if (!(fabs (angle[i]) < FAST_SINCOS_MAX_ANGLE)) {
+			sinValue[i] = sin (angle[i]);
+			cosValue[i] = cos (angle[i]);
+		}
+	}
+#else
+	for (int i = 0; i < count; i++) {
+		sinValue[i] = sin (angle[i]);
+		cosValue[i] = cos (angle[i]);
+	}
+#endif
+}
@@ -0,0 +1,695 @@
+// graph.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <map>
+#include <set>
+#include <typeindex>
+#include <typeinfo>
+#include "noise/exception.h"
+#include "noise/graph.h"
+#include "noise/module/module.h"
+#include "noise/serialize.h"
+
+using namespace noise;
+using namespace noise::module;
+
+namespace
+{
+
+	/// Reflection functions for one class of Noise module.
+	struct ClassInfo
+	{
+
+		/// The name of the class, without its namespace.
+		const char* name;
+
+		/// The type of the class.
+		std::type_index type;
+
+		/// Creates a Noise module of this class with default parameters.
+		std::unique_ptr<Module> (*create)();
+
+		/// Appends the parameters of a Noise module of this class to a
+		/// description, in a fixed order.
+		void (*describe)(const Module& module, ModuleDescription& description);
+
+		/// Sets the parameters of a Noise module of this class.  The values
+		/// are given in the same order as the describe function lists them.
+		void (*apply)(Module& module, const double* values,
+			const std::vector<double>& controlPoints);
+
+	};
+
+	/// Converts a parameter value to an integer.
+	int ToInt(double value)
+	{
+		if (!(value >= (double)INT_MIN && value <= (double)INT_MAX)
+			|| value != std::floor(value))
+		{
+			throw noise::ExceptionInvalidParam();
+		}
+		return (int)value;
+	}
+
+	/// Converts a parameter value to a Noise quality.
+	noise::NoiseQuality ToNoiseQuality(double value)
+	{
+		int quality = ToInt(value);
+		if (quality < QUALITY_FAST || quality > QUALITY_BEST)
+		{
+			throw noise::ExceptionInvalidParam();
+		}
+		return (noise::NoiseQuality)quality;
+	}
+
+	/// Checks the bounds of a range parameter.
+	void CheckBounds(double lowerBound, double upperBound)
+	{
+		if (!(lowerBound < upperBound))
+		{
+			throw noise::ExceptionInvalidParam();
+		}
+	}
+
+	/// Appends a parameter to a description.
+	void AddParameter(ModuleDescription& description, const char* name, double value)
+	{
+		description.parameters.emplace_back(name, value);
+	}
+
+	/// Returns a Noise module as an instance of a specific class.
+	template <class T>
+	const T& As(const Module& module)
+	{
+		return static_cast<const T&>(module);
+	}
+
+	/// Returns a Noise module as an instance of a specific class.
+	template <class T>
+	T& As(Module& module)
+	{
+		return static_cast<T&>(module);
+	}
+
+	/// Creates a Noise module of a specific class with default parameters.
+	template <class T>
+	std::unique_ptr<Module> Create()
+	{
+		return std::make_unique<T>();
+	}
+
+	/// Describe function for classes without parameters.
+	void DescribeNothing(const Module&, ModuleDescription&)
+	{
+	}
+
+	/// Apply function for classes without parameters.
+	void ApplyNothing(Module&, const double*, const std::vector<double>&)
+	{
+	}
+
+	/// Describe function shared by the fractal generators.
+	template <class T>
+	void DescribeFractal(const Module& module, ModuleDescription& description)
+	{
+		const T& fractal = As<T>(module);
+		AddParameter(description, "frequency", fractal.GetFrequency());
+		AddParameter(description, "lacunarity", fractal.GetLacunarity());
+		AddParameter(description, "noiseQuality", fractal.GetNoiseQuality());
+		AddParameter(description, "octaveCount", fractal.GetOctaveCount());
+		AddParameter(description, "seed", fractal.GetSeed());
+	}
+
+	/// Apply function shared by the fractal generators.
+	template <class T>
+	void ApplyFractal(Module& module, const double* values,
+		const std::vector<double>&)
+	{
+		T& fractal = As<T>(module);
+		fractal.SetFrequency(values[0]);
+		fractal.SetLacunarity(values[1]);
+		fractal.SetNoiseQuality(ToNoiseQuality(values[2]));
+		fractal.SetOctaveCount(ToInt(values[3]));
+		fractal.SetSeed(ToInt(values[4]));
+	}
+
+	/// Describe function shared by the fractal generators with a
+	/// persistence.
+	template <class T>
+	void DescribePersistentFractal(const Module& module,
+		ModuleDescription& description)
+	{
+		DescribeFractal<T>(module, description);
+		AddParameter(description, "persistence", As<T>(module).GetPersistence());
+	}
+
+	/// Apply function shared by the fractal generators with a persistence.
+	template <class T>
+	void ApplyPersistentFractal(Module& module, const double* values,
+		const std::vector<double>& controlPoints)
+	{
+		ApplyFractal<T>(module, values, controlPoints);
+		As<T>(module).SetPersistence(values[5]);
+	}
+
+	/// Returns the reflection functions of every class of Noise module.
+	const std::vector<ClassInfo>& GetClasses()
+	{
+		static const std::vector<ClassInfo> classes = {
+			{"Abs", typeid(Abs), Create<Abs>, DescribeNothing, ApplyNothing},
+			{"Add", typeid(Add), Create<Add>, DescribeNothing, ApplyNothing},
+			{"Billow", typeid(Billow), Create<Billow>,
+				DescribePersistentFractal<Billow>,
+				ApplyPersistentFractal<Billow>},
+			{"Blend", typeid(Blend), Create<Blend>, DescribeNothing,
+				ApplyNothing},
+			{"Cache", typeid(Cache), Create<Cache>, DescribeNothing,
+				ApplyNothing},
+			{"Checkerboard", typeid(Checkerboard), Create<Checkerboard>,
+				DescribeNothing, ApplyNothing},
+			{"Clamp", typeid(Clamp), Create<Clamp>,
+				[](const Module& module, ModuleDescription& description) {
+					const Clamp& clamp = As<Clamp>(module);
+					AddParameter(description, "lowerBound", clamp.GetLowerBound());
+					AddParameter(description, "upperBound", clamp.GetUpperBound());
+				},
+				[](Module& module, const double* values,
+					const std::vector<double>&) {
+					CheckBounds(values[0], values[1]);
+					As<Clamp>(module).SetBounds(values[0], values[1]);
+				}},
+			{"Const", typeid(Const), Create<Const>,
+				[](const Module& module, ModuleDescription& description) {
+					AddParameter(description, "constValue",
+						As<Const>(module).GetConstValue());
+				},
+				[](Module& module, const double* values,
+					const std::vector<double>&) {
+					As<Const>(module).SetConstValue(values[0]);
+				}},
+			{"Curve", typeid(Curve), Create<Curve>,
+				[](const Module& module, ModuleDescription& description) {
+					const Curve& curve = As<Curve>(module);
+					const ControlPoint* pPoints = curve.GetControlPointArray();
+					for (int i = 0; i < curve.GetControlPointCount(); i++)
+					{
+						description.controlPoints.push_back(pPoints[i].inputValue);
+						description.controlPoints.push_back(pPoints[i].outputValue);
+					}
+				},
+				[](Module& module, const double*,
+					const std::vector<double>& controlPoints) {
+					if (controlPoints.size() % 2 != 0)
+					{
+						throw noise::ExceptionInvalidParam();
+					}
+					Curve& curve = As<Curve>(module);
+					for (size_t i = 0; i < controlPoints.size(); i += 2)
+					{
+						curve.AddControlPoint(controlPoints[i], controlPoints[i + 1]);
+					}
+				}},
+			{"Cylinders", typeid(Cylinders), Create<Cylinders>,
+				[](const Module& module, ModuleDescription& description) {
+					AddParameter(description, "frequency",
+						As<Cylinders>(module).GetFrequency());
+				},
+				[](Module& module, const double* values,
+					const std::vector<double>&) {
+					As<Cylinders>(module).SetFrequency(values[0]);
+				}},
+			{"Displace", typeid(Displace), Create<Displace>, DescribeNothing,
+				ApplyNothing},
+			{"Exponent", typeid(Exponent), Create<Exponent>,
+				[](const Module& module, ModuleDescription& description) {
+					AddParameter(description, "exponent",
+						As<Exponent>(module).GetExponent());
+				},
+				[](Module& module, const double* values,
+					const std::vector<double>&) {
+					As<Exponent>(module).SetExponent(values[0]);
+				}},
+			{"HashCache", typeid(HashCache), Create<HashCache>,
+				[](const Module& module, ModuleDescription& description) {
+					const HashCache& hashCache = As<HashCache>(module);
+					AddParameter(description, "capacity", hashCache.GetCapacity());
+					AddParameter(description, "quantum", hashCache.GetQuantum());
+				},
+				[](Module& module, const double* values,
+					const std::vector<double>&) {
+					HashCache& hashCache = As<HashCache>(module);
+					hashCache.SetCapacity(ToInt(values[0]));
+					hashCache.SetQuantum(values[1]);
+				}},
+			{"Invert", typeid(Invert), Create<Invert>, DescribeNothing,
+				ApplyNothing},
+			{"Max", typeid(Max), Create<Max>, DescribeNothing, ApplyNothing},
+			{"Min", typeid(Min), Create<Min>, DescribeNothing, ApplyNothing},
+			{"Multiply", typeid(Multiply), Create<Multiply>, DescribeNothing,
+				ApplyNothing},
+			{"Perlin", typeid(Perlin), Create<Perlin>,
+				DescribePersistentFractal<Perlin>,
+				ApplyPersistentFractal<Perlin>},
+			{"Power", typeid(Power), Create<Power>, DescribeNothing,
+				ApplyNothing},
+			{"RidgedMulti", typeid(RidgedMulti), Create<RidgedMulti>,
+				DescribeFractal<RidgedMulti>, ApplyFractal<RidgedMulti>},
+			{"RotatePoint", typeid(RotatePoint), Create<RotatePoint>,
+				[](const Module& module, ModuleDescription& description) {
+					const RotatePoint& rotate = As<RotatePoint>(module);
+					AddParameter(description, "xAngle", rotate.GetXAngle());
+					AddParameter(description, "yAngle", rotate.GetYAngle());
+					AddParameter(description, "zAngle", rotate.GetZAngle());
+				},
+				[](Module& module, const double* values,
+					const std::vector<double>&) {
+					As<RotatePoint>(module).SetAngles(values[0], values[1],
+						values[2]);
+				}},
+			{"ScaleBias", typeid(ScaleBias), Create<ScaleBias>,
+				[](const Module& module, ModuleDescription& description) {
+					const ScaleBias& scaleBias = As<ScaleBias>(module);
+					AddParameter(description, "scale", scaleBias.GetScale());
+					AddParameter(description, "bias", scaleBias.GetBias());
+				},
+				[](Module& module, const double* values,
+					const std::vector<double>&) {
+					ScaleBias& scaleBias = As<ScaleBias>(module);
+					scaleBias.SetScale(values[0]);
+					scaleBias.SetBias(values[1]);
+				}},
+			{"ScalePoint", typeid(ScalePoint), Create<ScalePoint>,
+				[](const Module& module, ModuleDescription& description) {
+					const ScalePoint& scale = As<ScalePoint>(module);
+					AddParameter(description, "xScale", scale.GetXScale());
+					AddParameter(description, "yScale", scale.GetYScale());
+					AddParameter(description, "zScale", scale.GetZScale());
+				},
+				[](Module& module, const double* values,
+					const std::vector<double>&) {
+					As<ScalePoint>(module).SetScale(values[0], values[1],
+						values[2]);
+				}},
+			{"Select", typeid(Select), Create<Select>,
+				[](const Module& module, ModuleDescription& description) {
+					const Select& select = As<Select>(module);
+					AddParameter(description, "lowerBound", select.GetLowerBound());
+					AddParameter(description, "upperBound", select.GetUpperBound());
+					AddParameter(description, "edgeFalloff", select.GetEdgeFalloff());
+				},
+				[](Module& module, const double* values,
+					const std::vector<double>&) {
+					CheckBounds(values[0], values[1]);
+					Select& select = As<Select>(module);
+					select.SetBounds(values[0], values[1]);
+					select.SetEdgeFalloff(values[2]);
+				}},
+			{"Spheres", typeid(Spheres), Create<Spheres>,
+				[](const Module& module, ModuleDescription& description) {
+					AddParameter(description, "frequency",
+						As<Spheres>(module).GetFrequency());
+				},
+				[](Module& module, const double* values,
+					const std::vector<double>&) {
+					As<Spheres>(module).SetFrequency(values[0]);
+				}},
+			{"Terrace", typeid(Terrace), Create<Terrace>,
+				[](const Module& module, ModuleDescription& description) {
+					const Terrace& terrace = As<Terrace>(module);
+					AddParameter(description, "invertTerraces",
+						terrace.IsTerracesInverted());
+					const double* pPoints = terrace.GetControlPointArray();
+					description.controlPoints.assign(pPoints,
+						pPoints + terrace.GetControlPointCount());
+				},
+				[](Module& module, const double* values,
+					const std::vector<double>& controlPoints) {
+					Terrace& terrace = As<Terrace>(module);
+					terrace.InvertTerraces(values[0] != 0.0);
+					for (double point : controlPoints)
+					{
+						terrace.AddControlPoint(point);
+					}
+				}},
+			{"TransformPoint", typeid(TransformPoint), Create<TransformPoint>,
+				[](const Module& module, ModuleDescription& description) {
+					static const char* const names[12] = {
+						"m0", "m1", "m2", "m3", "m4", "m5",
+						"m6", "m7", "m8", "m9", "m10", "m11"};
+					double matrix[12];
+					As<TransformPoint>(module).GetMatrix(matrix);
+					for (int i = 0; i < 12; i++)
+					{
+						AddParameter(description, names[i], matrix[i]);
+					}
+				},
+				[](Module& module, const double* values,
+					const std::vector<double>&) {
+					As<TransformPoint>(module).SetMatrix(values);
+				}},
+			{"TranslatePoint", typeid(TranslatePoint), Create<TranslatePoint>,
+				[](const Module& module, ModuleDescription& description) {
+					const TranslatePoint& translate = As<TranslatePoint>(module);
+					AddParameter(description, "xTranslation", translate.GetXTranslation());
+					AddParameter(description, "yTranslation", translate.GetYTranslation());
+					AddParameter(description, "zTranslation", translate.GetZTranslation());
+				},
+				[](Module& module, const double* values,
+					const std::vector<double>&) {
+					As<TranslatePoint>(module).SetTranslation(values[0],
+						values[1], values[2]);
+				}},
+			{"Turbulence", typeid(Turbulence), Create<Turbulence>,
+				[](const Module& module, ModuleDescription& description) {
+					const Turbulence& turbulence = As<Turbulence>(module);
+					AddParameter(description, "frequency", turbulence.GetFrequency());
+					AddParameter(description, "power", turbulence.GetPower());
+					AddParameter(description, "roughness", turbulence.GetRoughnessCount());
+					AddParameter(description, "seed", turbulence.GetSeed());
+				},
+				[](Module& module, const double* values,
+					const std::vector<double>&) {
+					Turbulence& turbulence = As<Turbulence>(module);
+					turbulence.SetFrequency(values[0]);
+					turbulence.SetPower(values[1]);
+					turbulence.SetRoughness(ToInt(values[2]));
+					turbulence.SetSeed(ToInt(values[3]));
+				}},
+			{"Voronoi", typeid(Voronoi), Create<Voronoi>,
+				[](const Module& module, ModuleDescription& description) {
+					const Voronoi& voronoi = As<Voronoi>(module);
+					AddParameter(description, "displacement", voronoi.GetDisplacement());
+					AddParameter(description, "enableDistance", voronoi.IsDistanceEnabled());
+					AddParameter(description, "frequency", voronoi.GetFrequency());
+					AddParameter(description, "seed", voronoi.GetSeed());
+				},
+				[](Module& module, const double* values,
+					const std::vector<double>&) {
+					Voronoi& voronoi = As<Voronoi>(module);
+					voronoi.SetDisplacement(values[0]);
+					voronoi.EnableDistance(values[1] != 0.0);
+					voronoi.SetFrequency(values[2]);
+					voronoi.SetSeed(ToInt(values[3]));
+				}}};
+		return classes;
+	}
+
+	/// Returns the reflection functions of the class of a Noise module.
+	///
+	/// @returns A pointer to the functions, or @a nullptr if the class is
+	/// not part of libnoise.  Classes derived from a libnoise class are
+	/// not part of libnoise, since they may have parameters of their own.
+	const ClassInfo* FindClass(const Module& module)
+	{
+		std::type_index type = typeid(module);
+		for (const ClassInfo& info : GetClasses())
+		{
+			if (info.type == type)
+			{
+				return &info;
+			}
+		}
+		return nullptr;
+	}
+
+}
+
+int noise::CountModules(const Module& root)
+{
+	std::set<const Module*> visited;
+	std::vector<const Module*> pending(1, &root);
+	while (!pending.empty())
+	{
+		const Module* pModule = pending.back();
+		pending.pop_back();
+		if (!visited.insert(pModule).second)
+		{
+			continue;
+		}
+		for (int i = 0; i < pModule->GetSourceModuleCount(); i++)
+		{
+			pending.push_back(&pModule->GetSourceModule(i));
+		}
+	}
+	return (int)visited.size();
+}
+
+std::unique_ptr<Module> noise::CopyModule(const Module& original)
+{
+	ModuleDescription description;
+	if (!DescribeModule(original, description))
+	{
+		return nullptr;
+	}
+	return CreateModule(description);
+}
+
+std::unique_ptr<Module> noise::CreateModule(
+	const ModuleDescription& description)
+{
+	const ClassInfo* pInfo = nullptr;
+	for (const ClassInfo& info : GetClasses())
+	{
+		if (description.className == info.name)
+		{
+			pInfo = &info;
+			break;
+		}
+	}
+	if (pInfo == nullptr)
+	{
+		throw noise::ExceptionInvalidParam();
+	}
+
+	// Start from the default parameters of the class, then replace the ones
+	// given by the description.
+	std::unique_ptr<Module> pModule = pInfo->create();
+	ModuleDescription defaults;
+	pInfo->describe(*pModule, defaults);
+	std::vector<double> values(defaults.parameters.size());
+	for (size_t i = 0; i < values.size(); i++)
+	{
+		values[i] = defaults.parameters[i].second;
+	}
+	for (const auto& parameter : description.parameters)
+	{
+		size_t i = 0;
+		while (i < values.size() && defaults.parameters[i].first != parameter.first)
+		{
+			i++;
+		}
+		if (i == values.size())
+		{
+			throw noise::ExceptionInvalidParam();
+		}
+		values[i] = parameter.second;
+	}
+	if (!description.controlPoints.empty() && pInfo->type != typeid(Curve)
+		&& pInfo->type != typeid(Terrace))
+	{
+		throw noise::ExceptionInvalidParam();
+	}
+
+	pInfo->apply(*pModule, values.data(), description.controlPoints);
+	return pModule;
+}
+
+bool noise::DescribeModule(const Module& module,
+	ModuleDescription& description)
+{
+	const ClassInfo* pInfo = FindClass(module);
+	if (pInfo == nullptr)
+	{
+		return false;
+	}
+
+	description.className = pInfo->name;
+	description.parameters.clear();
+	description.controlPoints.clear();
+	pInfo->describe(module, description);
+	return true;
+}
+
+std::uint64_t noise::GetGraphVersion(const Module& root)
+{
+	std::uint64_t version = 0;
+	std::set<const Module*> visited;
+	std::vector<const Module*> pending(1, &root);
+	while (!pending.empty())
+	{
+		const Module* pModule = pending.back();
+		pending.pop_back();
+		if (!visited.insert(pModule).second)
+		{
+			continue;
+		}
+		version = std::max(version, pModule->GetVersion());
+		for (int i = 0; i < pModule->GetSourceModuleCount(); i++)
+		{
+			pending.push_back(&pModule->GetSourceModule(i));
+		}
+	}
+	return version;
+}
+
+std::string noise::GetModuleClassName(const Module& module)
+{
+	const ClassInfo* pInfo = FindClass(module);
+	if (pInfo == nullptr)
+	{
+		return typeid(module).name();
+	}
+	return pInfo->name;
+}
+
+std::unique_ptr<ModuleGraph> noise::LimitGraphDetail(const Module& root,
+	double maxFrequency)
+{
+	if (!(maxFrequency > 0.0))
+	{
+		throw noise::ExceptionInvalidParam();
+	}
+
+	// Order the Noise modules so that every Noise module comes after its
+	// source modules, as a Noise::ModuleGraph object stores them.
+	std::vector<const Module*> modules;
+	std::map<const Module*, int> indices;
+	std::vector<std::pair<const Module*, int>> pending(1,
+		std::make_pair(&root, 0));
+	indices[&root] = -1;
+	while (!pending.empty())
+	{
+		const Module* pModule = pending.back().first;
+		int source = pending.back().second;
+		if (source == pModule->GetSourceModuleCount())
+		{
+			pending.pop_back();
+			indices[pModule] = (int)modules.size();
+			modules.push_back(pModule);
+			continue;
+		}
+		++pending.back().second;
+		const Module* pSource = &pModule->GetSourceModule(source);
+		if (indices.insert(std::make_pair(pSource, -1)).second)
+		{
+			pending.push_back(std::make_pair(pSource, 0));
+		}
+	}
+
+	// Propagate the largest scale applied to the input coordinates from
+	// the root down to every Noise module.
+	std::vector<double> scales(modules.size(), 0.0);
+	scales.back() = 1.0;
+	for (int i = (int)modules.size() - 1; i >= 0; i--)
+	{
+		const Module& module = *modules[i];
+		double scale = scales[i];
+		if (const ScalePoint* pScale = dynamic_cast<const ScalePoint*>(&module))
+		{
+			scale *= std::max({std::fabs(pScale->GetXScale()),
+				std::fabs(pScale->GetYScale()), std::fabs(pScale->GetZScale())});
+		}
+		else if (const TransformPoint* pTransform =
+			dynamic_cast<const TransformPoint*>(&module))
+		{
+			// The largest absolute row sum of the linear part bounds the
+			// stretch of the transformation.
+			double matrix[12];
+			pTransform->GetMatrix(matrix);
+			double rowSum = 0.0;
+			for (int row = 0; row < 3; row++)
+			{
+				rowSum = std::max(rowSum, std::fabs(matrix[row * 4])
+					+ std::fabs(matrix[row * 4 + 1])
+					+ std::fabs(matrix[row * 4 + 2]));
+			}
+			scale *= rowSum;
+		}
+		for (int j = 0; j < module.GetSourceModuleCount(); j++)
+		{
+			int source = indices[&module.GetSourceModule(j)];
+			scales[source] = std::max(scales[source], scale);
+		}
+	}
+
+	// Returns the number of octaves, starting at a frequency and growing by
+	// the lacunarity, that do not exceed the maximum frequency.
+	auto limitOctaves = [&](int octaveCount, double frequency,
+		double lacunarity) {
+		int limitedCount = 1;
+		while (limitedCount < octaveCount && lacunarity > 1.0
+			&& frequency * lacunarity <= maxFrequency)
+		{
+			frequency *= lacunarity;
+			++limitedCount;
+		}
+		return lacunarity > 1.0? limitedCount: octaveCount;
+	};
+
+	std::vector<std::unique_ptr<Module>> copies;
+	for (size_t i = 0; i < modules.size(); i++)
+	{
+		const Module& module = *modules[i];
+		std::unique_ptr<Module> pCopy = CopyModule(module);
+		if (pCopy == nullptr)
+		{
+			throw noise::ExceptionInvalidParam();
+		}
+
+		double scale = scales[i];
+		if (Perlin* pPerlin = dynamic_cast<Perlin*>(pCopy.get()))
+		{
+			pPerlin->SetOctaveCount(limitOctaves(pPerlin->GetOctaveCount(),
+				pPerlin->GetFrequency() * scale, pPerlin->GetLacunarity()));
+		}
+		else if (Billow* pBillow = dynamic_cast<Billow*>(pCopy.get()))
+		{
+			pBillow->SetOctaveCount(limitOctaves(pBillow->GetOctaveCount(),
+				pBillow->GetFrequency() * scale, pBillow->GetLacunarity()));
+		}
+		else if (RidgedMulti* pRidged = dynamic_cast<RidgedMulti*>(pCopy.get()))
+		{
+			pRidged->SetOctaveCount(limitOctaves(pRidged->GetOctaveCount(),
+				pRidged->GetFrequency() * scale, pRidged->GetLacunarity()));
+		}
+		else if (Turbulence* pTurbulence =
+			dynamic_cast<Turbulence*>(pCopy.get()))
+		{
+			pTurbulence->SetRoughness(limitOctaves(
+				pTurbulence->GetRoughnessCount(),
+				pTurbulence->GetFrequency() * scale,
+				DEFAULT_PERLIN_LACUNARITY));
+		}
+
+		for (int j = 0; j < module.GetSourceModuleCount(); j++)
+		{
+			pCopy->SetSourceModule(j,
+				*copies[indices[&module.GetSourceModule(j)]]);
+		}
+		copies.push_back(std::move(pCopy));
+	}
+	return std::make_unique<ModuleGraph>(std::move(copies));
+}
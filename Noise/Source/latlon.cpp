@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include "noise/fastmath.h"
 #include "noise/latlon.h"
 
 using namespace noise;
@@ -27,8 +28,11 @@ using namespace noise;
 void noise::LatLonToXYZ (double lat, double lon, double& x, double& y,
   double& z)
 {
-  double r = cos (DEG_TO_RAD * lat);
-  x = r * cos (DEG_TO_RAD * lon);
-  y =     sin (DEG_TO_RAD * lat);
-  z = r * sin (DEG_TO_RAD * lon);
+  double sinLat, cosLat, sinLon, cosLon;
+  MathSinCos (DEG_TO_RAD * lat, sinLat, cosLat);
+  MathSinCos (DEG_TO_RAD * lon, sinLon, cosLon);
+  double r = cosLat;
+  x = r * cosLon;
+  y =     sinLat;
+  z = r * sinLon;
 }
@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include "noise/fastmath.h"
 #include "noise/mathconsts.h"
 #include "noise/model/cylinder.h"
 
@@ -40,8 +41,7 @@ double Cylinder::GetValue (double angle, double height) const
   assert (m_pModule != NULL);
 
   double x, y, z;
-  x = cos (angle * DEG_TO_RAD);
+  MathSinCos (angle * DEG_TO_RAD, z, x);
   y = height;
-  z = sin (angle * DEG_TO_RAD);
   return m_pModule->GetValue (x, y, z);
 }
@@ -17,6 +17,7 @@
 // Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 //
 
+#include "noise/misc.h"
 #include "noise/model/line.h"
 
 using namespace noise;
@@ -63,3 +64,72 @@ double Line::GetValue (double p) const
     return value;
   }
 }
+
+bool Line::FindIntersection (double startHeight, double endHeight, double& p,
+  double tolerance) const
+{
+  assert (m_pModule != NULL);
+  if (tolerance <= 0.0) {
+    throw noise::ExceptionInvalidParam ();
+  }
+
+  // The gap between the height and the output value changes no faster than
+  // this bound, so it cannot close within a step of gap / bound.
+  double slope = endHeight - startHeight;
+  double bound = GetLipschitzBound () + fabs (slope);
+
+  double cur = 0.0;
+  double gap = startHeight - GetValue (cur);
+  if (gap <= 0.0) {
+    p = cur;
+    return true;
+  }
+  while (cur < 1.0) {
+    double step = gap / bound;
+    bool isClamped = !(step > tolerance);
+    if (isClamped) {
+      step = tolerance;
+    }
+    double next = GetMin (cur + step, 1.0);
+    double nextGap = startHeight + slope * next - GetValue (next);
+    if (nextGap <= 0.0) {
+      if (isClamped) {
+        // The intersection lies somewhere within the last step; estimate
+        // its position by interpolating the gaps at either end.
+        p = cur + (next - cur) * (gap / (gap - nextGap));
+      } else {
+        p = next;
+      }
+      return true;
+    }
+    cur = next;
+    gap = nextGap;
+  }
+  return false;
+}
+
+double Line::GetLipschitzBound () const
+{
+  assert (m_pModule != NULL);
+
+  double dx = m_x1 - m_x0;
+  double dy = m_y1 - m_y0;
+  double dz = m_z1 - m_z0;
+  double length = sqrt (dx * dx + dy * dy + dz * dz);
+  double bound = 0.0;
+  if (length > 0.0) {
+    bound = m_pModule->GetLipschitzBound () * length;
+  }
+
+  // The derivative of p * (1 - p) * 4 * value is (1 - 2 * p) * 4 * value
+  // plus p * (1 - p) * 4 times the derivative of the value; both factors are
+  // at most 1.0 in magnitude between the ends of the line segment.
+  if (m_attenuate) {
+    double x[2] = {m_x0, m_x1};
+    double y[2] = {m_y0, m_y1};
+    double z[2] = {m_z0, m_z1};
+    Interval range = m_pModule->GetValueRange (MakeBoundingBox (2, x, y, z));
+    bound += 4.0 * IntervalAbs (range).upper;
+  }
+  return bound;
+}
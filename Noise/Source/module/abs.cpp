@@ -29,9 +29,41 @@ Abs::Abs ():
 {
 }
 
+void Abs::CombineValues (int count, const double* const* sourceValues,
+  double* out) const
+{
+  const double* v0 = sourceValues[0];
+  for (int i = 0; i < count; i++) {
+    out[i] = fabs (v0[i]);
+  }
+}
+
 double Abs::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
 
   return fabs (m_pSourceModule[0]->GetValue (x, y, z));
 }
+
+double Abs::GetLipschitzBound () const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  return m_pSourceModule[0]->GetLipschitzBound ();
+}
+
+noise::Interval Abs::GetValueRange (const Box& box) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  return IntervalAbs (m_pSourceModule[0]->GetValueRange (box));
+}
+
+void Abs::GetValues (int count, const double* x, const double* y,
+  const double* z, double* out) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  m_pSourceModule[0]->GetValues (count, x, y, z, out);
+  CombineValues (count, &out, out);
+}
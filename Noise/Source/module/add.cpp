@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include <vector>
 #include "noise/module/add.h"
 
 using namespace noise::module;
@@ -29,6 +30,16 @@ Add::Add ():
 {
 }
 
+void Add::CombineValues (int count, const double* const* sourceValues,
+  double* out) const
+{
+  const double* v0 = sourceValues[0];
+  const double* v1 = sourceValues[1];
+  for (int i = 0; i < count; i++) {
+    out[i] = v0[i] + v1[i];
+  }
+}
+
 double Add::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
@@ -37,3 +48,34 @@ double Add::GetValue (double x, double y, double z) const
   return m_pSourceModule[0]->GetValue (x, y, z)
        + m_pSourceModule[1]->GetValue (x, y, z);
 }
+
+double Add::GetLipschitzBound () const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+
+  return m_pSourceModule[0]->GetLipschitzBound ()
+    + m_pSourceModule[1]->GetLipschitzBound ();
+}
+
+noise::Interval Add::GetValueRange (const Box& box) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+
+  return IntervalAdd (m_pSourceModule[0]->GetValueRange (box),
+    m_pSourceModule[1]->GetValueRange (box));
+}
+
+void Add::GetValues (int count, const double* x, const double* y,
+  const double* z, double* out) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+
+  std::vector<double> v1 (count);
+  m_pSourceModule[0]->GetValues (count, x, y, z, out);
+  m_pSourceModule[1]->GetValues (count, x, y, z, v1.data ());
+  const double* sourceValues[2] = {out, v1.data ()};
+  CombineValues (count, sourceValues, out);
+}
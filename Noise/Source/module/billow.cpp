@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include "noise/misc.h"
 #include "noise/module/billow.h"
 
 using namespace noise::module;
@@ -72,3 +73,36 @@ double Billow::GetValue (double x, double y, double z) const
 
   return value;
 }
+
+double Billow::GetLipschitzBound () const
+{
+  // Each octave adds twice the absolute value of a coherent-Noise value
+  // sampled at the frequency of that octave and scaled by its persistence.
+  double bound = 0.0;
+  double frequency = fabs (m_frequency);
+  double curPersistence = 1.0;
+  for (int curOctave = 0; curOctave < m_octaveCount; curOctave++) {
+    bound += 2.0 * frequency * fabs (curPersistence);
+    frequency *= fabs (m_lacunarity);
+    curPersistence *= m_persistence;
+  }
+  return bound * GradientCoherentNoiseLipschitzBound (m_noiseQuality);
+}
+
+noise::Interval Billow::GetValueRange (const Box& box) const
+{
+  // Each octave adds a signal ranging from -1.0 to (2.0 * bound - 1.0),
+  // scaled by the persistence of that octave.
+  Interval signal = {-1.0, 2.0 * GRADIENT_COHERENT_NOISE_BOUND - 1.0};
+  Interval value = {0.0, 0.0};
+  double frequency = fabs (m_frequency);
+  double scale = 0.0;
+  double curPersistence = 1.0;
+  for (int curOctave = 0; curOctave < m_octaveCount; curOctave++) {
+    value = IntervalAdd (value, IntervalMultiply (signal, curPersistence));
+    scale = GetMax (scale, frequency);
+    frequency *= fabs (m_lacunarity);
+    curPersistence *= m_persistence;
+  }
+  return GetLocalValueRange (box, IntervalAdd (value, 0.5), scale);
+}
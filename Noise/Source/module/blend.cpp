@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include <vector>
 #include "noise/module/blend.h"
 #include "noise/interp.h"
 
@@ -30,6 +31,18 @@ Blend::Blend ():
 {
 }
 
+void Blend::CombineValues (int count, const double* const* sourceValues,
+  double* out) const
+{
+  const double* v0 = sourceValues[0];
+  const double* v1 = sourceValues[1];
+  const double* control = sourceValues[2];
+  for (int i = 0; i < count; i++) {
+    double alpha = (control[i] + 1.0) / 2.0;
+    out[i] = LinearInterp (v0[i], v1[i], alpha);
+  }
+}
+
 double Blend::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
@@ -41,3 +54,85 @@ double Blend::GetValue (double x, double y, double z) const
   double alpha = (m_pSourceModule[2]->GetValue (x, y, z) + 1.0) / 2.0;
   return LinearInterp (v0, v1, alpha);
 }
+
+double Blend::GetLipschitzBound () const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+  assert (m_pSourceModule[2] != NULL);
+
+  // The gradient of v0 + (v1 - v0) * alpha is the sum of the gradients of
+  // the source modules weighted by (1 - alpha) and alpha, plus the gradient
+  // of the control module scaled by half the difference between the source
+  // values.
+  Box box = UnboundedBox ();
+  Interval v0 = m_pSourceModule[0]->GetValueRange (box);
+  Interval v1 = m_pSourceModule[1]->GetValueRange (box);
+  Interval control = m_pSourceModule[2]->GetValueRange (box);
+  Interval alpha = IntervalMultiply (IntervalAdd (control, 1.0), 0.5);
+  Interval beta = IntervalAdd (IntervalMultiply (alpha, -1.0), 1.0);
+  Interval difference = IntervalAdd (v1, IntervalMultiply (v0, -1.0));
+  return ScaleLipschitzBound (IntervalAbs (beta).upper,
+      m_pSourceModule[0]->GetLipschitzBound ())
+    + ScaleLipschitzBound (IntervalAbs (alpha).upper,
+      m_pSourceModule[1]->GetLipschitzBound ())
+    + ScaleLipschitzBound (0.5 * IntervalAbs (difference).upper,
+      m_pSourceModule[2]->GetLipschitzBound ());
+}
+
+noise::Interval Blend::GetValueRange (const Box& box) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+  assert (m_pSourceModule[2] != NULL);
+
+  Interval v0 = m_pSourceModule[0]->GetValueRange (box);
+  Interval v1 = m_pSourceModule[1]->GetValueRange (box);
+  Interval control = m_pSourceModule[2]->GetValueRange (box);
+  Interval alpha = IntervalMultiply (IntervalAdd (control, 1.0), 0.5);
+  if (alpha.lower >= 0.0 && alpha.upper <= 1.0) {
+    // The output value is a weighted average of the two output values from
+    // the source modules.
+    return IntervalUnion (v0, v1);
+  }
+  Interval beta = IntervalAdd (IntervalMultiply (alpha, -1.0), 1.0);
+  return IntervalAdd (IntervalMultiply (v0, beta),
+    IntervalMultiply (v1, alpha));
+}
+
+void Blend::GetValues (int count, const double* x, const double* y,
+  const double* z, double* out) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+  assert (m_pSourceModule[2] != NULL);
+
+  // Evaluate the control module first.  Where the output value from the
+  // control module is exactly -1.0 or +1.0, the output value from one of the
+  // source modules is multiplied by zero, so that source module is not
+  // evaluated for those input values.  The alpha value is not clamped, so no
+  // other output values from the control module allow this.
+  std::vector<double> control (count);
+  m_pSourceModule[2]->GetValues (count, x, y, z, control.data ());
+  std::vector<int> lanes[2];
+  lanes[0].reserve (count);
+  lanes[1].reserve (count);
+  for (int i = 0; i < count; i++) {
+    if (control[i] != 1.0) {
+      lanes[0].push_back (i);
+    }
+    if (control[i] != -1.0) {
+      lanes[1].push_back (i);
+    }
+  }
+
+  std::vector<double> sourceValues[2];
+  for (int j = 0; j < 2; j++) {
+    sourceValues[j].resize (count);
+    GetSourceValues (j, (int)lanes[j].size (), lanes[j].data (), count, x, y,
+      z, sourceValues[j].data ());
+  }
+  const double* combinedValues[3] = {sourceValues[0].data (),
+    sourceValues[1].data (), control.data ()};
+  CombineValues (count, combinedValues, out);
+}
@@ -20,26 +20,98 @@
 // off every 'zig'.)
 //
 
+#include <algorithm>
 #include "noise/module/cache.h"
 
 using namespace noise::module;
 
 Cache::Cache ():
-  Module (GetSourceModuleCount ()),
-  m_isCached (false)
+  Module (GetSourceModuleCount ())
 {
 }
 
+void Cache::CombineValues (int count, const double* const* sourceValues,
+  double* out) const
+{
+  if (out != sourceValues[0]) {
+    std::copy (sourceValues[0], sourceValues[0] + count, out);
+  }
+}
+
 double Cache::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
 
-  if (!(m_isCached && x == m_xCache && y == m_yCache && z == m_zCache)) {
-    m_cachedValue = m_pSourceModule[0]->GetValue (x, y, z);
-    m_xCache = x;
-    m_yCache = y;
-    m_zCache = z;
+  State& state = GetState ();
+  if (!(state.isCached && x == state.xCache && y == state.yCache
+    && z == state.zCache)) {
+    state.cachedValue = m_pSourceModule[0]->GetValue (x, y, z);
+    state.xCache = x;
+    state.yCache = y;
+    state.zCache = z;
+  }
+  state.isCached = true;
+  return state.cachedValue;
+}
+
+double Cache::GetLipschitzBound () const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  return m_pSourceModule[0]->GetLipschitzBound ();
+}
+
+noise::Interval Cache::GetValueRange (const Box& box) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  // A cached source module is usually shared by several Noise modules, so
+  // remember the last range to avoid walking the shared subgraph once for
+  // each of them.
+  State& state = GetState ();
+  const Box& cached = state.boxCache;
+  if (!(state.isRangeCached
+    && box.x.lower == cached.x.lower && box.x.upper == cached.x.upper
+    && box.y.lower == cached.y.lower && box.y.upper == cached.y.upper
+    && box.z.lower == cached.z.lower && box.z.upper == cached.z.upper)) {
+    state.rangeCache = m_pSourceModule[0]->GetValueRange (box);
+    state.boxCache = box;
+  }
+  state.isRangeCached = true;
+  return state.rangeCache;
+}
+
+void Cache::GetValues (int count, const double* x, const double* y,
+  const double* z, double* out) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  State& state = GetState ();
+  size_t size = (size_t)count;
+  if (!(state.isBatchCached && state.batchValues.size () == size
+    && std::equal (x, x + count, state.xBatchCache.begin ())
+    && std::equal (y, y + count, state.yBatchCache.begin ())
+    && std::equal (z, z + count, state.zBatchCache.begin ()))) {
+    state.batchValues.resize (size);
+    m_pSourceModule[0]->GetValues (count, x, y, z, state.batchValues.data ());
+    state.xBatchCache.assign (x, x + count);
+    state.yBatchCache.assign (y, y + count);
+    state.zBatchCache.assign (z, z + count);
+  }
+  state.isBatchCached = true;
+  std::copy (state.batchValues.begin (), state.batchValues.end (), out);
+}
+
+Cache::State& Cache::GetState () const
+{
+  // Connecting a source module changes the version of this Noise module,
+  // which invalidates the cache of every thread.
+  State& state = m_states.Get ();
+  if (state.version != m_version) {
+    state.version = m_version;
+    state.isCached = false;
+    state.isBatchCached = false;
+    state.isRangeCached = false;
   }
-  m_isCached = true;
-  return m_cachedValue;
+  return state;
 }
@@ -36,3 +36,26 @@ double Checkerboard::GetValue (double x, double y, double z) const
   int iz = (int)(floor (MakeInt32Range (z)));
   return (ix & 1 ^ iy & 1 ^ iz & 1)? -1.0: 1.0;
 }
+
+double Checkerboard::GetLipschitzBound () const
+{
+  // The output value jumps between -1.0 and +1.0 at the cell boundaries.
+  return HUGE_VAL;
+}
+
+noise::Interval Checkerboard::GetValueRange (const Box& box) const
+{
+  // A box within a single cell of the checkerboard has a single output
+  // value.  MakeInt32Range() leaves the coordinates of such a box unchanged
+  // as long as they are within its range.
+  const double MAX_COORDINATE = 1073741824.0;
+  const Interval* axes[3] = {&box.x, &box.y, &box.z};
+  for (const Interval* pAxis: axes) {
+    if (!(pAxis->lower > -MAX_COORDINATE && pAxis->upper < MAX_COORDINATE)
+      || floor (pAxis->lower) != floor (pAxis->upper)) {
+      return Interval {-1.0, 1.0};
+    }
+  }
+  double value = GetValue (box.x.lower, box.y.lower, box.z.lower);
+  return Interval {value, value};
+}
@@ -20,6 +20,8 @@
 // off every 'zig'.)
 //
 
+#include <algorithm>
+#include "noise/misc.h"
 #include "noise/module/clamp.h"
 
 using namespace noise::module;
@@ -31,6 +33,21 @@ Clamp::Clamp ():
 {
 }
 
+void Clamp::CombineValues (int count, const double* const* sourceValues,
+  double* out) const
+{
+  const double* v0 = sourceValues[0];
+  for (int i = 0; i < count; i++) {
+    if (v0[i] < m_lowerBound) {
+      out[i] = m_lowerBound;
+    } else if (v0[i] > m_upperBound) {
+      out[i] = m_upperBound;
+    } else {
+      out[i] = v0[i];
+    }
+  }
+}
+
 double Clamp::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
@@ -47,8 +64,51 @@ double Clamp::GetValue (double x, double y, double z) const
 
 void Clamp::SetBounds (double lowerBound, double upperBound)
 {
+  IncrementVersion ();
   assert (lowerBound < upperBound);
 
   m_lowerBound = lowerBound;
   m_upperBound = upperBound;
 }
+
+double Clamp::GetLipschitzBound () const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  return m_pSourceModule[0]->GetLipschitzBound ();
+}
+
+noise::Interval Clamp::GetValueRange (const Box& box) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  Interval range = m_pSourceModule[0]->GetValueRange (box);
+  range.lower = GetMin (GetMax (range.lower, m_lowerBound), m_upperBound);
+  range.upper = GetMin (GetMax (range.upper, m_lowerBound), m_upperBound);
+  return range;
+}
+
+void Clamp::GetValues (int count, const double* x, const double* y,
+  const double* z, double* out) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  if (count <= 0) {
+    return;
+  }
+
+  // If the output values from the source module are known to lie entirely
+  // outside of the clamping range within this batch, every output value is
+  // equal to one of the bounds and the source module does not need to be
+  // evaluated.
+  Interval range = m_pSourceModule[0]->GetValueRange (
+    MakeBoundingBox (count, x, y, z));
+  if (range.lower >= m_upperBound || range.upper <= m_lowerBound) {
+    double value = (range.lower >= m_upperBound)? m_upperBound: m_lowerBound;
+    std::fill (out, out + count, value);
+    return;
+  }
+
+  m_pSourceModule[0]->GetValues (count, x, y, z, out);
+  CombineValues (count, &out, out);
+}
@@ -29,3 +29,13 @@ Const::Const ():
   m_constValue (DEFAULT_CONST_VALUE)
 {
 }
+
+double Const::GetLipschitzBound () const
+{
+  return 0.0;
+}
+
+noise::Interval Const::GetValueRange (const Box&) const
+{
+  return Interval {m_constValue, m_constValue};
+}
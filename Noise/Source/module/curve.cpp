@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include <vector>
 #include "noise/interp.h"
 #include "noise/misc.h"
 #include "noise/module/curve.h"
@@ -40,18 +41,22 @@ Curve::~Curve ()
 
 void Curve::AddControlPoint (double inputValue, double outputValue)
 {
+  IncrementVersion ();
   // Find the insertion point for the new control point and insert the new
   // point at that position.  The control point array will remain sorted by
   // input value.
   int insertionPos = FindInsertionPos (inputValue);
   InsertAtPos (insertionPos, inputValue, outputValue);
+  UpdateSegments ();
 }
 
 void Curve::ClearAllControlPoints ()
 {
+  IncrementVersion ();
   delete[] m_pControlPoints;
   m_pControlPoints = NULL;
   m_controlPointCount = 0;
+  UpdateSegments ();
 }
 
 int Curve::FindInsertionPos (double inputValue)
@@ -71,50 +76,145 @@ int Curve::FindInsertionPos (double inputValue)
   return insertionPos;
 }
 
+void Curve::CombineValues (int count, const double* const* sourceValues,
+  double* out) const
+{
+  assert (m_controlPointCount >= 4);
+
+  // Locate the segment of every output value from the source module first,
+  // so that the polynomials are evaluated in a separate loop without
+  // branches.
+  const double* v0 = sourceValues[0];
+  std::vector<int> segments (count);
+  for (int i = 0; i < count; i++) {
+    segments[i] = m_segmentIndex.Find (v0[i]);
+  }
+
+  const Segment* pSegments = m_segments.data ();
+  int lastSegment = m_controlPointCount;
+  for (int i = 0; i < count; i++) {
+    const Segment& segment = pSegments[segments[i]];
+    double alpha = (v0[i] - segment.input0)
+      / (segment.input1 - segment.input0);
+    double value = segment.p * alpha * alpha * alpha
+      + segment.q * alpha * alpha + segment.r * alpha + segment.s;
+    bool isOutside = segments[i] == 0 || segments[i] == lastSegment;
+    out[i] = isOutside? segment.s: value;
+  }
+}
+
 double Curve::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
   assert (m_controlPointCount >= 4);
 
-  // Get the output value from the source module.
-  double sourceModuleValue = m_pSourceModule[0]->GetValue (x, y, z);
+  // Get the output value from the source module and map it onto the curve.
+  return MapValue (m_pSourceModule[0]->GetValue (x, y, z));
+}
 
-  // Find the first element in the control point array that has an input value
-  // larger than the output value from the source module.
-  int indexPos;
-  for (indexPos = 0; indexPos < m_controlPointCount; indexPos++) {
-    if (sourceModuleValue < m_pControlPoints[indexPos].inputValue) {
-      break;
+double Curve::GetLipschitzBound () const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_controlPointCount >= 4);
+
+  // The curve is flat outside of the control point array.  Within each
+  // segment, the derivative of the cubic polynomial is a quadratic in the
+  // alpha value, so its largest magnitude lies at either end of the segment
+  // or at the vertex of the quadratic.
+  double slope = 0.0;
+  for (int i = 1; i < m_controlPointCount; i++) {
+    const Segment& segment = m_segments[i];
+    double a = 3.0 * segment.p;
+    double b = 2.0 * segment.q;
+    double c = segment.r;
+    double derivative = GetMax (fabs (c), fabs (a + b + c));
+    if (a != 0.0) {
+      double vertex = -b / (2.0 * a);
+      if (vertex > 0.0 && vertex < 1.0) {
+        derivative = GetMax (derivative,
+          fabs ((a * vertex + b) * vertex + c));
+      }
     }
+    slope = GetMax (slope, derivative / (segment.input1 - segment.input0));
   }
+  return ScaleLipschitzBound (slope, m_pSourceModule[0]->GetLipschitzBound ());
+}
 
-  // Find the four nearest control points so that we can perform cubic
-  // interpolation.
-  int index0 = ClampValue (indexPos - 2, 0, m_controlPointCount - 1);
-  int index1 = ClampValue (indexPos - 1, 0, m_controlPointCount - 1);
-  int index2 = ClampValue (indexPos    , 0, m_controlPointCount - 1);
-  int index3 = ClampValue (indexPos + 1, 0, m_controlPointCount - 1);
-
-  // If some control points are missing (which occurs if the value from the
-  // source module is greater than the largest input value or less than the
-  // smallest input value of the control point array), get the corresponding
-  // output value of the nearest control point and exit now.
-  if (index1 == index2) {
-    return m_pControlPoints[index1].outputValue;
+noise::Interval Curve::GetValueRange (const Box& box) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_controlPointCount >= 4);
+
+  Interval sourceRange = m_pSourceModule[0]->GetValueRange (box);
+  const ControlPoint* pFirst = &m_pControlPoints[0];
+  const ControlPoint* pLast = &m_pControlPoints[m_controlPointCount - 1];
+
+  // Values outside of the control point array map onto the output value of
+  // the nearest control point.
+  Interval range = {HUGE_VAL, -HUGE_VAL};
+  if (sourceRange.lower < pFirst->inputValue) {
+    range = IntervalUnion (range,
+      Interval {pFirst->outputValue, pFirst->outputValue});
+  }
+  if (sourceRange.upper >= pLast->inputValue) {
+    range = IntervalUnion (range,
+      Interval {pLast->outputValue, pLast->outputValue});
   }
-  
-  // Compute the alpha value used for cubic interpolation.
-  double input0 = m_pControlPoints[index1].inputValue;
-  double input1 = m_pControlPoints[index2].inputValue;
-  double alpha = (sourceModuleValue - input0) / (input1 - input0);
-
-  // Now perform the cubic interpolation given the alpha value.
-  return CubicInterp (
-    m_pControlPoints[index0].outputValue,
-    m_pControlPoints[index1].outputValue,
-    m_pControlPoints[index2].outputValue,
-    m_pControlPoints[index3].outputValue,
-    alpha);
+
+  // Bound the cubic polynomial of each segment that overlaps the range of
+  // the source module.  Each term of the polynomial is bounded separately
+  // since the alpha value ranges from 0.0 to 1.0.
+  for (int i = 0; i < m_controlPointCount - 1; i++) {
+    if (sourceRange.upper < m_pControlPoints[i].inputValue
+      || sourceRange.lower >= m_pControlPoints[i + 1].inputValue) {
+      continue;
+    }
+    int last = m_controlPointCount - 1;
+    double n0 = m_pControlPoints[ClampValue (i - 1, 0, last)].outputValue;
+    double n1 = m_pControlPoints[i    ].outputValue;
+    double n2 = m_pControlPoints[i + 1].outputValue;
+    double n3 = m_pControlPoints[ClampValue (i + 2, 0, last)].outputValue;
+    double p = (n3 - n2) - (n0 - n1);
+    double q = (n0 - n1) - p;
+    double r = n2 - n0;
+    double s = n1;
+    range = IntervalUnion (range, Interval {
+      s + GetMin (0.0, p) + GetMin (0.0, q) + GetMin (0.0, r),
+      s + GetMax (0.0, p) + GetMax (0.0, q) + GetMax (0.0, r)});
+  }
+  return range;
+}
+
+void Curve::GetValues (int count, const double* x, const double* y,
+  const double* z, double* out) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_controlPointCount >= 4);
+
+  m_pSourceModule[0]->GetValues (count, x, y, z, out);
+  CombineValues (count, &out, out);
+}
+
+double Curve::MapValue (double sourceModuleValue) const
+{
+  // Find the segment of the curve that contains the output value from the
+  // source module.
+  int segmentPos = m_segmentIndex.Find (sourceModuleValue);
+  const Segment& segment = m_segments[segmentPos];
+
+  // If the value from the source module is less than the smallest input
+  // value or greater than the largest input value of the control point
+  // array, return the output value of the nearest control point.
+  if (segmentPos == 0 || segmentPos == m_controlPointCount) {
+    return segment.s;
+  }
+
+  // Compute the alpha value and evaluate the cubic polynomial of the
+  // segment.
+  double alpha = (sourceModuleValue - segment.input0)
+    / (segment.input1 - segment.input0);
+  return segment.p * alpha * alpha * alpha + segment.q * alpha * alpha
+    + segment.r * alpha + segment.s;
 }
 
 void Curve::InsertAtPos (int insertionPos, double inputValue,
@@ -141,3 +241,46 @@ void Curve::InsertAtPos (int insertionPos, double inputValue,
   m_pControlPoints[insertionPos].inputValue  = inputValue ;
   m_pControlPoints[insertionPos].outputValue = outputValue;
 }
+
+void Curve::UpdateSegments ()
+{
+  std::vector<double> inputValues (m_controlPointCount);
+  for (int i = 0; i < m_controlPointCount; i++) {
+    inputValues[i] = m_pControlPoints[i].inputValue;
+  }
+  m_segmentIndex.Build (inputValues.data (), m_controlPointCount);
+  m_segments.clear ();
+  if (m_controlPointCount == 0) {
+    return;
+  }
+
+  // The segment at each position lies between the control points on either
+  // side of it.  The coefficients are those that CubicInterp() calculates
+  // from the four nearest control points.
+  int last = m_controlPointCount - 1;
+  m_segments.resize (m_controlPointCount + 1);
+  for (int i = 0; i <= m_controlPointCount; i++) {
+    Segment& segment = m_segments[i];
+    if (i == 0 || i == m_controlPointCount) {
+      const ControlPoint& nearest = m_pControlPoints[ClampValue (i - 1, 0,
+        last)];
+      segment.input0 = 0.0;
+      segment.input1 = 1.0;
+      segment.p = 0.0;
+      segment.q = 0.0;
+      segment.r = 0.0;
+      segment.s = nearest.outputValue;
+      continue;
+    }
+    double n0 = m_pControlPoints[ClampValue (i - 2, 0, last)].outputValue;
+    double n1 = m_pControlPoints[i - 1].outputValue;
+    double n2 = m_pControlPoints[i    ].outputValue;
+    double n3 = m_pControlPoints[ClampValue (i + 1, 0, last)].outputValue;
+    segment.input0 = m_pControlPoints[i - 1].inputValue;
+    segment.input1 = m_pControlPoints[i    ].inputValue;
+    segment.p = (n3 - n2) - (n0 - n1);
+    segment.q = (n0 - n1) - segment.p;
+    segment.r = n2 - n0;
+    segment.s = n1;
+  }
+}
@@ -42,3 +42,18 @@ double Cylinders::GetValue (double x, double y, double z) const
   double nearestDist = GetMin (distFromSmallerSphere, distFromLargerSphere);
   return 1.0 - (nearestDist * 4.0); // Puts it in the -1.0 to +1.0 range.
 }
+
+double Cylinders::GetLipschitzBound () const
+{
+  // The distance to the nearest cylinder changes no faster than the input
+  // value, and is multiplied by the frequency and by 4.0.
+  return 4.0 * fabs (m_frequency);
+}
+
+noise::Interval Cylinders::GetValueRange (const Box& box) const
+{
+  // The output value only depends on the distance from the y axis.
+  Box scaledBox = {IntervalMultiply (box.x, m_frequency),
+    Interval {0.0, 0.0}, IntervalMultiply (box.z, m_frequency)};
+  return ShellValueRange (IntervalDistance (scaledBox));
+}
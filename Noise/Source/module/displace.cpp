@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include <vector>
 #include "noise/module/displace.h"
 
 using namespace noise::module;
@@ -46,3 +47,64 @@ double Displace::GetValue (double x, double y, double z) const
   // the original input value.
   return m_pSourceModule[0]->GetValue (xDisplace, yDisplace, zDisplace);
 }
+
+double Displace::GetLipschitzBound () const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+  assert (m_pSourceModule[2] != NULL);
+  assert (m_pSourceModule[3] != NULL);
+
+  // The displaced input value moves at most (1 + the Frobenius norm of the
+  // gradients of the displacement modules) times as fast as the input
+  // value.
+  double x = m_pSourceModule[1]->GetLipschitzBound ();
+  double y = m_pSourceModule[2]->GetLipschitzBound ();
+  double z = m_pSourceModule[3]->GetLipschitzBound ();
+  return ScaleLipschitzBound (1.0 + sqrt (x * x + y * y + z * z),
+    m_pSourceModule[0]->GetLipschitzBound ());
+}
+
+noise::Interval Displace::GetValueRange (const Box& box) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+  assert (m_pSourceModule[2] != NULL);
+  assert (m_pSourceModule[3] != NULL);
+
+  // The source module is evaluated within the box of input values expanded
+  // by the range of each displacement module.
+  Box displacedBox;
+  displacedBox.x = IntervalAdd (box.x, m_pSourceModule[1]->GetValueRange (box));
+  displacedBox.y = IntervalAdd (box.y, m_pSourceModule[2]->GetValueRange (box));
+  displacedBox.z = IntervalAdd (box.z, m_pSourceModule[3]->GetValueRange (box));
+  return m_pSourceModule[0]->GetValueRange (displacedBox);
+}
+
+void Displace::GetValues (int count, const double* x, const double* y,
+  const double* z, double* out) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+  assert (m_pSourceModule[2] != NULL);
+  assert (m_pSourceModule[3] != NULL);
+
+  // Evaluate the three displacement modules over the whole batch, then add
+  // each output value to the corresponding coordinate in place.
+  std::vector<double> xDisplace (count);
+  std::vector<double> yDisplace (count);
+  std::vector<double> zDisplace (count);
+  m_pSourceModule[1]->GetValues (count, x, y, z, xDisplace.data ());
+  m_pSourceModule[2]->GetValues (count, x, y, z, yDisplace.data ());
+  m_pSourceModule[3]->GetValues (count, x, y, z, zDisplace.data ());
+  for (int i = 0; i < count; i++) {
+    xDisplace[i] = x[i] + xDisplace[i];
+    yDisplace[i] = y[i] + yDisplace[i];
+    zDisplace[i] = z[i] + zDisplace[i];
+  }
+
+  // Retrieve the output values at the displaced input values through the
+  // batch interface of the source module.
+  m_pSourceModule[0]->GetValues (count, xDisplace.data (), yDisplace.data (),
+    zDisplace.data (), out);
+}
@@ -20,6 +20,8 @@
 // off every 'zig'.)
 //
 
+#include "noise/fastmath.h"
+#include "noise/misc.h"
 #include "noise/module/exponent.h"
 
 using namespace noise::module;
@@ -30,10 +32,73 @@ Exponent::Exponent ():
 {
 }
 
+void Exponent::CombineValues (int count, const double* const* sourceValues,
+  double* out) const
+{
+  const double* v0 = sourceValues[0];
+  for (int i = 0; i < count; i++) {
+    out[i] = fabs ((v0[i] + 1.0) / 2.0);
+  }
+  MathPow (count, out, m_exponent, out);
+  for (int i = 0; i < count; i++) {
+    out[i] = out[i] * 2.0 - 1.0;
+  }
+}
+
 double Exponent::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
 
   double value = m_pSourceModule[0]->GetValue (x, y, z);
-  return (pow (fabs ((value + 1.0) / 2.0), m_exponent) * 2.0 - 1.0);
+  return (MathPow (fabs ((value + 1.0) / 2.0), m_exponent) * 2.0 - 1.0);
+}
+
+double Exponent::GetLipschitzBound () const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  // The derivative of 2 * |(v + 1) / 2| ^ e - 1 has a magnitude of
+  // |e| * |(v + 1) / 2| ^ (e - 1), which is largest at the largest rescaled
+  // value if e >= 1 and at the smallest one otherwise.
+  if (m_exponent == 0.0) {
+    return 0.0;
+  }
+  Interval range = IntervalAbs (IntervalMultiply (
+    IntervalAdd (m_pSourceModule[0]->GetValueRange (UnboundedBox ()), 1.0),
+    0.5));
+  double slope = fabs (m_exponent) * pow (
+    m_exponent >= 1.0? range.upper: range.lower, m_exponent - 1.0);
+  return ScaleLipschitzBound (slope, m_pSourceModule[0]->GetLipschitzBound ());
+}
+
+noise::Interval Exponent::GetValueRange (const Box& box) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  // The exponential function is monotonic over the absolute values of the
+  // rescaled output values from the source module.
+  Interval range = IntervalAbs (IntervalMultiply (
+    IntervalAdd (m_pSourceModule[0]->GetValueRange (box), 1.0), 0.5));
+  double p0 = pow (range.lower, m_exponent);
+  double p1 = pow (range.upper, m_exponent);
+  if (std::isnan (p0) || std::isnan (p1)) {
+    return UnboundedInterval ();
+  }
+
+  // Widen the bounds by the error of the approximation used by MathPow().
+  // Both powers are non-negative.
+  double e0 = MathPowError (range.lower, m_exponent);
+  double e1 = MathPowError (range.upper, m_exponent);
+  return Interval {
+    GetMin (p0 * (1.0 - e0), p1 * (1.0 - e1)) * 2.0 - 1.0,
+    GetMax (p0 * (1.0 + e0), p1 * (1.0 + e1)) * 2.0 - 1.0};
+}
+
+void Exponent::GetValues (int count, const double* x, const double* y,
+  const double* z, double* out) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  m_pSourceModule[0]->GetValues (count, x, y, z, out);
+  CombineValues (count, &out, out);
 }
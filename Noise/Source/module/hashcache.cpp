@@ -0,0 +1,223 @@
+// hashcache.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#include <cstring>
+#include "noise/module/hashcache.h"
+
+using namespace noise::module;
+
+HashCache::HashCache():
+	Module(GetSourceModuleCount()),
+	m_capacity(0),
+	m_quantum(DEFAULT_HASH_CACHE_QUANTUM),
+	m_setMask(0)
+{
+	SetCapacity(DEFAULT_HASH_CACHE_CAPACITY);
+}
+
+void HashCache::Clear()
+{
+	m_states.ForEach(ClearState);
+}
+
+void HashCache::ClearState(State& state)
+{
+	for (Entry& entry : state.entries)
+	{
+		entry.isValid = false;
+	}
+	for (std::uint8_t& victim : state.nextVictim)
+	{
+		victim = 0;
+	}
+}
+
+std::uint64_t HashCache::GetHitCount() const
+{
+	std::uint64_t hitCount = 0;
+	m_states.ForEach([&](const State& state) {
+		hitCount += state.hitCount;
+	});
+	return hitCount;
+}
+
+std::uint64_t HashCache::GetMissCount() const
+{
+	std::uint64_t missCount = 0;
+	m_states.ForEach([&](const State& state) {
+		missCount += state.missCount;
+	});
+	return missCount;
+}
+
+HashCache::State& HashCache::GetState() const
+{
+	// Connecting a source module or changing a parameter changes the version
+	// of this Noise module, which invalidates the table of every thread.
+	State& state = m_states.Get();
+	if (state.version != m_version)
+	{
+		state.version = m_version;
+		state.entries.assign((size_t)m_capacity, Entry());
+		state.nextVictim.assign((size_t)(m_setMask + 1), 0);
+		ClearState(state);
+	}
+	return state;
+}
+
+double HashCache::GetValue(double x, double y, double z) const
+{
+	assert (m_pSourceModule[0] != nullptr);
+
+	std::uint64_t xKey = MakeKey(x);
+	std::uint64_t yKey = MakeKey(y);
+	std::uint64_t zKey = MakeKey(z);
+
+	// Mix the keys together to select a set.  The final avalanche step makes
+	// every bit of the hash value depend on every bit of the keys, so that
+	// neighbouring input values land in different sets.
+	std::uint64_t hash = xKey * 0x9e3779b97f4a7c15ULL
+		^ yKey * 0xc2b2ae3d27d4eb4fULL
+		^ zKey * 0x165667b19e3779f9ULL;
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	std::uint64_t set = hash & m_setMask;
+
+	State& state = GetState();
+	Entry* pSet = &state.entries[set * HASH_CACHE_WAYS];
+	for (int i = 0; i < HASH_CACHE_WAYS; i++)
+	{
+		const Entry& entry = pSet[i];
+		if (entry.isValid && entry.xKey == xKey && entry.yKey == yKey
+			&& entry.zKey == zKey)
+		{
+			++state.hitCount;
+			return entry.value;
+		}
+	}
+
+	// The input value is not in the cache.  Have the source module calculate
+	// the output value and store it in place of the oldest entry in the set.
+	++state.missCount;
+	double value = m_pSourceModule[0]->GetValue(x, y, z);
+	std::uint8_t& victim = state.nextVictim[set];
+	Entry& entry = pSet[victim];
+	entry.xKey = xKey;
+	entry.yKey = yKey;
+	entry.zKey = zKey;
+	entry.value = value;
+	entry.isValid = true;
+	victim = (std::uint8_t)((victim + 1) % HASH_CACHE_WAYS);
+	return value;
+}
+
+std::uint64_t HashCache::MakeKey(double n) const
+{
+	// A quotient that is not finite or that does not fit in a 64-bit integer
+	// cannot be converted to a grid cell; use its exact bit pattern instead.
+	const double MAX_CELL = 4611686018427387904.0; // 2^62
+	if (m_quantum > 0.0)
+	{
+		double cell = floor(n / m_quantum);
+		if (cell > -MAX_CELL && cell < MAX_CELL)
+		{
+			return (std::uint64_t)(std::int64_t)cell;
+		}
+	}
+
+	// Compare the exact bit patterns of the coordinates.  Negative zero is
+	// folded onto positive zero since both compare as equal.
+	if (n == 0.0)
+	{
+		return 0;
+	}
+	std::uint64_t bits;
+	std::memcpy(&bits, &n, sizeof(bits));
+	return bits;
+}
+
+void HashCache::SetCapacity(int capacity)
+{
+	IncrementVersion();
+	if (capacity <= 0 || capacity > MAX_HASH_CACHE_CAPACITY)
+	{
+		throw noise::ExceptionInvalidParam();
+	}
+
+	// Round the number of sets up to a power of two so that the hash value can
+	// be masked rather than divided.
+	int setCount = 1;
+	while (setCount * HASH_CACHE_WAYS < capacity)
+	{
+		setCount <<= 1;
+	}
+
+	m_capacity = setCount * HASH_CACHE_WAYS;
+	m_setMask = (std::uint64_t)(setCount - 1);
+}
+
+void HashCache::SetQuantum(double quantum)
+{
+	IncrementVersion();
+	if (quantum < 0.0)
+	{
+		throw noise::ExceptionInvalidParam();
+	}
+
+	m_quantum = quantum;
+}
+
+void HashCache::ResetStats()
+{
+	m_states.ForEach([](State& state) {
+		state.hitCount = 0;
+		state.missCount = 0;
+	});
+}
+
+double HashCache::GetLipschitzBound() const
+{
+	assert (m_pSourceModule[0] != nullptr);
+
+	// Quantized input values share the output value of their grid cell, so
+	// the output value jumps at the cell boundaries.
+	if (m_quantum > 0.0)
+	{
+		return HUGE_VAL;
+	}
+	return m_pSourceModule[0]->GetLipschitzBound();
+}
+
+noise::Interval HashCache::GetValueRange(const Box& box) const
+{
+	assert (m_pSourceModule[0] != nullptr);
+
+	// A quantized input value may return an output value generated anywhere
+	// within the grid cell that contains it.
+	Interval slack = {-m_quantum, m_quantum};
+	Box cellBox;
+	cellBox.x = IntervalAdd(box.x, slack);
+	cellBox.y = IntervalAdd(box.y, slack);
+	cellBox.z = IntervalAdd(box.z, slack);
+	return m_pSourceModule[0]->GetValueRange(cellBox);
+}
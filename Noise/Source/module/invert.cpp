@@ -29,9 +29,42 @@ Invert::Invert ():
 {
 }
 
+void Invert::CombineValues (int count, const double* const* sourceValues,
+  double* out) const
+{
+  const double* v0 = sourceValues[0];
+  for (int i = 0; i < count; i++) {
+    out[i] = -v0[i];
+  }
+}
+
 double Invert::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
 
   return -(m_pSourceModule[0]->GetValue (x, y, z));
 }
+
+double Invert::GetLipschitzBound () const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  return m_pSourceModule[0]->GetLipschitzBound ();
+}
+
+noise::Interval Invert::GetValueRange (const Box& box) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  Interval range = m_pSourceModule[0]->GetValueRange (box);
+  return Interval {-range.upper, -range.lower};
+}
+
+void Invert::GetValues (int count, const double* x, const double* y,
+  const double* z, double* out) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  m_pSourceModule[0]->GetValues (count, x, y, z, out);
+  CombineValues (count, &out, out);
+}
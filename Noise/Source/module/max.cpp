@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include <vector>
 #include "noise/misc.h"
 #include "noise/module/max.h"
 
@@ -30,6 +31,16 @@ Max::Max ():
 {
 }
 
+void Max::CombineValues (int count, const double* const* sourceValues,
+  double* out) const
+{
+  const double* v0 = sourceValues[0];
+  const double* v1 = sourceValues[1];
+  for (int i = 0; i < count; i++) {
+    out[i] = GetMax (v0[i], v1[i]);
+  }
+}
+
 double Max::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
@@ -39,3 +50,35 @@ double Max::GetValue (double x, double y, double z) const
   double v1 = m_pSourceModule[1]->GetValue (x, y, z);
   return GetMax (v0, v1);
 }
+
+double Max::GetLipschitzBound () const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+
+  return GetMax (m_pSourceModule[0]->GetLipschitzBound (),
+    m_pSourceModule[1]->GetLipschitzBound ());
+}
+
+noise::Interval Max::GetValueRange (const Box& box) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+
+  Interval r0 = m_pSourceModule[0]->GetValueRange (box);
+  Interval r1 = m_pSourceModule[1]->GetValueRange (box);
+  return Interval {GetMax (r0.lower, r1.lower), GetMax (r0.upper, r1.upper)};
+}
+
+void Max::GetValues (int count, const double* x, const double* y,
+  const double* z, double* out) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+
+  std::vector<double> v1 (count);
+  m_pSourceModule[0]->GetValues (count, x, y, z, out);
+  m_pSourceModule[1]->GetValues (count, x, y, z, v1.data ());
+  const double* sourceValues[2] = {out, v1.data ()};
+  CombineValues (count, sourceValues, out);
+}
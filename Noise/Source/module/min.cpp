@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include <vector>
 #include "noise/misc.h"
 #include "noise/module/min.h"
 
@@ -30,6 +31,16 @@ Min::Min ():
 {
 }
 
+void Min::CombineValues (int count, const double* const* sourceValues,
+  double* out) const
+{
+  const double* v0 = sourceValues[0];
+  const double* v1 = sourceValues[1];
+  for (int i = 0; i < count; i++) {
+    out[i] = GetMin (v0[i], v1[i]);
+  }
+}
+
 double Min::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
@@ -39,3 +50,35 @@ double Min::GetValue (double x, double y, double z) const
   double v1 = m_pSourceModule[1]->GetValue (x, y, z);
   return GetMin (v0, v1);
 }
+
+double Min::GetLipschitzBound () const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+
+  return GetMax (m_pSourceModule[0]->GetLipschitzBound (),
+    m_pSourceModule[1]->GetLipschitzBound ());
+}
+
+noise::Interval Min::GetValueRange (const Box& box) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+
+  Interval r0 = m_pSourceModule[0]->GetValueRange (box);
+  Interval r1 = m_pSourceModule[1]->GetValueRange (box);
+  return Interval {GetMin (r0.lower, r1.lower), GetMin (r0.upper, r1.upper)};
+}
+
+void Min::GetValues (int count, const double* x, const double* y,
+  const double* z, double* out) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+
+  std::vector<double> v1 (count);
+  m_pSourceModule[0]->GetValues (count, x, y, z, out);
+  m_pSourceModule[1]->GetValues (count, x, y, z, v1.data ());
+  const double* sourceValues[2] = {out, v1.data ()};
+  CombineValues (count, sourceValues, out);
+}
@@ -20,13 +20,25 @@
 // off every 'zig'.)
 //
 
+#include <atomic>
+#include <vector>
+#include "noise/misc.h"
 #include "noise/module/modulebase.h"
 
 using namespace noise::module;
 
+namespace
+{
+
+  // The last version assigned to a Noise module.
+  std::atomic<std::uint64_t> s_lastVersion (0);
+
+}
+
 Module::Module (int sourceModuleCount)
 {
   m_pSourceModule = NULL;
+  IncrementVersion ();
 
   // Create an array of pointers to all source modules required by this
   // Noise module.  Set these pointers to NULL.
@@ -44,3 +56,102 @@ Module::~Module ()
 {
   delete[] m_pSourceModule;
 }
+
+void Module::CombineValues (int, const double* const*, double*) const
+{
+  assert (false);
+}
+
+double Module::GetLipschitzBound () const
+{
+  return HUGE_VAL;
+}
+
+void Module::GetNeededSources (const Box&, bool* isNeeded) const
+{
+  for (int i = 0; i < GetSourceModuleCount (); i++) {
+    isNeeded[i] = true;
+  }
+}
+
+void Module::GetSourceValues (int index, int laneCount, const int* lanes,
+  int count, const double* x, const double* y, const double* z,
+  double* out) const
+{
+  assert (m_pSourceModule[index] != NULL);
+
+  if (laneCount <= 0) {
+    return;
+  } else if (laneCount == count) {
+    // Every input value is in the subset.
+    m_pSourceModule[index]->GetValues (count, x, y, z, out);
+    return;
+  }
+
+  std::vector<double> packed (4 * (size_t)laneCount);
+  double* xPacked = &packed[0];
+  double* yPacked = xPacked + laneCount;
+  double* zPacked = yPacked + laneCount;
+  double* outPacked = zPacked + laneCount;
+  for (int i = 0; i < laneCount; i++) {
+    xPacked[i] = x[lanes[i]];
+    yPacked[i] = y[lanes[i]];
+    zPacked[i] = z[lanes[i]];
+  }
+  m_pSourceModule[index]->GetValues (laneCount, xPacked, yPacked, zPacked,
+    outPacked);
+  for (int i = 0; i < laneCount; i++) {
+    out[lanes[i]] = outPacked[i];
+  }
+}
+
+noise::Interval Module::GetLocalValueRange (const Box& box,
+  const Interval& range, double scale) const
+{
+  // Keep well away from the coordinates that MakeInt32Range() wraps, since
+  // the coordinates of each octave are scaled one step at a time and may be
+  // rounded up.
+  const double MAX_SCALED_COORDINATE = 0.5 * 1073741824.0;
+  double maxCoordinate = GetMax (
+    GetMax (IntervalAbs (box.x).upper, IntervalAbs (box.y).upper),
+    IntervalAbs (box.z).upper);
+  if (!(maxCoordinate * scale < MAX_SCALED_COORDINATE)) {
+    return range;
+  }
+  double bound = GetLipschitzBound ();
+  if (!(bound < HUGE_VAL)) {
+    return range;
+  }
+
+  // Calculate half the diagonal of the box.  The rounding errors of the
+  // Noise functions are several orders of magnitude below the slack added
+  // to the radius.
+  double dx = 0.5 * (box.x.upper - box.x.lower);
+  double dy = 0.5 * (box.y.upper - box.y.lower);
+  double dz = 0.5 * (box.z.upper - box.z.lower);
+  double centerValue = GetValue (box.x.lower + dx, box.y.lower + dy,
+    box.z.lower + dz);
+  double radius = ScaleLipschitzBound (sqrt (dx * dx + dy * dy + dz * dz),
+    bound);
+  radius += 1.0e-9 * (range.upper - range.lower);
+  return Interval {GetMax (range.lower, centerValue - radius),
+    GetMin (range.upper, centerValue + radius)};
+}
+
+noise::Interval Module::GetValueRange (const Box&) const
+{
+  return UnboundedInterval ();
+}
+
+void Module::GetValues (int count, const double* x, const double* y,
+  const double* z, double* out) const
+{
+  for (int i = 0; i < count; i++) {
+    out[i] = GetValue (x[i], y[i], z[i]);
+  }
+}
+
+void Module::IncrementVersion ()
+{
+  m_version = ++s_lastVersion;
+}
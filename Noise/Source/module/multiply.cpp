@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include <vector>
 #include "noise/module/multiply.h"
 
 using namespace noise::module;
@@ -29,6 +30,16 @@ Multiply::Multiply ():
 {
 }
 
+void Multiply::CombineValues (int count, const double* const* sourceValues,
+  double* out) const
+{
+  const double* v0 = sourceValues[0];
+  const double* v1 = sourceValues[1];
+  for (int i = 0; i < count; i++) {
+    out[i] = v0[i] * v1[i];
+  }
+}
+
 double Multiply::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
@@ -37,3 +48,41 @@ double Multiply::GetValue (double x, double y, double z) const
   return m_pSourceModule[0]->GetValue (x, y, z)
        * m_pSourceModule[1]->GetValue (x, y, z);
 }
+
+double Multiply::GetLipschitzBound () const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+
+  // The gradient of v0 * v1 is v1 times the gradient of v0 plus v0 times
+  // the gradient of v1.
+  Box box = UnboundedBox ();
+  Interval v0 = IntervalAbs (m_pSourceModule[0]->GetValueRange (box));
+  Interval v1 = IntervalAbs (m_pSourceModule[1]->GetValueRange (box));
+  return ScaleLipschitzBound (v1.upper,
+      m_pSourceModule[0]->GetLipschitzBound ())
+    + ScaleLipschitzBound (v0.upper,
+      m_pSourceModule[1]->GetLipschitzBound ());
+}
+
+noise::Interval Multiply::GetValueRange (const Box& box) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+
+  return IntervalMultiply (m_pSourceModule[0]->GetValueRange (box),
+    m_pSourceModule[1]->GetValueRange (box));
+}
+
+void Multiply::GetValues (int count, const double* x, const double* y,
+  const double* z, double* out) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+
+  std::vector<double> v1 (count);
+  m_pSourceModule[0]->GetValues (count, x, y, z, out);
+  m_pSourceModule[1]->GetValues (count, x, y, z, v1.data ());
+  const double* sourceValues[2] = {out, v1.data ()};
+  CombineValues (count, sourceValues, out);
+}
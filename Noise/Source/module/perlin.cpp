@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include "noise/misc.h"
 #include "noise/module/perlin.h"
 
 using namespace noise::module;
@@ -70,3 +71,36 @@ double Perlin::GetValue (double x, double y, double z) const
 
   return value;
 }
+
+double Perlin::GetLipschitzBound () const
+{
+  // Each octave adds a coherent-Noise value sampled at the frequency of that
+  // octave and scaled by its persistence.
+  double bound = 0.0;
+  double frequency = fabs (m_frequency);
+  double curPersistence = 1.0;
+  for (int curOctave = 0; curOctave < m_octaveCount; curOctave++) {
+    bound += frequency * fabs (curPersistence);
+    frequency *= fabs (m_lacunarity);
+    curPersistence *= m_persistence;
+  }
+  return bound * GradientCoherentNoiseLipschitzBound (m_noiseQuality);
+}
+
+noise::Interval Perlin::GetValueRange (const Box& box) const
+{
+  // Each octave adds a coherent-Noise value scaled by the persistence of
+  // that octave.
+  double amplitude = 0.0;
+  double frequency = fabs (m_frequency);
+  double scale = 0.0;
+  double curPersistence = 1.0;
+  for (int curOctave = 0; curOctave < m_octaveCount; curOctave++) {
+    amplitude += fabs (curPersistence);
+    scale = GetMax (scale, frequency);
+    frequency *= fabs (m_lacunarity);
+    curPersistence *= m_persistence;
+  }
+  amplitude *= GRADIENT_COHERENT_NOISE_BOUND;
+  return GetLocalValueRange (box, Interval {-amplitude, amplitude}, scale);
+}
@@ -19,6 +19,9 @@
 // The developer's email is angstrom@lionsanctuary.net
 //
 
+#include <vector>
+#include "noise/misc.h"
+#include "noise/fastmath.h"
 #include "noise/module/power.h"
 
 using namespace noise::module;
@@ -28,11 +31,103 @@ Power::Power ():
 {
 }
 
+void Power::CombineValues (int count, const double* const* sourceValues,
+  double* out) const
+{
+  MathPow (count, sourceValues[0], sourceValues[1], out);
+}
+
 double Power::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
   assert (m_pSourceModule[1] != NULL);
 
-  return pow (m_pSourceModule[0]->GetValue (x, y, z),
+  return MathPow (m_pSourceModule[0]->GetValue (x, y, z),
     m_pSourceModule[1]->GetValue (x, y, z));
 }
+
+double Power::GetLipschitzBound () const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+
+  double baseBound = m_pSourceModule[0]->GetLipschitzBound ();
+  double exponentBound = m_pSourceModule[1]->GetLipschitzBound ();
+  if (baseBound == 0.0 && exponentBound == 0.0) {
+    return 0.0;
+  }
+
+  // The gradient of b ^ e is e * b ^ (e - 1) times the gradient of b plus
+  // b ^ e * ln (b) times the gradient of e.  For a positive base, both
+  // powers are monotonic in the base and the exponent, so their extremes lie
+  // at the corners of the two ranges.  A base that may be zero or negative
+  // is not bounded.
+  Box box = UnboundedBox ();
+  Interval base = m_pSourceModule[0]->GetValueRange (box);
+  Interval exponent = m_pSourceModule[1]->GetValueRange (box);
+  if (base.lower <= 0.0) {
+    return HUGE_VAL;
+  }
+  double power = GetMax (
+    GetMax (pow (base.lower, exponent.lower), pow (base.lower, exponent.upper)),
+    GetMax (pow (base.upper, exponent.lower), pow (base.upper, exponent.upper)));
+  double lowerPower = GetMax (
+    GetMax (pow (base.lower, exponent.lower - 1.0),
+      pow (base.lower, exponent.upper - 1.0)),
+    GetMax (pow (base.upper, exponent.lower - 1.0),
+      pow (base.upper, exponent.upper - 1.0)));
+  double logarithm = GetMax (fabs (log (base.lower)), fabs (log (base.upper)));
+  return ScaleLipschitzBound (
+      ScaleLipschitzBound (IntervalAbs (exponent).upper, lowerPower),
+      baseBound)
+    + ScaleLipschitzBound (ScaleLipschitzBound (power, logarithm),
+      exponentBound);
+}
+
+noise::Interval Power::GetValueRange (const Box& box) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+
+  // For a positive base, the power function is monotonic in both the base
+  // and the exponent, so its extremes lie at the corners of the two ranges.
+  // A base that may be zero or negative is not bounded.
+  Interval base = m_pSourceModule[0]->GetValueRange (box);
+  Interval exponent = m_pSourceModule[1]->GetValueRange (box);
+  if (base.lower <= 0.0) {
+    return UnboundedInterval ();
+  }
+  double p0 = pow (base.lower, exponent.lower);
+  double p1 = pow (base.lower, exponent.upper);
+  double p2 = pow (base.upper, exponent.lower);
+  double p3 = pow (base.upper, exponent.upper);
+  if (std::isnan (p0) || std::isnan (p1) || std::isnan (p2)
+    || std::isnan (p3)) {
+    return UnboundedInterval ();
+  }
+
+  // Widen the bounds by the error of the approximation used by MathPow().
+  // Every power of a positive base is positive.
+  double e0 = MathPowError (base.lower, exponent.lower);
+  double e1 = MathPowError (base.lower, exponent.upper);
+  double e2 = MathPowError (base.upper, exponent.lower);
+  double e3 = MathPowError (base.upper, exponent.upper);
+  return Interval {
+    GetMin (GetMin (p0 * (1.0 - e0), p1 * (1.0 - e1)),
+      GetMin (p2 * (1.0 - e2), p3 * (1.0 - e3))),
+    GetMax (GetMax (p0 * (1.0 + e0), p1 * (1.0 + e1)),
+      GetMax (p2 * (1.0 + e2), p3 * (1.0 + e3)))};
+}
+
+void Power::GetValues (int count, const double* x, const double* y,
+  const double* z, double* out) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+
+  std::vector<double> v1 (count);
+  m_pSourceModule[0]->GetValues (count, x, y, z, out);
+  m_pSourceModule[1]->GetValues (count, x, y, z, v1.data ());
+  const double* sourceValues[2] = {out, v1.data ()};
+  CombineValues (count, sourceValues, out);
+}
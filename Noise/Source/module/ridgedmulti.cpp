@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include "noise/misc.h"
 #include "noise/module/ridgedmulti.h"
 
 using namespace noise::module;
@@ -112,3 +113,48 @@ double RidgedMulti::GetValue (double x, double y, double z) const
 
   return (value * 1.25) - 1.0;
 }
+
+double RidgedMulti::GetLipschitzBound () const
+{
+  // The squared ridge signal of each octave changes at most
+  // 2 * max (offset, bound - offset) times as fast as the coherent-Noise
+  // value, and is multiplied by a weight derived from the previous signal.
+  // The weight is clamped to 1.0 and changes at most gain times as fast as
+  // the previous signal, which is at most the larger of 1.0 and
+  // (offset - bound) ^ 2.
+  double offset = 1.0;
+  double gain = 2.0;
+  double ridge = offset - GRADIENT_COHERENT_NOISE_BOUND;
+  double signal = GetMax (1.0, ridge * ridge);
+  double ridgeSlope = 2.0 * GetMax (offset, -ridge)
+    * GradientCoherentNoiseLipschitzBound (m_noiseQuality);
+  double frequency = fabs (m_frequency);
+  double signalBound = 0.0;
+  double bound = 0.0;
+  for (int curOctave = 0; curOctave < m_octaveCount; curOctave++) {
+    signalBound = ridgeSlope * frequency + gain * signal * signalBound;
+    bound += signalBound * fabs (m_pSpectralWeights[curOctave]);
+    frequency *= fabs (m_lacunarity);
+  }
+  return bound * 1.25;
+}
+
+noise::Interval RidgedMulti::GetValueRange (const Box& box) const
+{
+  // The squared ridge signal of each octave ranges from zero to the larger
+  // of 1.0 and (offset - bound) ^ 2, and is scaled by a weight ranging from
+  // 0.0 to 1.0 and by the spectral weight of that octave.
+  double offset = 1.0;
+  double ridge = offset - GRADIENT_COHERENT_NOISE_BOUND;
+  double signal = GetMax (1.0, ridge * ridge);
+  double value = 0.0;
+  double frequency = fabs (m_frequency);
+  double scale = 0.0;
+  for (int curOctave = 0; curOctave < m_octaveCount; curOctave++) {
+    value += signal * m_pSpectralWeights[curOctave];
+    scale = GetMax (scale, frequency);
+    frequency *= fabs (m_lacunarity);
+  }
+  return GetLocalValueRange (box, Interval {-1.0, (value * 1.25) - 1.0},
+    scale);
+}
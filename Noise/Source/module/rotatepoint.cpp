@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include <vector>
 #include "noise/mathconsts.h"
 #include "noise/module/rotatepoint.h"
 
@@ -44,6 +45,7 @@ double RotatePoint::GetValue (double x, double y, double z) const
 void RotatePoint::SetAngles (double xAngle, double yAngle,
   double zAngle)
 {
+  IncrementVersion ();
   double xCos, yCos, zCos, xSin, ySin, zSin;
   xCos = cos (xAngle * DEG_TO_RAD);
   yCos = cos (yAngle * DEG_TO_RAD);
@@ -66,3 +68,48 @@ void RotatePoint::SetAngles (double xAngle, double yAngle,
   m_yAngle = yAngle;
   m_zAngle = zAngle;
 }
+
+double RotatePoint::GetLipschitzBound () const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  // A rotation does not change distances.
+  return m_pSourceModule[0]->GetLipschitzBound ();
+}
+
+noise::Interval RotatePoint::GetValueRange (const Box& box) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  Box rotatedBox;
+  rotatedBox.x = IntervalAdd (IntervalAdd (
+    IntervalMultiply (box.x, m_x1Matrix),
+    IntervalMultiply (box.y, m_y1Matrix)),
+    IntervalMultiply (box.z, m_z1Matrix));
+  rotatedBox.y = IntervalAdd (IntervalAdd (
+    IntervalMultiply (box.x, m_x2Matrix),
+    IntervalMultiply (box.y, m_y2Matrix)),
+    IntervalMultiply (box.z, m_z2Matrix));
+  rotatedBox.z = IntervalAdd (IntervalAdd (
+    IntervalMultiply (box.x, m_x3Matrix),
+    IntervalMultiply (box.y, m_y3Matrix)),
+    IntervalMultiply (box.z, m_z3Matrix));
+  return m_pSourceModule[0]->GetValueRange (rotatedBox);
+}
+
+void RotatePoint::GetValues (int count, const double* x, const double* y,
+  const double* z, double* out) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  std::vector<double> nx (count);
+  std::vector<double> ny (count);
+  std::vector<double> nz (count);
+  for (int i = 0; i < count; i++) {
+    nx[i] = (m_x1Matrix * x[i]) + (m_y1Matrix * y[i]) + (m_z1Matrix * z[i]);
+    ny[i] = (m_x2Matrix * x[i]) + (m_y2Matrix * y[i]) + (m_z2Matrix * z[i]);
+    nz[i] = (m_x3Matrix * x[i]) + (m_y3Matrix * y[i]) + (m_z3Matrix * z[i]);
+  }
+  m_pSourceModule[0]->GetValues (count, nx.data (), ny.data (), nz.data (),
+    out);
+}
@@ -31,9 +31,43 @@ ScaleBias::ScaleBias ():
 {
 }
 
+void ScaleBias::CombineValues (int count, const double* const* sourceValues,
+  double* out) const
+{
+  const double* v0 = sourceValues[0];
+  for (int i = 0; i < count; i++) {
+    out[i] = v0[i] * m_scale + m_bias;
+  }
+}
+
 double ScaleBias::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
 
   return m_pSourceModule[0]->GetValue (x, y, z) * m_scale + m_bias;
 }
+
+double ScaleBias::GetLipschitzBound () const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  return ScaleLipschitzBound (fabs (m_scale),
+    m_pSourceModule[0]->GetLipschitzBound ());
+}
+
+noise::Interval ScaleBias::GetValueRange (const Box& box) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  return IntervalAdd (IntervalMultiply (
+    m_pSourceModule[0]->GetValueRange (box), m_scale), m_bias);
+}
+
+void ScaleBias::GetValues (int count, const double* x, const double* y,
+  const double* z, double* out) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  m_pSourceModule[0]->GetValues (count, x, y, z, out);
+  CombineValues (count, &out, out);
+}
@@ -20,6 +20,8 @@
 // off every 'zig'.)
 //
 
+#include <vector>
+#include "noise/misc.h"
 #include "noise/module/scalepoint.h"
 
 using namespace noise::module;
@@ -39,3 +41,40 @@ double ScalePoint::GetValue (double x, double y, double z) const
   return m_pSourceModule[0]->GetValue (x * m_xScale, y * m_yScale,
     z * m_zScale);
 }
+
+double ScalePoint::GetLipschitzBound () const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  double scale = GetMax (GetMax (fabs (m_xScale), fabs (m_yScale)),
+    fabs (m_zScale));
+  return ScaleLipschitzBound (scale, m_pSourceModule[0]->GetLipschitzBound ());
+}
+
+noise::Interval ScalePoint::GetValueRange (const Box& box) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  Box scaledBox;
+  scaledBox.x = IntervalMultiply (box.x, m_xScale);
+  scaledBox.y = IntervalMultiply (box.y, m_yScale);
+  scaledBox.z = IntervalMultiply (box.z, m_zScale);
+  return m_pSourceModule[0]->GetValueRange (scaledBox);
+}
+
+void ScalePoint::GetValues (int count, const double* x, const double* y,
+  const double* z, double* out) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  std::vector<double> sx (count);
+  std::vector<double> sy (count);
+  std::vector<double> sz (count);
+  for (int i = 0; i < count; i++) {
+    sx[i] = x[i] * m_xScale;
+    sy[i] = y[i] * m_yScale;
+    sz[i] = z[i] * m_zScale;
+  }
+  m_pSourceModule[0]->GetValues (count, sx.data (), sy.data (), sz.data (),
+    out);
+}
@@ -20,7 +20,10 @@
 // off every 'zig'.)
 //
 
+#include <algorithm>
+#include <vector>
 #include "noise/interp.h"
+#include "noise/misc.h"
 #include "noise/module/select.h"
 
 using namespace noise::module;
@@ -33,6 +36,70 @@ Select::Select ():
 {
 }
 
+void Select::CombineValues (int count, const double* const* sourceValues,
+  double* out) const
+{
+  const double* v0 = sourceValues[0];
+  const double* v1 = sourceValues[1];
+  const double* control = sourceValues[2];
+
+  // If the control module was not needed, only one source module is
+  // selected within this batch.
+  if (control == NULL) {
+    const double* selected = (v0 != NULL)? v0: v1;
+    if (out != selected) {
+      std::copy (selected, selected + count, out);
+    }
+    return;
+  }
+
+  for (int i = 0; i < count; i++) {
+    double controlValue = control[i];
+    if (m_edgeFalloff > 0.0) {
+      if (controlValue < (m_lowerBound - m_edgeFalloff)) {
+        out[i] = v0[i];
+      } else if (controlValue < (m_lowerBound + m_edgeFalloff)) {
+        double lowerCurve = (m_lowerBound - m_edgeFalloff);
+        double upperCurve = (m_lowerBound + m_edgeFalloff);
+        double alpha = SCurve3 (
+          (controlValue - lowerCurve) / (upperCurve - lowerCurve));
+        out[i] = LinearInterp (v0[i], v1[i], alpha);
+      } else if (controlValue < (m_upperBound - m_edgeFalloff)) {
+        out[i] = v1[i];
+      } else if (controlValue < (m_upperBound + m_edgeFalloff)) {
+        double lowerCurve = (m_upperBound - m_edgeFalloff);
+        double upperCurve = (m_upperBound + m_edgeFalloff);
+        double alpha = SCurve3 (
+          (controlValue - lowerCurve) / (upperCurve - lowerCurve));
+        out[i] = LinearInterp (v1[i], v0[i], alpha);
+      } else {
+        out[i] = v0[i];
+      }
+    } else {
+      if (controlValue < m_lowerBound || controlValue > m_upperBound) {
+        out[i] = v0[i];
+      } else {
+        out[i] = v1[i];
+      }
+    }
+  }
+}
+
+void Select::GetNeededSources (const Box& box, bool* isNeeded) const
+{
+  assert (m_pSourceModule[2] != NULL);
+
+  // If the range of output values from the control module proves that only
+  // one source module is selected within the box, neither the control
+  // module nor the other source module is needed.
+  Interval controlRange = m_pSourceModule[2]->GetValueRange (box);
+  bool isFirstSelected = IsSourceSelected (0, controlRange);
+  bool isSecondSelected = IsSourceSelected (1, controlRange);
+  isNeeded[0] = !isSecondSelected;
+  isNeeded[1] = !isFirstSelected;
+  isNeeded[2] = !isFirstSelected && !isSecondSelected;
+}
+
 double Select::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
@@ -40,6 +107,122 @@ double Select::GetValue (double x, double y, double z) const
   assert (m_pSourceModule[2] != NULL);
 
   double controlValue = m_pSourceModule[2]->GetValue (x, y, z);
+  return GetSelectedValue (controlValue, x, y, z);
+}
+
+double Select::GetLipschitzBound () const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+  assert (m_pSourceModule[2] != NULL);
+
+  // Within the edge transitions, the gradient is a weighted average of the
+  // gradients of the source modules plus the gradient of the control module
+  // scaled by the slope of the S-curve (at most 1.5 / (2 * falloff)) and by
+  // the difference between the source values.  Without a falloff, the output
+  // value jumps at the edges unless the control value never changes.
+  double bound = GetMax (m_pSourceModule[0]->GetLipschitzBound (),
+    m_pSourceModule[1]->GetLipschitzBound ());
+  double controlBound = m_pSourceModule[2]->GetLipschitzBound ();
+  if (controlBound == 0.0) {
+    return bound;
+  } else if (m_edgeFalloff <= 0.0) {
+    return HUGE_VAL;
+  }
+  Box box = UnboundedBox ();
+  Interval difference = IntervalAdd (m_pSourceModule[1]->GetValueRange (box),
+    IntervalMultiply (m_pSourceModule[0]->GetValueRange (box), -1.0));
+  double slope = 0.75 / m_edgeFalloff;
+  return bound + ScaleLipschitzBound (slope * IntervalAbs (difference).upper,
+    controlBound);
+}
+
+noise::Interval Select::GetValueRange (const Box& box) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+  assert (m_pSourceModule[2] != NULL);
+
+  Interval controlRange = m_pSourceModule[2]->GetValueRange (box);
+  if (IsSourceSelected (0, controlRange)) {
+    return m_pSourceModule[0]->GetValueRange (box);
+  } else if (IsSourceSelected (1, controlRange)) {
+    return m_pSourceModule[1]->GetValueRange (box);
+  }
+
+  // Within the edge transitions, the output value is a weighted average of
+  // the two output values from the source modules.
+  return IntervalUnion (m_pSourceModule[0]->GetValueRange (box),
+    m_pSourceModule[1]->GetValueRange (box));
+}
+
+void Select::GetValues (int count, const double* x, const double* y,
+  const double* z, double* out) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+  assert (m_pSourceModule[2] != NULL);
+
+  if (count <= 0) {
+    return;
+  }
+
+  // If the range of output values from the control module proves that only
+  // one source module is selected within this batch, skip the control
+  // module and the other source module entirely.
+  Interval controlRange = m_pSourceModule[2]->GetValueRange (
+    MakeBoundingBox (count, x, y, z));
+  if (IsSourceSelected (0, controlRange)) {
+    m_pSourceModule[0]->GetValues (count, x, y, z, out);
+    return;
+  } else if (IsSourceSelected (1, controlRange)) {
+    m_pSourceModule[1]->GetValues (count, x, y, z, out);
+    return;
+  }
+
+  // Otherwise, evaluate the control module over the whole batch, then split
+  // the input values by the source modules they need.  Each source module is
+  // evaluated once over the packed input values that need it.
+  std::vector<double> controlValues (count);
+  m_pSourceModule[2]->GetValues (count, x, y, z, controlValues.data ());
+  std::vector<int> lanes[2];
+  lanes[0].reserve (count);
+  lanes[1].reserve (count);
+  for (int i = 0; i < count; i++) {
+    double controlValue = controlValues[i];
+    bool isInside, isOnEdge;
+    if (m_edgeFalloff > 0.0) {
+      isInside = controlValue >= (m_lowerBound - m_edgeFalloff)
+        && controlValue < (m_upperBound + m_edgeFalloff);
+      isOnEdge = isInside
+        && (controlValue < (m_lowerBound + m_edgeFalloff)
+          || controlValue >= (m_upperBound - m_edgeFalloff));
+    } else {
+      isInside = !(controlValue < m_lowerBound || controlValue > m_upperBound);
+      isOnEdge = false;
+    }
+    if (!isInside || isOnEdge) {
+      lanes[0].push_back (i);
+    }
+    if (isInside) {
+      lanes[1].push_back (i);
+    }
+  }
+
+  std::vector<double> sourceValues[2];
+  for (int j = 0; j < 2; j++) {
+    sourceValues[j].resize (count);
+    GetSourceValues (j, (int)lanes[j].size (), lanes[j].data (), count, x, y,
+      z, sourceValues[j].data ());
+  }
+  const double* combinedValues[3] = {sourceValues[0].data (),
+    sourceValues[1].data (), controlValues.data ()};
+  CombineValues (count, combinedValues, out);
+}
+
+double Select::GetSelectedValue (double controlValue, double x, double y,
+  double z) const
+{
   double alpha;
   if (m_edgeFalloff > 0.0) {
     if (controlValue < (m_lowerBound - m_edgeFalloff)) {
@@ -90,8 +273,30 @@ double Select::GetValue (double x, double y, double z) const
   }
 }
 
+bool Select::IsSourceSelected (int index, const Interval& controlRange) const
+{
+  if (m_edgeFalloff > 0.0) {
+    if (index == 0) {
+      return controlRange.upper < (m_lowerBound - m_edgeFalloff)
+        || controlRange.lower >= (m_upperBound + m_edgeFalloff);
+    } else {
+      return controlRange.lower >= (m_lowerBound + m_edgeFalloff)
+        && controlRange.upper < (m_upperBound - m_edgeFalloff);
+    }
+  } else {
+    if (index == 0) {
+      return controlRange.upper < m_lowerBound
+        || controlRange.lower > m_upperBound;
+    } else {
+      return controlRange.lower >= m_lowerBound
+        && controlRange.upper <= m_upperBound;
+    }
+  }
+}
+
 void Select::SetBounds (double lowerBound, double upperBound)
 {
+  IncrementVersion ();
   assert (lowerBound < upperBound);
 
   m_lowerBound = lowerBound;
@@ -103,6 +308,7 @@ void Select::SetBounds (double lowerBound, double upperBound)
 
 void Select::SetEdgeFalloff (double edgeFalloff)
 {
+  IncrementVersion ();
   // Make sure that the edge falloff curves do not overlap.
   double boundSize = m_upperBound - m_lowerBound;
   m_edgeFalloff = (edgeFalloff > boundSize / 2)? boundSize / 2: edgeFalloff;
@@ -43,3 +43,18 @@ double Spheres::GetValue (double x, double y, double z) const
   double nearestDist = GetMin (distFromSmallerSphere, distFromLargerSphere);
   return 1.0 - (nearestDist * 4.0); // Puts it in the -1.0 to +1.0 range.
 }
+
+double Spheres::GetLipschitzBound () const
+{
+  // The distance to the nearest sphere changes no faster than the input
+  // value, and is multiplied by the frequency and by 4.0.
+  return 4.0 * fabs (m_frequency);
+}
+
+noise::Interval Spheres::GetValueRange (const Box& box) const
+{
+  // The output value only depends on the distance from the origin.
+  Box scaledBox = {IntervalMultiply (box.x, m_frequency),
+    IntervalMultiply (box.y, m_frequency), IntervalMultiply (box.z, m_frequency)};
+  return ShellValueRange (IntervalDistance (scaledBox));
+}
@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include <vector>
 #include "noise/interp.h"
 #include "noise/misc.h"
 #include "noise/module/terrace.h"
@@ -43,18 +44,22 @@ Terrace::~Terrace ()
 
 void Terrace::AddControlPoint (double value)
 {
+  IncrementVersion ();
   // Find the insertion point for the new control point and insert the new
   // point at that position.  The control point array will remain sorted by
   // value.
   int insertionPos = FindInsertionPos (value);
   InsertAtPos (insertionPos, value);
+  m_segmentIndex.Build (m_pControlPoints, m_controlPointCount);
 }
 
 void Terrace::ClearAllControlPoints ()
 {
+  IncrementVersion ();
   delete[] m_pControlPoints;
   m_pControlPoints = NULL;
   m_controlPointCount = 0;
+  m_segmentIndex.Build (m_pControlPoints, m_controlPointCount);
 }
 
 int Terrace::FindInsertionPos (double value)
@@ -74,22 +79,88 @@ int Terrace::FindInsertionPos (double value)
   return insertionPos;
 }
 
+void Terrace::CombineValues (int count, const double* const* sourceValues,
+  double* out) const
+{
+  assert (m_controlPointCount >= 2);
+
+  // Locate the control points on either side of every output value from the
+  // source module first, so that the terrace-forming curve is evaluated in a
+  // separate loop without branches.
+  const double* v0 = sourceValues[0];
+  std::vector<int> indexPos (count);
+  for (int i = 0; i < count; i++) {
+    indexPos[i] = m_segmentIndex.Find (v0[i]);
+  }
+
+  int last = m_controlPointCount - 1;
+  bool invertTerraces = m_invertTerraces;
+  for (int i = 0; i < count; i++) {
+    int index0 = ClampValue (indexPos[i] - 1, 0, last);
+    int index1 = ClampValue (indexPos[i]    , 0, last);
+    double value0 = m_pControlPoints[index0];
+    double value1 = m_pControlPoints[index1];
+    double alpha = (v0[i] - value0) / (value1 - value0);
+    double lower = invertTerraces? value1: value0;
+    double upper = invertTerraces? value0: value1;
+    alpha = invertTerraces? 1.0 - alpha: alpha;
+    alpha *= alpha;
+    double value = LinearInterp (lower, upper, alpha);
+    out[i] = (index0 == index1)? value1: value;
+  }
+}
+
 double Terrace::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
   assert (m_controlPointCount >= 2);
 
-  // Get the output value from the source module.
-  double sourceModuleValue = m_pSourceModule[0]->GetValue (x, y, z);
+  // Get the output value from the source module and map it onto the
+  // terrace-forming curve.
+  return MapValue (m_pSourceModule[0]->GetValue (x, y, z));
+}
+
+double Terrace::GetLipschitzBound () const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_controlPointCount >= 2);
+
+  // The terrace-forming curve is flat outside of the control point array.
+  // Within each segment, it is a parabola that rises from one control point
+  // to the next with a slope of at most 2.0, whether or not the terraces are
+  // inverted.
+  return ScaleLipschitzBound (2.0, m_pSourceModule[0]->GetLipschitzBound ());
+}
 
+noise::Interval Terrace::GetValueRange (const Box& box) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_controlPointCount >= 2);
+
+  // The terrace-forming curve never decreases, whether or not the terraces
+  // are inverted, so the bounds of the source range map onto the bounds of
+  // the output range.  Infinite bounds map onto the outermost control
+  // points.
+  Interval sourceRange = m_pSourceModule[0]->GetValueRange (box);
+  return Interval {MapValue (sourceRange.lower),
+    MapValue (sourceRange.upper)};
+}
+
+void Terrace::GetValues (int count, const double* x, const double* y,
+  const double* z, double* out) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_controlPointCount >= 2);
+
+  m_pSourceModule[0]->GetValues (count, x, y, z, out);
+  CombineValues (count, &out, out);
+}
+
+double Terrace::MapValue (double sourceModuleValue) const
+{
   // Find the first element in the control point array that has a value
   // larger than the output value from the source module.
-  int indexPos;
-  for (indexPos = 0; indexPos < m_controlPointCount; indexPos++) {
-    if (sourceModuleValue < m_pControlPoints[indexPos]) {
-      break;
-    }
-  }
+  int indexPos = m_segmentIndex.Find (sourceModuleValue);
 
   // Find the two nearest control points so that we can map their values
   // onto a quadratic curve.
@@ -145,6 +216,7 @@ void Terrace::InsertAtPos (int insertionPos, double value)
 
 void Terrace::MakeControlPoints (int controlPointCount)
 {
+  IncrementVersion ();
   if (controlPointCount < 2) {
     throw noise::ExceptionInvalidParam ();
   }
@@ -0,0 +1,124 @@
+// transformpoint.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+#include <vector>
+#include "noise/module/transformpoint.h"
+
+using namespace noise::module;
+
+TransformPoint::TransformPoint():
+	Module(GetSourceModuleCount())
+{
+	const double identity[12] = {
+		1.0, 0.0, 0.0, 0.0,
+		0.0, 1.0, 0.0, 0.0,
+		0.0, 0.0, 1.0, 0.0};
+	SetMatrix(identity);
+}
+
+void TransformPoint::GetMatrix(double matrix[12]) const
+{
+	for (int i = 0; i < 12; i++)
+	{
+		matrix[i] = m_matrix[i];
+	}
+}
+
+double TransformPoint::GetValue(double x, double y, double z) const
+{
+	assert (m_pSourceModule[0] != nullptr);
+
+	const double* m = m_matrix;
+	double nx = (m[0] * x) + (m[1] * y) + (m[ 2] * z) + m[ 3];
+	double ny = (m[4] * x) + (m[5] * y) + (m[ 6] * z) + m[ 7];
+	double nz = (m[8] * x) + (m[9] * y) + (m[10] * z) + m[11];
+	return m_pSourceModule[0]->GetValue(nx, ny, nz);
+}
+
+double TransformPoint::GetLipschitzBound() const
+{
+	assert (m_pSourceModule[0] != nullptr);
+
+	// The Frobenius norm of the linear part of the matrix bounds how much
+	// the transformation can stretch distances.
+	double norm = 0.0;
+	for (int row = 0; row < 3; row++)
+	{
+		for (int column = 0; column < 3; column++)
+		{
+			double m = m_matrix[row * 4 + column];
+			norm += m * m;
+		}
+	}
+	return ScaleLipschitzBound(sqrt(norm),
+		m_pSourceModule[0]->GetLipschitzBound());
+}
+
+noise::Interval TransformPoint::GetValueRange(const Box& box) const
+{
+	assert (m_pSourceModule[0] != nullptr);
+
+	Interval* pTransformed[3];
+	Box transformedBox;
+	pTransformed[0] = &transformedBox.x;
+	pTransformed[1] = &transformedBox.y;
+	pTransformed[2] = &transformedBox.z;
+	for (int row = 0; row < 3; row++)
+	{
+		const double* m = &m_matrix[row * 4];
+		*pTransformed[row] = IntervalAdd(IntervalAdd(IntervalAdd(
+			IntervalMultiply(box.x, m[0]),
+			IntervalMultiply(box.y, m[1])),
+			IntervalMultiply(box.z, m[2])),
+			m[3]);
+	}
+	return m_pSourceModule[0]->GetValueRange(transformedBox);
+}
+
+void TransformPoint::GetValues(int count, const double* x, const double* y,
+	const double* z, double* out) const
+{
+	assert (m_pSourceModule[0] != nullptr);
+
+	const double* m = m_matrix;
+	std::vector<double> nx(count);
+	std::vector<double> ny(count);
+	std::vector<double> nz(count);
+	for (int i = 0; i < count; i++)
+	{
+		nx[i] = (m[0] * x[i]) + (m[1] * y[i]) + (m[ 2] * z[i]) + m[ 3];
+		ny[i] = (m[4] * x[i]) + (m[5] * y[i]) + (m[ 6] * z[i]) + m[ 7];
+		nz[i] = (m[8] * x[i]) + (m[9] * y[i]) + (m[10] * z[i]) + m[11];
+	}
+	m_pSourceModule[0]->GetValues(count, nx.data(), ny.data(), nz.data(),
+		out);
+}
+
+void TransformPoint::SetMatrix(const double matrix[12])
+{
+	IncrementVersion();
+	for (int i = 0; i < 12; i++)
+	{
+		m_matrix[i] = matrix[i];
+	}
+}
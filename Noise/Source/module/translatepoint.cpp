@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include <vector>
 #include "noise/module/translatepoint.h"
 
 using namespace noise::module;
@@ -39,3 +40,38 @@ double TranslatePoint::GetValue (double x, double y, double z) const
   return m_pSourceModule[0]->GetValue (x + m_xTranslation, y + m_yTranslation,
     z + m_zTranslation);
 }
+
+double TranslatePoint::GetLipschitzBound () const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  return m_pSourceModule[0]->GetLipschitzBound ();
+}
+
+noise::Interval TranslatePoint::GetValueRange (const Box& box) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  Box translatedBox;
+  translatedBox.x = IntervalAdd (box.x, m_xTranslation);
+  translatedBox.y = IntervalAdd (box.y, m_yTranslation);
+  translatedBox.z = IntervalAdd (box.z, m_zTranslation);
+  return m_pSourceModule[0]->GetValueRange (translatedBox);
+}
+
+void TranslatePoint::GetValues (int count, const double* x, const double* y,
+  const double* z, double* out) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  std::vector<double> tx (count);
+  std::vector<double> ty (count);
+  std::vector<double> tz (count);
+  for (int i = 0; i < count; i++) {
+    tx[i] = x[i] + m_xTranslation;
+    ty[i] = y[i] + m_yTranslation;
+    tz[i] = z[i] + m_zTranslation;
+  }
+  m_pSourceModule[0]->GetValues (count, tx.data (), ty.data (), tz.data (),
+    out);
+}
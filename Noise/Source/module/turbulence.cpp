@@ -20,10 +20,30 @@
 // off every 'zig'.)
 //
 
+#include <vector>
 #include "noise/module/turbulence.h"
 
 using namespace noise::module;
 
+namespace
+{
+
+  // Number of input values whose displacements are calculated together.
+  const int DISTORT_CHUNK_SIZE = 16;
+
+  // Offsets added to the coordinates of the input value before they are
+  // passed to each distortion module.  This prevents the distortion modules
+  // from returning zero if the (x, y, z) coordinates, when multiplied by the
+  // frequency, are near an integer boundary.  This is due to a property of
+  // gradient coherent Noise, which returns zero at integer boundaries.
+  const double DISTORT_OFFSETS[3][3] = {
+    {12414.0 / 65536.0, 65124.0 / 65536.0, 31337.0 / 65536.0},
+    {26519.0 / 65536.0, 18128.0 / 65536.0, 60493.0 / 65536.0},
+    {53820.0 / 65536.0, 11213.0 / 65536.0, 44845.0 / 65536.0}
+  };
+
+}
+
 Turbulence::Turbulence ():
   Module (GetSourceModuleCount ()),
   m_power (DEFAULT_TURBULENCE_POWER)
@@ -45,43 +65,107 @@ int Turbulence::GetSeed () const
   return m_xDistortModule.GetSeed ();
 }
 
+void Turbulence::GetDistortion (int count, const double* x, const double* y,
+  const double* z, double* xDistort, double* yDistort, double* zDistort) const
+{
+  int distortSeeds[3] = {m_xDistortModule.GetSeed (),
+    m_yDistortModule.GetSeed (), m_zDistortModule.GetSeed ()};
+
+  // The three Noise::module::Perlin Noise modules only differ by their seeds,
+  // so the parameters of the first one apply to all of them.
+  double frequency = m_xDistortModule.GetFrequency ();
+  double lacunarity = m_xDistortModule.GetLacunarity ();
+  double persistence = m_xDistortModule.GetPersistence ();
+  int octaveCount = m_xDistortModule.GetOctaveCount ();
+  NoiseQuality noiseQuality = m_xDistortModule.GetNoiseQuality ();
+
+  // Each input value occupies three consecutive lanes, one for each
+  // distortion module.
+  const int LANE_COUNT = 3 * DISTORT_CHUNK_SIZE;
+  double lx[LANE_COUNT], ly[LANE_COUNT], lz[LANE_COUNT];
+  double nx[LANE_COUNT], ny[LANE_COUNT], nz[LANE_COUNT];
+  double signal[LANE_COUNT], value[LANE_COUNT];
+  int seed[LANE_COUNT];
+
+  for (int first = 0; first < count; first += DISTORT_CHUNK_SIZE) {
+    int chunkSize = count - first;
+    if (chunkSize > DISTORT_CHUNK_SIZE) {
+      chunkSize = DISTORT_CHUNK_SIZE;
+    }
+    int laneCount = 3 * chunkSize;
+
+    for (int i = 0; i < chunkSize; i++) {
+      for (int j = 0; j < 3; j++) {
+        int lane = 3 * i + j;
+        lx[lane] = (x[first + i] + DISTORT_OFFSETS[j][0]) * frequency;
+        ly[lane] = (y[first + i] + DISTORT_OFFSETS[j][1]) * frequency;
+        lz[lane] = (z[first + i] + DISTORT_OFFSETS[j][2]) * frequency;
+        value[lane] = 0.0;
+      }
+    }
+
+    // This loop follows the octave loop of Noise::module::Perlin.
+    double curPersistence = 1.0;
+    for (int curOctave = 0; curOctave < octaveCount; curOctave++) {
+      for (int lane = 0; lane < laneCount; lane++) {
+        nx[lane] = MakeInt32Range (lx[lane]);
+        ny[lane] = MakeInt32Range (ly[lane]);
+        nz[lane] = MakeInt32Range (lz[lane]);
+        seed[lane] = (distortSeeds[lane % 3] + curOctave) & 0xffffffff;
+      }
+      GradientCoherentNoise3D (laneCount, nx, ny, nz, seed, noiseQuality,
+        signal);
+      for (int lane = 0; lane < laneCount; lane++) {
+        value[lane] += signal[lane] * curPersistence;
+        lx[lane] *= lacunarity;
+        ly[lane] *= lacunarity;
+        lz[lane] *= lacunarity;
+      }
+      curPersistence *= persistence;
+    }
+
+    for (int i = 0; i < chunkSize; i++) {
+      xDistort[first + i] = x[first + i] + (value[3 * i    ] * m_power);
+      yDistort[first + i] = y[first + i] + (value[3 * i + 1] * m_power);
+      zDistort[first + i] = z[first + i] + (value[3 * i + 2] * m_power);
+    }
+  }
+}
+
 double Turbulence::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
 
   // Get the values from the three Noise::module::Perlin Noise modules and
-  // add each value to each coordinate of the input value.  There are also
-  // some offsets added to the coordinates of the input values.  This prevents
-  // the distortion modules from returning zero if the (x, y, z) coordinates,
-  // when multiplied by the frequency, are near an integer boundary.  This is
-  // due to a property of gradient coherent Noise, which returns zero at
-  // integer boundaries.
-  double x0, y0, z0;
-  double x1, y1, z1;
-  double x2, y2, z2;
-  x0 = x + (12414.0 / 65536.0);
-  y0 = y + (65124.0 / 65536.0);
-  z0 = z + (31337.0 / 65536.0);
-  x1 = x + (26519.0 / 65536.0);
-  y1 = y + (18128.0 / 65536.0);
-  z1 = z + (60493.0 / 65536.0);
-  x2 = x + (53820.0 / 65536.0);
-  y2 = y + (11213.0 / 65536.0);
-  z2 = z + (44845.0 / 65536.0);
-  double xDistort = x + (m_xDistortModule.GetValue (x0, y0, z0)
-    * m_power);
-  double yDistort = y + (m_yDistortModule.GetValue (x1, y1, z1)
-    * m_power);
-  double zDistort = z + (m_zDistortModule.GetValue (x2, y2, z2)
-    * m_power);
+  // add each value to each coordinate of the input value.
+  double xDistort, yDistort, zDistort;
+  GetDistortion (1, &x, &y, &z, &xDistort, &yDistort, &zDistort);
 
   // Retrieve the output value at the offsetted input value instead of the
   // original input value.
   return m_pSourceModule[0]->GetValue (xDistort, yDistort, zDistort);
 }
 
+void Turbulence::GetValues (int count, const double* x, const double* y,
+  const double* z, double* out) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  // Displace the whole batch of input values, then retrieve the output values
+  // at the displaced input values through the batch interface of the source
+  // module.
+  std::vector<double> xDistort (count);
+  std::vector<double> yDistort (count);
+  std::vector<double> zDistort (count);
+  GetDistortion (count, x, y, z, xDistort.data (), yDistort.data (),
+    zDistort.data ());
+  m_pSourceModule[0]->GetValues (count, xDistort.data (), yDistort.data (),
+    zDistort.data (), out);
+}
+
 void Turbulence::SetSeed (int seed)
 {
+  IncrementVersion ();
   // Set the seed of each Noise::module::Perlin Noise modules.  To prevent any
   // sort of weird artifacting, use a slightly different seed for each Noise
   // module.
@@ -89,3 +173,35 @@ void Turbulence::SetSeed (int seed)
   m_yDistortModule.SetSeed (seed + 1);
   m_zDistortModule.SetSeed (seed + 2);
 }
+
+double Turbulence::GetLipschitzBound () const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  // The distorted input value moves at most (1 + power * the Frobenius norm
+  // of the gradients of the distortion modules) times as fast as the input
+  // value.
+  double x = m_xDistortModule.GetLipschitzBound ();
+  double y = m_yDistortModule.GetLipschitzBound ();
+  double z = m_zDistortModule.GetLipschitzBound ();
+  return ScaleLipschitzBound (
+    1.0 + ScaleLipschitzBound (fabs (m_power), sqrt (x * x + y * y + z * z)),
+    m_pSourceModule[0]->GetLipschitzBound ());
+}
+
+noise::Interval Turbulence::GetValueRange (const Box& box) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  // The source module is evaluated within the box of input values expanded
+  // by the scaled range of each distortion module.  The distortion modules
+  // ignore their input values when calculating their ranges.
+  Box distortedBox;
+  distortedBox.x = IntervalAdd (box.x, IntervalMultiply (
+    m_xDistortModule.GetValueRange (box), m_power));
+  distortedBox.y = IntervalAdd (box.y, IntervalMultiply (
+    m_yDistortModule.GetValueRange (box), m_power));
+  distortedBox.z = IntervalAdd (box.z, IntervalMultiply (
+    m_zDistortModule.GetValueRange (box), m_power));
+  return m_pSourceModule[0]->GetValueRange (distortedBox);
+}
@@ -99,3 +99,33 @@ double Voronoi::GetValue (double x, double y, double z) const
     (int)(floor (yCandidate)),
     (int)(floor (zCandidate))));
 }
+
+double Voronoi::GetLipschitzBound () const
+{
+  // The random value of the nearest seed point jumps at the cell
+  // boundaries.  Without it, the output value is the distance to the nearest
+  // seed point, which changes no faster than the input value, multiplied by
+  // the frequency and by sqrt (3).
+  if (m_displacement != 0.0) {
+    return HUGE_VAL;
+  } else if (m_enableDistance) {
+    return SQRT_3 * fabs (m_frequency);
+  } else {
+    return 0.0;
+  }
+}
+
+noise::Interval Voronoi::GetValueRange (const Box& box) const
+{
+  // The seed point of the unit cube containing the input value is offset by
+  // at most one unit along each axis, so the nearest seed point is at most
+  // 2 * sqrt (3) units away.  The displacement value ranges from -1.0 to
+  // +1.0.
+  Interval range = {0.0, 0.0};
+  if (m_enableDistance) {
+    range = Interval {-1.0, 2.0 * SQRT_3 * SQRT_3 - 1.0};
+  }
+  double displacement = fabs (m_displacement);
+  range = IntervalAdd (range, Interval {-displacement, displacement});
+  return GetLocalValueRange (box, range, fabs (m_frequency));
+}
@@ -111,6 +111,99 @@ double noise::GradientCoherentNoise3D (double x, double y, double z, int seed,
   return LinearInterp (iy0, iy1, zs);
 }
 
+void noise::GradientCoherentNoise3D (int count, const double* x,
+  const double* y, const double* z, const int* seed, NoiseQuality noiseQuality,
+  double* out)
+{
+  // Number of input values processed together.
+  const int LANE_COUNT = 16;
+
+  for (int first = 0; first < count; first += LANE_COUNT) {
+    int laneCount = count - first;
+    if (laneCount > LANE_COUNT) {
+      laneCount = LANE_COUNT;
+    }
+
+    // For each input value, find the cube that surrounds it, the distances
+    // from its lower and upper vertices, and the S-curve values.  The hash of
+    // the lower vertex is calculated once; the hashes of the other vertices
+    // differ from it by constants.  Unsigned arithmetic produces the same
+    // bits as the single-value version.
+    double xd0[LANE_COUNT], yd0[LANE_COUNT], zd0[LANE_COUNT];
+    double xd1[LANE_COUNT], yd1[LANE_COUNT], zd1[LANE_COUNT];
+    double xs[LANE_COUNT], ys[LANE_COUNT], zs[LANE_COUNT];
+    unsigned int hash[LANE_COUNT];
+    for (int i = 0; i < laneCount; i++) {
+      double fx = x[first + i];
+      double fy = y[first + i];
+      double fz = z[first + i];
+      int x0 = (fx > 0.0? (int)fx: (int)fx - 1);
+      int y0 = (fy > 0.0? (int)fy: (int)fy - 1);
+      int z0 = (fz > 0.0? (int)fz: (int)fz - 1);
+      xd0[i] = fx - (double)x0;
+      yd0[i] = fy - (double)y0;
+      zd0[i] = fz - (double)z0;
+      xd1[i] = fx - (double)(x0 + 1);
+      yd1[i] = fy - (double)(y0 + 1);
+      zd1[i] = fz - (double)(z0 + 1);
+      hash[i] = (unsigned int)X_NOISE_GEN * (unsigned int)x0
+        + (unsigned int)Y_NOISE_GEN * (unsigned int)y0
+        + (unsigned int)Z_NOISE_GEN * (unsigned int)z0
+        + (unsigned int)SEED_NOISE_GEN * (unsigned int)seed[first + i];
+    }
+    for (int i = 0; i < laneCount; i++) {
+      switch (noiseQuality) {
+        case QUALITY_FAST:
+          xs[i] = xd0[i];
+          ys[i] = yd0[i];
+          zs[i] = zd0[i];
+          break;
+        case QUALITY_STD:
+          xs[i] = SCurve3 (xd0[i]);
+          ys[i] = SCurve3 (yd0[i]);
+          zs[i] = SCurve3 (zd0[i]);
+          break;
+        case QUALITY_BEST:
+          xs[i] = SCurve5 (xd0[i]);
+          ys[i] = SCurve5 (yd0[i]);
+          zs[i] = SCurve5 (zd0[i]);
+          break;
+        default:
+          xs[i] = 0.0;
+          ys[i] = 0.0;
+          zs[i] = 0.0;
+          break;
+      }
+    }
+
+    // Calculate the gradient-Noise value at each vertex of the cube, then
+    // interpolate them in the same order as the single-value version.
+    for (int i = 0; i < laneCount; i++) {
+      double vertex[8];
+      for (int v = 0; v < 8; v++) {
+        unsigned int vectorIndex = hash[i]
+          + ((v & 1)? (unsigned int)X_NOISE_GEN: 0u)
+          + ((v & 2)? (unsigned int)Y_NOISE_GEN: 0u)
+          + ((v & 4)? (unsigned int)Z_NOISE_GEN: 0u);
+        vectorIndex ^= (vectorIndex >> SHIFT_NOISE_GEN);
+        vectorIndex &= 0xff;
+        const double* gradient = &g_randomVectors[vectorIndex << 2];
+        vertex[v] = ((gradient[0] * ((v & 1)? xd1[i]: xd0[i]))
+          + (gradient[1] * ((v & 2)? yd1[i]: yd0[i]))
+          + (gradient[2] * ((v & 4)? zd1[i]: zd0[i]))) * 2.12;
+      }
+      double ix0, ix1, iy0, iy1;
+      ix0 = LinearInterp (vertex[0], vertex[1], xs[i]);
+      ix1 = LinearInterp (vertex[2], vertex[3], xs[i]);
+      iy0 = LinearInterp (ix0, ix1, ys[i]);
+      ix0 = LinearInterp (vertex[4], vertex[5], xs[i]);
+      ix1 = LinearInterp (vertex[6], vertex[7], xs[i]);
+      iy1 = LinearInterp (ix0, ix1, ys[i]);
+      out[first + i] = LinearInterp (iy0, iy1, zs[i]);
+    }
+  }
+}
+
 double noise::GradientNoise3D (double fx, double fy, double fz, int ix,
   int iy, int iz, int seed)
 {
@@ -147,15 +240,17 @@ double noise::GradientNoise3D (double fx, double fy, double fz, int ix,
 int noise::IntValueNoise3D (int x, int y, int z, int seed)
 {
   // All constants are primes and must remain prime in order for this Noise
-  // function to work correctly.
-  int n = (
-      X_NOISE_GEN    * x
-    + Y_NOISE_GEN    * y
-    + Z_NOISE_GEN    * z
-    + SEED_NOISE_GEN * seed)
+  // function to work correctly.  The arithmetic is unsigned so that it wraps
+  // instead of overflowing; signed overflow is undefined, and optimizing
+  // compilers return values outside the range of this function.
+  unsigned int n = (
+      (unsigned int)X_NOISE_GEN    * (unsigned int)x
+    + (unsigned int)Y_NOISE_GEN    * (unsigned int)y
+    + (unsigned int)Z_NOISE_GEN    * (unsigned int)z
+    + (unsigned int)SEED_NOISE_GEN * (unsigned int)seed)
     & 0x7fffffff;
   n = (n >> 13) ^ n;
-  return (n * (n * n * 60493 + 19990303) + 1376312589) & 0x7fffffff;
+  return (int)((n * (n * n * 60493 + 19990303) + 1376312589) & 0x7fffffff);
 }
 
 double noise::ValueCoherentNoise3D (double x, double y, double z, int seed,
@@ -0,0 +1,445 @@
+// optimizer.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+#include <algorithm>
+#include <sstream>
+#include <typeindex>
+#include <typeinfo>
+#include "noise/graph.h"
+#include "noise/module/module.h"
+#include "noise/optimizer.h"
+
+using namespace noise;
+using namespace noise::module;
+
+namespace
+{
+
+	/// Returns a Noise module as an instance of a specific class.
+	///
+	/// Instances of classes derived from that class are rejected, since
+	/// they may override its behaviour.
+	template <class T>
+	const T* As(const Module* pModule)
+	{
+		if (typeid(*pModule) != typeid(T))
+		{
+			return nullptr;
+		}
+		return static_cast<const T*>(pModule);
+	}
+
+	/// Returns the source modules of a Noise module.
+	std::vector<const Module*> GetSources(const Module& module)
+	{
+		std::vector<const Module*> sources(module.GetSourceModuleCount());
+		for (int i = 0; i < (int)sources.size(); i++)
+		{
+			sources[i] = &module.GetSourceModule(i);
+		}
+		return sources;
+	}
+
+	/// Determines if the output value from a Noise module only depends on
+	/// the output values from its source modules, and not on the input
+	/// value.
+	bool IsOutputModifier(const Module& module)
+	{
+		std::type_index type = typeid(module);
+		return type == typeid(Abs) || type == typeid(Add)
+			|| type == typeid(Blend) || type == typeid(Clamp)
+			|| type == typeid(Curve) || type == typeid(Exponent)
+			|| type == typeid(Invert) || type == typeid(Max)
+			|| type == typeid(Min) || type == typeid(Multiply)
+			|| type == typeid(Power) || type == typeid(ScaleBias)
+			|| type == typeid(Select) || type == typeid(Terrace);
+	}
+
+	/// Determines if the output value from a Noise module is the output
+	/// value from its first source module at some other input value.
+	bool IsCoordinateModifier(const Module& module)
+	{
+		std::type_index type = typeid(module);
+		return type == typeid(Cache) || type == typeid(Displace)
+			|| type == typeid(HashCache) || type == typeid(RotatePoint)
+			|| type == typeid(ScalePoint) || type == typeid(TransformPoint)
+			|| type == typeid(TranslatePoint) || type == typeid(Turbulence);
+	}
+
+	/// Determines if a Noise module outputs the same value for every input
+	/// value, given its source modules.
+	bool IsConstant(const Module& module,
+		const std::vector<const Module*>& sources)
+	{
+		if (IsOutputModifier(module))
+		{
+			for (const Module* pSource : sources)
+			{
+				if (As<Const>(pSource) == nullptr)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+		if (IsCoordinateModifier(module))
+		{
+			return As<Const>(sources[0]) != nullptr;
+		}
+		return false;
+	}
+
+	/// Expresses a Noise module as an affine function of the output value
+	/// from another Noise module.
+	///
+	/// @returns @a true if the Noise module outputs
+	/// <i>scale * inner + bias</i>.
+	bool GetAffine(const Module& module,
+		const std::vector<const Module*>& sources, double& scale,
+		double& bias, const Module*& pInner)
+	{
+		if (const ScaleBias* pScaleBias = As<ScaleBias>(&module))
+		{
+			scale = pScaleBias->GetScale();
+			bias = pScaleBias->GetBias();
+			pInner = sources[0];
+			return true;
+		}
+		if (As<Invert>(&module) != nullptr)
+		{
+			scale = -1.0;
+			bias = 0.0;
+			pInner = sources[0];
+			return true;
+		}
+		bool isAdd = As<Add>(&module) != nullptr;
+		bool isMultiply = As<Multiply>(&module) != nullptr;
+		if (isAdd || isMultiply)
+		{
+			for (int i = 0; i < 2; i++)
+			{
+				if (const Const* pConst = As<Const>(sources[i]))
+				{
+					double value = pConst->GetConstValue();
+					scale = isAdd ? 1.0 : value;
+					bias = isAdd ? value : 0.0;
+					pInner = sources[1 - i];
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	/// Expresses a Noise module as the output value from another Noise
+	/// module at an affine transformation of the input value.
+	///
+	/// @returns @a true if the Noise module outputs the value of @a inner at
+	/// the input value transformed by @a matrix.
+	bool GetTransform(const Module& module,
+		const std::vector<const Module*>& sources, double matrix[12],
+		const Module*& pInner)
+	{
+		for (int i = 0; i < 12; i++)
+		{
+			matrix[i] = (i % 5 == 0) ? 1.0 : 0.0;
+		}
+		pInner = sources.empty() ? nullptr : sources[0];
+
+		if (const ScalePoint* pScale = As<ScalePoint>(&module))
+		{
+			matrix[0] = pScale->GetXScale();
+			matrix[5] = pScale->GetYScale();
+			matrix[10] = pScale->GetZScale();
+			return true;
+		}
+		if (const TranslatePoint* pTranslate = As<TranslatePoint>(&module))
+		{
+			matrix[3] = pTranslate->GetXTranslation();
+			matrix[7] = pTranslate->GetYTranslation();
+			matrix[11] = pTranslate->GetZTranslation();
+			return true;
+		}
+		if (const RotatePoint* pRotate = As<RotatePoint>(&module))
+		{
+			double rotation[9];
+			pRotate->GetMatrix(rotation);
+			for (int row = 0; row < 3; row++)
+			{
+				for (int column = 0; column < 3; column++)
+				{
+					matrix[row * 4 + column] = rotation[row * 3 + column];
+				}
+			}
+			return true;
+		}
+		if (const TransformPoint* pTransform = As<TransformPoint>(&module))
+		{
+			pTransform->GetMatrix(matrix);
+			return true;
+		}
+		return false;
+	}
+
+	/// Determines if a matrix is the identity transformation.
+	bool IsIdentity(const double matrix[12])
+	{
+		for (int i = 0; i < 12; i++)
+		{
+			if (matrix[i] != ((i % 5 == 0) ? 1.0 : 0.0))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+}
+
+GraphOptimizer::GraphOptimizer() = default;
+
+void GraphOptimizer::Clear()
+{
+	m_optimized.clear();
+	m_modules.clear();
+}
+
+template <class T>
+T& GraphOptimizer::Create()
+{
+	T* pModule = new T();
+	m_modules.emplace_back(pModule);
+	return *pModule;
+}
+
+const Module* GraphOptimizer::Copy(const Module& original,
+	const std::vector<const Module*>& sources)
+{
+	std::unique_ptr<Module> pCopy = CopyModule(original);
+	if (!pCopy)
+	{
+		return nullptr;
+	}
+	for (int i = 0; i < (int)sources.size(); i++)
+	{
+		pCopy->SetSourceModule(i, *sources[i]);
+	}
+	m_modules.push_back(std::move(pCopy));
+	return m_modules.back().get();
+}
+
+const Module& GraphOptimizer::Optimize(const Module& root)
+{
+	m_report = OptimizerReport();
+	m_report.inputModuleCount = CountModules(root);
+
+	const Module& optimizedRoot = OptimizeModule(root);
+	m_optimized.clear();
+
+	m_report.outputModuleCount = CountModules(optimizedRoot);
+	return optimizedRoot;
+}
+
+const Module& GraphOptimizer::OptimizeModule(const Module& original)
+{
+	auto found = m_optimized.find(&original);
+	if (found != m_optimized.end())
+	{
+		return *found->second;
+	}
+
+	// Optimize the source modules first, so that each rewrite rule only has
+	// to look one level down the graph.
+	std::vector<const Module*> sources(original.GetSourceModuleCount());
+	bool isSourceChanged = false;
+	for (int i = 0; i < (int)sources.size(); i++)
+	{
+		const Module& source = original.GetSourceModule(i);
+		sources[i] = &OptimizeModule(source);
+		isSourceChanged = isSourceChanged || sources[i] != &source;
+	}
+
+	const Module* pResult = Rewrite(original, sources);
+	if (pResult == nullptr)
+	{
+		pResult = &original;
+		if (isSourceChanged)
+		{
+			// Unknown classes cannot be copied; keep the original Noise module
+			// along with its original source modules.
+			const Module* pCopy = Copy(original, sources);
+			if (pCopy != nullptr)
+			{
+				pResult = pCopy;
+			}
+		}
+	}
+
+	m_optimized[&original] = pResult;
+	return *pResult;
+}
+
+const Module* GraphOptimizer::Rewrite(const Module& original,
+	const std::vector<const Module*>& sources)
+{
+	std::ostringstream change;
+	change.precision(17);
+
+	// Replace Noise modules that output the same value everywhere.
+	if (As<Const>(&original) == nullptr && IsConstant(original, sources))
+	{
+		Const& constant = Create<Const>();
+		constant.SetConstValue(original.GetValue(0.0, 0.0, 0.0));
+		++m_report.foldedConstantCount;
+		change << "Folded " << GetModuleClassName(original)
+			<< " into Const with value " << constant.GetConstValue();
+		m_report.changes.push_back(change.str());
+		return &constant;
+	}
+
+	// Replace selections controlled by a constant with the selected source.
+	if (const Select* pSelect = As<Select>(&original))
+	{
+		if (const Const* pControl = As<Const>(sources[2]))
+		{
+			double controlValue = pControl->GetConstValue();
+			Interval controlRange = {controlValue, controlValue};
+			for (int i = 0; i < 2; i++)
+			{
+				if (pSelect->IsSourceSelected(i, controlRange))
+				{
+					++m_report.resolvedSelectionCount;
+					change << "Replaced Select with its source module " << i;
+					m_report.changes.push_back(change.str());
+					return sources[i];
+				}
+			}
+		}
+	}
+	if (As<Blend>(&original) != nullptr)
+	{
+		if (const Const* pControl = As<Const>(sources[2]))
+		{
+			double controlValue = pControl->GetConstValue();
+			if (controlValue == -1.0 || controlValue == 1.0)
+			{
+				int i = (controlValue < 0.0) ? 0 : 1;
+				++m_report.resolvedSelectionCount;
+				change << "Replaced Blend with its source module " << i;
+				m_report.changes.push_back(change.str());
+				return sources[i];
+			}
+		}
+	}
+
+	// Fold affine output modules into a single ScaleBias module.
+	double scale, bias;
+	const Module* pInner;
+	if (GetAffine(original, sources, scale, bias, pInner))
+	{
+		int foldedCount = 1;
+		double innerScale, innerBias;
+		const Module* pInnerSource;
+		if (GetAffine(*pInner, GetSources(*pInner), innerScale, innerBias,
+			pInnerSource))
+		{
+			bias = scale * innerBias + bias;
+			scale = scale * innerScale;
+			pInner = pInnerSource;
+			++foldedCount;
+		}
+
+		if (scale == 1.0 && bias == 0.0)
+		{
+			m_report.removedIdentityCount += foldedCount;
+			change << "Removed identity " << GetModuleClassName(original);
+			m_report.changes.push_back(change.str());
+			return pInner;
+		}
+		if (foldedCount > 1 || (As<ScaleBias>(&original) == nullptr
+			&& As<Invert>(&original) == nullptr))
+		{
+			ScaleBias& scaleBias = Create<ScaleBias>();
+			scaleBias.SetScale(scale);
+			scaleBias.SetBias(bias);
+			scaleBias.SetSourceModule(0, *pInner);
+			++m_report.foldedAffineCount;
+			change << "Folded " << GetModuleClassName(original) << " into ScaleBias"
+				<< " with scale " << scale << " and bias " << bias;
+			m_report.changes.push_back(change.str());
+			return &scaleBias;
+		}
+		return nullptr;
+	}
+
+	// Fuse chains of transformer modules into a single TransformPoint module.
+	double matrix[12];
+	if (GetTransform(original, sources, matrix, pInner))
+	{
+		int fusedCount = 1;
+		double innerMatrix[12];
+		const Module* pInnerSource;
+		if (GetTransform(*pInner, GetSources(*pInner), innerMatrix,
+			pInnerSource))
+		{
+			// The outer transformation is applied first, so the combined
+			// matrix is the inner matrix multiplied by the outer matrix.
+			double combined[12];
+			for (int row = 0; row < 3; row++)
+			{
+				const double* a = &innerMatrix[row * 4];
+				for (int column = 0; column < 4; column++)
+				{
+					combined[row * 4 + column] = a[0] * matrix[column]
+						+ a[1] * matrix[4 + column]
+						+ a[2] * matrix[8 + column];
+				}
+				combined[row * 4 + 3] += a[3];
+			}
+			std::copy(combined, combined + 12, matrix);
+			pInner = pInnerSource;
+			++fusedCount;
+		}
+
+		if (IsIdentity(matrix))
+		{
+			m_report.removedIdentityCount += fusedCount;
+			change << "Removed identity " << GetModuleClassName(original);
+			m_report.changes.push_back(change.str());
+			return pInner;
+		}
+		if (fusedCount > 1)
+		{
+			TransformPoint& transform = Create<TransformPoint>();
+			transform.SetMatrix(matrix);
+			transform.SetSourceModule(0, *pInner);
+			++m_report.fusedTransformCount;
+			change << "Fused " << GetModuleClassName(original) << " and "
+				<< GetModuleClassName(*sources[0]) << " into TransformPoint";
+			m_report.changes.push_back(change.str());
+			return &transform;
+		}
+	}
+
+	return nullptr;
+}
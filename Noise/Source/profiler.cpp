@@ -0,0 +1,475 @@
+// profiler.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include "noise/exception.h"
+#include "noise/graph.h"
+#include "noise/profiler.h"
+
+using namespace noise;
+using namespace noise::module;
+
+struct Profiler::Counters
+{
+
+	/// The name of the Noise module.
+	std::string name;
+
+	/// Number of output values requested from the Noise module.
+	std::atomic<std::uint64_t> callCount{0};
+
+	/// Number of output values whose evaluation was timed.
+	std::atomic<std::uint64_t> sampledCallCount{0};
+
+	/// Number of evaluations started by the Noise module.
+	std::atomic<std::uint64_t> evaluationCount{0};
+
+	/// Time spent in the Noise module and its source modules during timed
+	/// evaluations, in nanoseconds.
+	std::atomic<std::int64_t> inclusiveTime{0};
+
+	/// Time spent in the Noise module itself during timed evaluations, in
+	/// nanoseconds.
+	std::atomic<std::int64_t> exclusiveTime{0};
+
+};
+
+#ifdef NOISE_ENABLE_PROFILING
+
+namespace
+{
+
+	/// A timed call in progress on the current thread.
+	struct Frame
+	{
+
+		/// Time spent in the timed calls made by this call, in nanoseconds.
+		std::int64_t childTime;
+
+	};
+
+	/// Number of timing modules entered by the current thread.
+	thread_local int t_depth = 0;
+
+	/// Determines if the current evaluation is timed.
+	thread_local bool t_isSampling = false;
+
+	/// The innermost timed call on the current thread.
+	thread_local Frame* t_pFrame = nullptr;
+
+}
+
+class Profiler::TimingModule: public Module
+{
+
+public:
+
+	/// Constructor.
+	///
+	/// If @a isPointwise is @a true, the timing module is pointwise and
+	/// takes the source modules of the timed Noise module, so that
+	/// Noise::RasterExecutor plans the instrumented graph like the original
+	/// and times each of its steps.  Otherwise the timed Noise module is the
+	/// only source module.
+	TimingModule(Counters& counters, const int& samplingInterval,
+		const Module& timed, bool isPointwise):
+		Module(isPointwise? timed.GetSourceModuleCount(): 1),
+		m_counters(counters),
+		m_pTimed(&timed),
+		m_samplingInterval(samplingInterval),
+		m_isPointwise(isPointwise),
+		m_sourceModuleCount(isPointwise? timed.GetSourceModuleCount(): 1)
+	{
+		if (isPointwise)
+		{
+			for (int i = 0; i < m_sourceModuleCount; i++)
+			{
+				m_pSourceModule[i] = &timed.GetSourceModule(i);
+			}
+		}
+		else
+		{
+			m_pSourceModule[0] = &timed;
+		}
+	}
+
+	void CombineValues(int count, const double* const* sourceValues,
+		double* out) const override
+	{
+		Time(count, [&]() {
+			m_pTimed->CombineValues(count, sourceValues, out);
+		});
+	}
+
+	double GetLipschitzBound() const override
+	{
+		return m_pTimed->GetLipschitzBound();
+	}
+
+	void GetNeededSources(const Box& box, bool* isNeeded) const override
+	{
+		m_pTimed->GetNeededSources(box, isNeeded);
+	}
+
+	int GetSourceModuleCount() const override
+	{
+		return m_sourceModuleCount;
+	}
+
+	double GetValue(double x, double y, double z) const override
+	{
+		double value;
+		Time(1, [&]() {
+			value = m_pTimed->GetValue(x, y, z);
+		});
+		return value;
+	}
+
+	Interval GetValueRange(const Box& box) const override
+	{
+		return m_pTimed->GetValueRange(box);
+	}
+
+	void GetValues(int count, const double* x, const double* y,
+		const double* z, double* out) const override
+	{
+		Time(count, [&]() {
+			m_pTimed->GetValues(count, x, y, z, out);
+		});
+	}
+
+	bool IsPointwise() const override
+	{
+		return m_isPointwise;
+	}
+
+private:
+
+	/// Calls the source module and records the statistics of the call.
+	template <class Function>
+	void Time(int count, const Function& call) const
+	{
+		m_counters.callCount.fetch_add(count, std::memory_order_relaxed);
+
+		// The decision to time an evaluation is made once, by the outermost
+		// timing module, so that inclusive and exclusive times stay
+		// consistent.  Each Noise module counts its own evaluations, since
+		// Noise::RasterExecutor calls every step of its plan separately.
+		if (t_depth == 0)
+		{
+			t_isSampling = (m_counters.evaluationCount.fetch_add(1,
+				std::memory_order_relaxed) % m_samplingInterval) == 0;
+		}
+
+		++t_depth;
+		if (!t_isSampling)
+		{
+			call();
+			--t_depth;
+			return;
+		}
+
+		Frame frame = {0};
+		Frame* pParent = t_pFrame;
+		t_pFrame = &frame;
+		auto start = std::chrono::steady_clock::now();
+		call();
+		auto end = std::chrono::steady_clock::now();
+		t_pFrame = pParent;
+		--t_depth;
+
+		std::int64_t elapsed = std::chrono::duration_cast<
+			std::chrono::nanoseconds>(end - start).count();
+		m_counters.sampledCallCount.fetch_add(count,
+			std::memory_order_relaxed);
+		m_counters.inclusiveTime.fetch_add(elapsed, std::memory_order_relaxed);
+		m_counters.exclusiveTime.fetch_add(elapsed - frame.childTime,
+			std::memory_order_relaxed);
+		if (pParent != nullptr)
+		{
+			pParent->childTime += elapsed;
+		}
+	}
+
+	/// The statistics of the timed Noise module.
+	Counters& m_counters;
+
+	/// The timed Noise module.
+	const Module* m_pTimed;
+
+	/// Number of evaluations between two timed evaluations.
+	const int& m_samplingInterval;
+
+	/// Determines if the timing module is pointwise.
+	bool m_isPointwise;
+
+	/// Number of source modules.
+	int m_sourceModuleCount;
+
+};
+
+#endif
+
+namespace
+{
+
+	/// Writes a string as a quoted JSON string.
+	void WriteJsonString(std::ostream& os, const std::string& text)
+	{
+		os << '"';
+		for (char c : text)
+		{
+			if (c == '"' || c == '\\')
+			{
+				os << '\\' << c;
+			}
+			else if ((unsigned char)c < 0x20)
+			{
+				os << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+					<< (int)c << std::dec << std::setfill(' ');
+			}
+			else
+			{
+				os << c;
+			}
+		}
+		os << '"';
+	}
+
+}
+
+Profiler::Profiler():
+	m_samplingInterval(DEFAULT_PROFILER_SAMPLING_INTERVAL)
+{
+}
+
+Profiler::~Profiler() = default;
+
+void Profiler::Clear()
+{
+	m_instrumented.clear();
+	m_modules.clear();
+	m_counters.clear();
+}
+
+std::vector<ProfileRecord> Profiler::GetRecords() const
+{
+	std::vector<ProfileRecord> records;
+	for (const auto& pCounters : m_counters)
+	{
+		ProfileRecord record;
+		record.name = pCounters->name;
+		record.callCount = pCounters->callCount;
+		record.sampledCallCount = pCounters->sampledCallCount;
+
+		// Extrapolate the timed evaluations to every evaluation.
+		double scale = 0.0;
+		if (pCounters->sampledCallCount > 0)
+		{
+			scale = 1.0e-9 * (double)pCounters->callCount
+				/ (double)pCounters->sampledCallCount;
+		}
+		record.inclusiveTime = (double)pCounters->inclusiveTime * scale;
+		record.exclusiveTime = (double)pCounters->exclusiveTime * scale;
+		records.push_back(record);
+	}
+
+	std::stable_sort(records.begin(), records.end(),
+		[](const ProfileRecord& a, const ProfileRecord& b) {
+			return a.exclusiveTime > b.exclusiveTime;
+		});
+	return records;
+}
+
+const Module& Profiler::Instrument(const Module& root)
+{
+#ifdef NOISE_ENABLE_PROFILING
+	const Module& instrumentedRoot = InstrumentModule(root);
+	m_instrumented.clear();
+	return instrumentedRoot;
+#else
+	return root;
+#endif
+}
+
+const Module& Profiler::InstrumentModule(const Module& original)
+{
+#ifdef NOISE_ENABLE_PROFILING
+	auto found = m_instrumented.find(&original);
+	if (found != m_instrumented.end())
+	{
+		return *found->second;
+	}
+
+	// Copy the Noise module so that it reads from the instrumented source
+	// modules.  Generators have no source modules and are shared with the
+	// original graph, as are Noise modules of unknown classes.  Only the
+	// copies are split into steps by Noise::RasterExecutor, since the
+	// source modules of the others are not instrumented.
+	const Module* pTimed = &original;
+	bool isPointwise = false;
+	if (original.GetSourceModuleCount() > 0)
+	{
+		std::unique_ptr<Module> pCopy = CopyModule(original);
+		if (pCopy)
+		{
+			for (int i = 0; i < original.GetSourceModuleCount(); i++)
+			{
+				pCopy->SetSourceModule(i,
+					InstrumentModule(original.GetSourceModule(i)));
+			}
+			pTimed = pCopy.get();
+			isPointwise = pCopy->IsPointwise();
+			m_modules.push_back(std::move(pCopy));
+		}
+	}
+
+	auto pCounters = std::make_unique<Counters>();
+	auto name = m_names.find(&original);
+	if (name != m_names.end())
+	{
+		pCounters->name = name->second;
+	}
+	else
+	{
+		std::string className = GetModuleClassName(original);
+		int index = 0;
+		for (const auto& pOther : m_counters)
+		{
+			if (pOther->name.compare(0, className.size() + 1, className + "#")
+				== 0)
+			{
+				++index;
+			}
+		}
+		pCounters->name = className + "#" + std::to_string(index);
+	}
+
+	auto pTiming = std::make_unique<TimingModule>(*pCounters,
+		m_samplingInterval, *pTimed, isPointwise);
+	const Module* pResult = pTiming.get();
+	m_counters.push_back(std::move(pCounters));
+	m_modules.push_back(std::move(pTiming));
+	m_instrumented[&original] = pResult;
+	return *pResult;
+#else
+	return original;
+#endif
+}
+
+bool Profiler::IsEnabled()
+{
+#ifdef NOISE_ENABLE_PROFILING
+	return true;
+#else
+	return false;
+#endif
+}
+
+void Profiler::ResetStats()
+{
+	for (const auto& pCounters : m_counters)
+	{
+		pCounters->callCount = 0;
+		pCounters->sampledCallCount = 0;
+		pCounters->evaluationCount = 0;
+		pCounters->inclusiveTime = 0;
+		pCounters->exclusiveTime = 0;
+	}
+}
+
+void Profiler::SetName(const Module& module, const std::string& name)
+{
+	m_names[&module] = name;
+}
+
+void Profiler::SetSamplingInterval(int samplingInterval)
+{
+	if (samplingInterval < 1)
+	{
+		throw noise::ExceptionInvalidParam();
+	}
+
+	m_samplingInterval = samplingInterval;
+}
+
+void Profiler::WriteJson(std::ostream& os) const
+{
+	std::vector<ProfileRecord> records = GetRecords();
+	std::ios_base::fmtflags flags = os.flags();
+	std::streamsize precision = os.precision(9);
+	os.unsetf(std::ios_base::floatfield);
+	os << "{\n  \"samplingInterval\": " << m_samplingInterval
+		<< ",\n  \"modules\": [";
+	for (size_t i = 0; i < records.size(); i++)
+	{
+		const ProfileRecord& record = records[i];
+		os << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+		WriteJsonString(os, record.name);
+		os << ", \"calls\": " << record.callCount
+			<< ", \"sampledCalls\": " << record.sampledCallCount
+			<< ", \"inclusiveSeconds\": " << record.inclusiveTime
+			<< ", \"exclusiveSeconds\": " << record.exclusiveTime << "}";
+	}
+	os << "\n  ]\n}\n";
+	os.precision(precision);
+	os.flags(flags);
+}
+
+void Profiler::WriteTable(std::ostream& os) const
+{
+	std::vector<ProfileRecord> records = GetRecords();
+	double totalTime = 0.0;
+	size_t nameWidth = 6;
+	for (const ProfileRecord& record : records)
+	{
+		totalTime += record.exclusiveTime;
+		nameWidth = std::max(nameWidth, record.name.size());
+	}
+
+	std::ios_base::fmtflags flags = os.flags();
+	std::streamsize precision = os.precision();
+	os << std::left << std::setw((int)nameWidth) << "Module" << std::right
+		<< std::setw(14) << "Calls"
+		<< std::setw(16) << "Inclusive (ms)"
+		<< std::setw(16) << "Exclusive (ms)"
+		<< std::setw(10) << "Share" << '\n';
+	os << std::fixed;
+	for (const ProfileRecord& record : records)
+	{
+		double share = (totalTime > 0.0)
+			? 100.0 * record.exclusiveTime / totalTime : 0.0;
+		os << std::left << std::setw((int)nameWidth) << record.name
+			<< std::right
+			<< std::setw(14) << record.callCount
+			<< std::setw(16) << std::setprecision(3)
+			<< record.inclusiveTime * 1000.0
+			<< std::setw(16) << record.exclusiveTime * 1000.0
+			<< std::setw(9) << std::setprecision(1) << share << "%\n";
+	}
+	os.precision(precision);
+	os.flags(flags);
+}
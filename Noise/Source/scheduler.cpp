@@ -0,0 +1,208 @@
+// scheduler.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#include "noise/exception.h"
+#include "noise/scheduler.h"
+
+using namespace noise;
+
+TaskScheduler::TaskScheduler(int threadCount):
+	m_generation(0),
+	m_isFailed(false),
+	m_isStopping(false),
+	m_runningCount(0),
+	m_pTask(nullptr)
+{
+	if (threadCount < 1)
+	{
+		throw noise::ExceptionInvalidParam();
+	}
+	for (int i = 0; i < threadCount; i++)
+	{
+		m_queues.push_back(std::make_unique<Queue>());
+	}
+	for (int i = 1; i < threadCount; i++)
+	{
+		m_threads.emplace_back(&TaskScheduler::WorkerMain, this, i);
+	}
+}
+
+TaskScheduler::~TaskScheduler()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isStopping = true;
+	}
+	m_changed.notify_all();
+	for (std::thread& thread : m_threads)
+	{
+		thread.join();
+	}
+}
+
+void TaskScheduler::Run(int taskCount, const Task& task)
+{
+	if (taskCount <= 0)
+	{
+		return;
+	}
+
+	// Hand each thread an equal, contiguous share of the tasks.  The worker
+	// threads are idle between batches, so the ranges can be set without
+	// taking their locks.
+	int threadCount = GetThreadCount();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (int i = 0; i < threadCount; i++)
+		{
+			Queue& queue = *m_queues[i];
+			queue.begin = (int)((long long)taskCount * i / threadCount);
+			queue.end = (int)((long long)taskCount * (i + 1) / threadCount);
+		}
+		m_pTask = &task;
+		m_error = nullptr;
+		m_isFailed = false;
+		m_runningCount = (int)m_threads.size();
+		m_generation++;
+	}
+	m_changed.notify_all();
+
+	Work(0);
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_changed.wait(lock, [this] {
+		return m_runningCount == 0;
+	});
+	m_pTask = nullptr;
+	if (m_error)
+	{
+		std::rethrow_exception(m_error);
+	}
+}
+
+int TaskScheduler::TakeTask(int thread)
+{
+	if (m_isFailed)
+	{
+		return -1;
+	}
+
+	Queue& ownQueue = *m_queues[thread];
+	{
+		std::lock_guard<std::mutex> lock(ownQueue.mutex);
+		if (ownQueue.begin < ownQueue.end)
+		{
+			return ownQueue.begin++;
+		}
+	}
+
+	for (;;)
+	{
+		// Find the thread with the most tasks left.  Stealing from it, rather
+		// than from the first thread that has any, splits the remaining work
+		// into the fewest and largest ranges.
+		int victim = -1;
+		int mostCount = 0;
+		for (int i = 0; i < GetThreadCount(); i++)
+		{
+			if (i == thread)
+			{
+				continue;
+			}
+			Queue& queue = *m_queues[i];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			if (queue.end - queue.begin > mostCount)
+			{
+				victim = i;
+				mostCount = queue.end - queue.begin;
+			}
+		}
+		if (victim < 0)
+		{
+			return -1;
+		}
+
+		// Steal the back half of its range, which is the part it would have
+		// reached last.  The range may have shrunk since it was measured.
+		int first, end;
+		{
+			Queue& queue = *m_queues[victim];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			int count = (queue.end - queue.begin + 1) / 2;
+			if (count <= 0)
+			{
+				continue;
+			}
+			end = queue.end;
+			first = end - count;
+			queue.end = first;
+		}
+		std::lock_guard<std::mutex> lock(ownQueue.mutex);
+		ownQueue.begin = first + 1;
+		ownQueue.end = end;
+		return first;
+	}
+}
+
+void TaskScheduler::Work(int thread)
+{
+	for (int task = TakeTask(thread); task >= 0; task = TakeTask(thread))
+	{
+		try
+		{
+			(*m_pTask)(task, thread);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_error)
+			{
+				m_error = std::current_exception();
+			}
+			m_isFailed = true;
+		}
+	}
+}
+
+void TaskScheduler::WorkerMain(int thread)
+{
+	int generation = 0;
+	std::unique_lock<std::mutex> lock(m_mutex);
+	for (;;)
+	{
+		m_changed.wait(lock, [&] {
+			return m_isStopping || m_generation != generation;
+		});
+		if (m_isStopping)
+		{
+			return;
+		}
+		generation = m_generation;
+		lock.unlock();
+		Work(thread);
+		lock.lock();
+		if (--m_runningCount == 0)
+		{
+			m_changed.notify_all();
+		}
+	}
+}
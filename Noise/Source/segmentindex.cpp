@@ -0,0 +1,72 @@
+// segmentindex.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#include <cmath>
+#include "noise/segmentindex.h"
+
+using namespace noise;
+
+namespace
+{
+
+	/// Number of buckets in the index for each segment between two
+	/// breakpoints.
+	const int BUCKETS_PER_SEGMENT = 4;
+
+}
+
+SegmentIndex::SegmentIndex ():
+	m_bucketScale (0.0)
+{
+}
+
+void SegmentIndex::Build (const double* breakpoints, int count)
+{
+	m_breakpoints.assign (breakpoints, breakpoints + count);
+	m_bucketStart.clear ();
+	m_bucketScale = 0.0;
+	if (count < 2) {
+		return;
+	}
+
+	int bucketCount = BUCKETS_PER_SEGMENT * (count - 1);
+	double first = breakpoints[0];
+	double width = breakpoints[count - 1] - first;
+	m_bucketScale = bucketCount / width;
+	if (!(m_bucketScale > 0.0 && m_bucketScale < HUGE_VAL)) {
+		// The range of the breakpoints cannot be divided into buckets; every
+		// lookup starts from the first breakpoint.
+		m_bucketScale = 0.0;
+		m_bucketStart.assign (1, 0);
+		return;
+	}
+
+	m_bucketStart.resize (bucketCount);
+	int pos = 0;
+	for (int i = 0; i < bucketCount; i++) {
+		double edge = first + i * (width / bucketCount);
+		while (pos < count && !(edge < breakpoints[pos])) {
+			++pos;
+		}
+		m_bucketStart[i] = pos;
+	}
+}
@@ -0,0 +1,534 @@
+// serialize.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <locale>
+#include <map>
+#include <sstream>
+#include <string>
+#include "noise/exception.h"
+#include "noise/graph.h"
+#include "noise/serialize.h"
+
+using namespace noise;
+using namespace noise::module;
+
+namespace
+{
+
+	/// The first bytes of a graph in binary format.
+	const char GRAPH_MAGIC[4] = {'N', 'G', 'R', 'F'};
+
+	/// The first word of a graph in text format.
+	const char* const GRAPH_TEXT_MAGIC = "noise-graph";
+
+	/// The version of both serialization formats.
+	const std::uint32_t GRAPH_FORMAT_VERSION = 1;
+
+	/// A Noise module and the positions of its source modules.
+	struct Node
+	{
+
+		/// The class and parameters of the Noise module.
+		ModuleDescription description;
+
+		/// The positions of the source modules.
+		std::vector<std::uint32_t> sources;
+
+	};
+
+	/// Lists the Noise modules of a graph so that every Noise module comes
+	/// after its source modules.
+	void Flatten(const Module& module,
+		std::map<const Module*, std::uint32_t>& positions,
+		std::vector<Node>& nodes)
+	{
+		if (positions.find(&module) != positions.end())
+		{
+			return;
+		}
+
+		Node node;
+		for (int i = 0; i < module.GetSourceModuleCount(); i++)
+		{
+			const Module& source = module.GetSourceModule(i);
+			Flatten(source, positions, nodes);
+			node.sources.push_back(positions[&source]);
+		}
+		if (!DescribeModule(module, node.description))
+		{
+			throw noise::ExceptionInvalidParam();
+		}
+		positions[&module] = (std::uint32_t)nodes.size();
+		nodes.push_back(std::move(node));
+	}
+
+	/// Lists the Noise modules of a graph so that every Noise module comes
+	/// after its source modules.
+	std::vector<Node> Flatten(const Module& root)
+	{
+		std::map<const Module*, std::uint32_t> positions;
+		std::vector<Node> nodes;
+		Flatten(root, positions, nodes);
+		return nodes;
+	}
+
+	/// Appends a little-endian unsigned integer to a buffer.
+	void AppendUint(std::string& buffer, std::uint64_t n, int byteCount)
+	{
+		for (int i = 0; i < byteCount; i++)
+		{
+			buffer.push_back((char)((n >> (8 * i)) & 0xff));
+		}
+	}
+
+	/// Appends a little-endian double to a buffer.
+	void AppendDouble(std::string& buffer, double n)
+	{
+		std::uint64_t bits;
+		std::memcpy(&bits, &n, sizeof(bits));
+		AppendUint(buffer, bits, 8);
+	}
+
+	/// Encodes a graph in binary format.
+	std::string EncodeGraph(const Module& root)
+	{
+		std::vector<Node> nodes = Flatten(root);
+
+		// Class names are stored once; each Noise module refers to its class
+		// by position, which keeps the format independent of the classes
+		// known to a particular version of libnoise.
+		std::vector<std::string> classNames;
+		std::map<std::string, int> classPositions;
+		for (const Node& node : nodes)
+		{
+			const std::string& className = node.description.className;
+			if (classPositions.find(className) == classPositions.end())
+			{
+				classPositions[className] = (int)classNames.size();
+				classNames.push_back(className);
+			}
+		}
+
+		std::string buffer(GRAPH_MAGIC, sizeof(GRAPH_MAGIC));
+		AppendUint(buffer, GRAPH_FORMAT_VERSION, 4);
+		AppendUint(buffer, classNames.size(), 4);
+		for (const std::string& className : classNames)
+		{
+			AppendUint(buffer, className.size(), 1);
+			buffer += className;
+		}
+		AppendUint(buffer, nodes.size(), 4);
+		for (const Node& node : nodes)
+		{
+			const ModuleDescription& description = node.description;
+			AppendUint(buffer, classPositions[description.className], 1);
+			AppendUint(buffer, node.sources.size(), 1);
+			for (std::uint32_t source : node.sources)
+			{
+				AppendUint(buffer, source, 4);
+			}
+			AppendUint(buffer, description.parameters.size(), 1);
+			for (const auto& parameter : description.parameters)
+			{
+				AppendDouble(buffer, parameter.second);
+			}
+			AppendUint(buffer, description.controlPoints.size(), 4);
+			for (double point : description.controlPoints)
+			{
+				AppendDouble(buffer, point);
+			}
+		}
+		return buffer;
+	}
+
+	/// Reads values from a graph in binary format.
+	class BinaryReader
+	{
+
+	public:
+
+		explicit BinaryReader(const std::string& buffer):
+			m_buffer(buffer),
+			m_position(0)
+		{
+		}
+
+		/// Reads a little-endian unsigned integer.
+		std::uint64_t ReadUint(int byteCount)
+		{
+			Require(byteCount);
+			std::uint64_t n = 0;
+			for (int i = 0; i < byteCount; i++)
+			{
+				n |= (std::uint64_t)(unsigned char)m_buffer[m_position++]
+					<< (8 * i);
+			}
+			return n;
+		}
+
+		/// Reads the number of records that follow, each taking at least
+		/// @a recordSize bytes.
+		///
+		/// The count is checked against the bytes that remain, so that a
+		/// corrupt count is reported before anything is allocated for the
+		/// records.
+		std::uint64_t ReadCount(int byteCount, size_t recordSize)
+		{
+			std::uint64_t count = ReadUint(byteCount);
+			if (count > (m_buffer.size() - m_position) / recordSize)
+			{
+				throw noise::ExceptionInvalidFormat();
+			}
+			return count;
+		}
+
+		/// Reads a little-endian double.
+		double ReadDouble()
+		{
+			std::uint64_t bits = ReadUint(8);
+			double n;
+			std::memcpy(&n, &bits, sizeof(n));
+			return n;
+		}
+
+		/// Reads a string of a known length.
+		std::string ReadString(size_t length)
+		{
+			Require(length);
+			std::string text = m_buffer.substr(m_position, length);
+			m_position += length;
+			return text;
+		}
+
+	private:
+
+		/// Checks that enough bytes remain in the buffer.
+		void Require(size_t byteCount) const
+		{
+			if (m_buffer.size() - m_position < byteCount)
+			{
+				throw noise::ExceptionInvalidFormat();
+			}
+		}
+
+		/// The encoded graph.
+		const std::string& m_buffer;
+
+		/// The position of the next byte to read.
+		size_t m_position;
+
+	};
+
+	/// Creates a Noise module and connects it to previously created Noise
+	/// modules.
+	void AddModule(const ModuleDescription& description,
+		const std::vector<std::uint32_t>& sources,
+		std::vector<std::unique_ptr<Module>>& modules)
+	{
+		std::unique_ptr<Module> pModule;
+		try
+		{
+			pModule = CreateModule(description);
+		}
+		catch (noise::ExceptionInvalidParam&)
+		{
+			throw noise::ExceptionInvalidFormat();
+		}
+
+		// Source modules must come first, which also rules out cycles.
+		if ((int)sources.size() != pModule->GetSourceModuleCount())
+		{
+			throw noise::ExceptionInvalidFormat();
+		}
+		for (int i = 0; i < (int)sources.size(); i++)
+		{
+			if (sources[i] >= modules.size())
+			{
+				throw noise::ExceptionInvalidFormat();
+			}
+			pModule->SetSourceModule(i, *modules[sources[i]]);
+		}
+		modules.push_back(std::move(pModule));
+	}
+
+	/// Decodes a graph in binary format.
+	std::vector<std::unique_ptr<Module>> DecodeGraph(const std::string& buffer)
+	{
+		BinaryReader reader(buffer);
+		if (reader.ReadString(sizeof(GRAPH_MAGIC))
+			!= std::string(GRAPH_MAGIC, sizeof(GRAPH_MAGIC))
+			|| reader.ReadUint(4) != GRAPH_FORMAT_VERSION)
+		{
+			throw noise::ExceptionInvalidFormat();
+		}
+
+		// Look up the parameter names of each class once.  Each class name
+		// is preceded by its length.
+		std::vector<ModuleDescription> classes(reader.ReadCount(4, 1));
+		for (ModuleDescription& description : classes)
+		{
+			description.className = reader.ReadString(reader.ReadUint(1));
+			try
+			{
+				DescribeModule(*CreateModule(description), description);
+			}
+			catch (noise::ExceptionInvalidParam&)
+			{
+				throw noise::ExceptionInvalidFormat();
+			}
+		}
+
+		std::vector<std::unique_ptr<Module>> modules;
+		// Each Noise module holds at least its class, its source count, its
+		// parameter count and its control point count.
+		std::uint64_t moduleCount = reader.ReadCount(4, 7);
+		for (std::uint64_t i = 0; i < moduleCount; i++)
+		{
+			std::uint64_t classPosition = reader.ReadUint(1);
+			if (classPosition >= classes.size())
+			{
+				throw noise::ExceptionInvalidFormat();
+			}
+			ModuleDescription description = classes[classPosition];
+
+			std::vector<std::uint32_t> sources(reader.ReadCount(1, 4));
+			for (std::uint32_t& source : sources)
+			{
+				source = (std::uint32_t)reader.ReadUint(4);
+			}
+			if (reader.ReadUint(1) != description.parameters.size())
+			{
+				throw noise::ExceptionInvalidFormat();
+			}
+			for (auto& parameter : description.parameters)
+			{
+				parameter.second = reader.ReadDouble();
+			}
+			description.controlPoints.clear();
+			std::uint64_t pointCount = reader.ReadCount(4, 8);
+			description.controlPoints.reserve((size_t)pointCount);
+			for (std::uint64_t j = 0; j < pointCount; j++)
+			{
+				description.controlPoints.push_back(reader.ReadDouble());
+			}
+			AddModule(description, sources, modules);
+		}
+		return modules;
+	}
+
+	/// Formats a number with the fewest digits that read back exactly.
+	std::string FormatNumber(double n)
+	{
+		std::ostringstream os;
+		os.imbue(std::locale::classic());
+		for (int precision = 15; precision <= 17; precision++)
+		{
+			os.str("");
+			os.precision(precision);
+			os << n;
+			if (std::strtod(os.str().c_str(), nullptr) == n)
+			{
+				break;
+			}
+		}
+		return os.str();
+	}
+
+	/// Parses a number written by the WriteGraphText() function.
+	double ParseNumber(const std::string& text)
+	{
+		std::istringstream is(text);
+		is.imbue(std::locale::classic());
+		double n;
+		is >> n;
+		if (is.fail() || !is.eof())
+		{
+			// Infinite and NaN values are not handled by stream extraction.
+			char* pEnd;
+			n = std::strtod(text.c_str(), &pEnd);
+			if (text.empty() || *pEnd != '\0')
+			{
+				throw noise::ExceptionInvalidFormat();
+			}
+		}
+		return n;
+	}
+
+	/// Parses a comma-separated list of numbers.
+	std::vector<double> ParseList(const std::string& text)
+	{
+		std::vector<double> numbers;
+		std::istringstream is(text);
+		std::string item;
+		while (std::getline(is, item, ','))
+		{
+			numbers.push_back(ParseNumber(item));
+		}
+		return numbers;
+	}
+
+	/// Decodes a graph in text format.
+	std::vector<std::unique_ptr<Module>> DecodeGraphText(
+		const std::string& buffer)
+	{
+		std::istringstream is(buffer);
+		std::string line;
+		std::string magic;
+		std::uint32_t version = 0;
+		if (!std::getline(is, line)
+			|| !(std::istringstream(line) >> magic >> version)
+			|| magic != GRAPH_TEXT_MAGIC || version != GRAPH_FORMAT_VERSION)
+		{
+			throw noise::ExceptionInvalidFormat();
+		}
+
+		std::vector<std::unique_ptr<Module>> modules;
+		while (std::getline(is, line))
+		{
+			std::istringstream lineStream(line);
+			std::string position;
+			ModuleDescription description;
+			if (!(lineStream >> position))
+			{
+				continue;
+			}
+			if (!(lineStream >> description.className)
+				|| ParseNumber(position) != (double)modules.size())
+			{
+				throw noise::ExceptionInvalidFormat();
+			}
+
+			std::vector<std::uint32_t> sources;
+			std::string token;
+			while (lineStream >> token)
+			{
+				size_t equals = token.find('=');
+				if (equals == std::string::npos)
+				{
+					throw noise::ExceptionInvalidFormat();
+				}
+				std::string name = token.substr(0, equals);
+				std::string value = token.substr(equals + 1);
+				if (name == "sources")
+				{
+					for (double source : ParseList(value))
+					{
+						if (!(source >= 0.0 && source < (double)modules.size()))
+						{
+							throw noise::ExceptionInvalidFormat();
+						}
+						sources.push_back((std::uint32_t)source);
+					}
+				}
+				else if (name == "points")
+				{
+					description.controlPoints = ParseList(value);
+				}
+				else
+				{
+					description.parameters.emplace_back(name, ParseNumber(value));
+				}
+			}
+			AddModule(description, sources, modules);
+		}
+		return modules;
+	}
+
+}
+
+ModuleGraph::ModuleGraph(std::vector<std::unique_ptr<Module>> modules):
+	m_modules(std::move(modules))
+{
+}
+
+std::uint64_t noise::HashGraph(const Module& root)
+{
+	std::string buffer = EncodeGraph(root);
+	std::uint64_t hash = 0xcbf29ce484222325ULL;
+	for (char c : buffer)
+	{
+		hash ^= (unsigned char)c;
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+std::unique_ptr<ModuleGraph> noise::ReadGraph(std::istream& is)
+{
+	std::string buffer((std::istreambuf_iterator<char>(is)),
+		std::istreambuf_iterator<char>());
+
+	std::vector<std::unique_ptr<Module>> modules;
+	if (buffer.compare(0, sizeof(GRAPH_MAGIC), GRAPH_MAGIC,
+		sizeof(GRAPH_MAGIC)) == 0)
+	{
+		modules = DecodeGraph(buffer);
+	}
+	else
+	{
+		modules = DecodeGraphText(buffer);
+	}
+
+	if (modules.empty())
+	{
+		throw noise::ExceptionInvalidFormat();
+	}
+	return std::make_unique<ModuleGraph>(std::move(modules));
+}
+
+void noise::WriteGraph(std::ostream& os, const Module& root)
+{
+	std::string buffer = EncodeGraph(root);
+	os.write(buffer.data(), (std::streamsize)buffer.size());
+}
+
+void noise::WriteGraphText(std::ostream& os, const Module& root)
+{
+	std::vector<Node> nodes = Flatten(root);
+
+	std::ostringstream text;
+	text << GRAPH_TEXT_MAGIC << ' ' << GRAPH_FORMAT_VERSION << '\n';
+	for (size_t i = 0; i < nodes.size(); i++)
+	{
+		const ModuleDescription& description = nodes[i].description;
+		text << i << ' ' << description.className;
+		for (size_t j = 0; j < nodes[i].sources.size(); j++)
+		{
+			text << (j == 0 ? " sources=" : ",") << nodes[i].sources[j];
+		}
+		for (const auto& parameter : description.parameters)
+		{
+			text << ' ' << parameter.first << '=' << FormatNumber(parameter.second);
+		}
+		for (size_t j = 0; j < description.controlPoints.size(); j++)
+		{
+			text << (j == 0 ? " points=" : ",")
+				<< FormatNumber(description.controlPoints[j]);
+		}
+		text << '\n';
+	}
+	os << text.str();
+}
@@ -0,0 +1,164 @@
+// threadstate.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (License.md) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#include <unordered_map>
+#include "noise/threadstate.h"
+
+using namespace noise;
+
+namespace
+{
+
+	/// Protects the registry.
+	std::mutex s_registryMutex;
+
+	/// Every ThreadState object that exists, by identifier.
+	std::unordered_map<std::uint64_t, ThreadStateBase*>& GetRegistry()
+	{
+		static std::unordered_map<std::uint64_t, ThreadStateBase*> s_registry;
+		return s_registry;
+	}
+
+	/// The last identifier assigned to a ThreadState object.
+	std::uint64_t s_lastId = 0;
+
+	/// Returns a new identifier.
+	///
+	/// The caller holds the registry mutex.
+	std::uint64_t NextId()
+	{
+		return ++s_lastId;
+	}
+
+}
+
+struct ThreadStateBase::ThreadEntries
+{
+
+	/// Releases the copies of the thread in the ThreadState objects that
+	/// still exist.
+	~ThreadEntries()
+	{
+		std::lock_guard<std::mutex> lock(s_registryMutex);
+		auto& registry = GetRegistry();
+		for (const auto& entry : entries)
+		{
+			auto owner = registry.find(entry.first);
+			if (owner != registry.end())
+			{
+				owner->second->Release(entry.second);
+			}
+		}
+	}
+
+	/// The copy of the thread in each ThreadState object, by identifier.
+	std::unordered_map<std::uint64_t, void*> entries;
+
+	/// The smallest number of entries that triggers a sweep.
+	static constexpr size_t MIN_SWEEP_SIZE = 16;
+
+	/// The number of entries at which the entries of destroyed ThreadState
+	/// objects are next removed.
+	size_t sweepSize = MIN_SWEEP_SIZE;
+
+	/// Entries recently looked up by the thread.
+	Entry recent[RECENT_ENTRY_COUNT];
+
+};
+
+ThreadStateBase::ThreadStateBase():
+	m_id([] {
+		std::lock_guard<std::mutex> lock(s_registryMutex);
+		return NextId();
+	}()),
+	m_isRegistered(true)
+{
+	std::lock_guard<std::mutex> lock(s_registryMutex);
+	GetRegistry()[m_id] = this;
+}
+
+ThreadStateBase::~ThreadStateBase()
+{
+	Unregister();
+}
+
+void* ThreadStateBase::FindEntry() const
+{
+	ThreadEntries& threadEntries = GetThreadEntries();
+	auto pos = threadEntries.entries.find(m_id);
+	return pos != threadEntries.entries.end()? pos->second: nullptr;
+}
+
+ThreadStateBase::ThreadEntries& ThreadStateBase::GetThreadEntries()
+{
+	thread_local ThreadEntries t_entries;
+	return t_entries;
+}
+
+void ThreadStateBase::InsertEntry(void* pState) const
+{
+	ThreadEntries& threadEntries = GetThreadEntries();
+	threadEntries.entries[m_id] = pState;
+
+	// A destroyed ThreadState object leaves its entry behind in every
+	// thread that looked it up, and threads such as the workers of a
+	// Noise::TaskScheduler may never exit.  Each time the index doubles,
+	// the entries of the objects that left the registry are removed, which
+	// keeps the index proportional to the objects that still exist at a
+	// constant cost per insertion.
+	if (threadEntries.entries.size() >= threadEntries.sweepSize)
+	{
+		std::lock_guard<std::mutex> lock(s_registryMutex);
+		auto& registry = GetRegistry();
+		for (auto pos = threadEntries.entries.begin();
+			pos != threadEntries.entries.end(); )
+		{
+			if (registry.find(pos->first) == registry.end())
+			{
+				pos = threadEntries.entries.erase(pos);
+			}
+			else
+			{
+				++pos;
+			}
+		}
+		threadEntries.sweepSize = std::max(ThreadEntries::MIN_SWEEP_SIZE,
+			2 * threadEntries.entries.size());
+	}
+}
+
+ThreadStateBase::Entry& ThreadStateBase::RecentEntry() const
+{
+	return GetThreadEntries().recent[m_id % RECENT_ENTRY_COUNT];
+}
+
+void ThreadStateBase::Unregister()
+{
+	// Once this object has left the registry, exiting threads no longer
+	// release their copies into it.
+	if (m_isRegistered)
+	{
+		std::lock_guard<std::mutex> lock(s_registryMutex);
+		GetRegistry().erase(m_id);
+		m_isRegistered = false;
+	}
+}
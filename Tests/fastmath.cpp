@@ -0,0 +1,149 @@
+// Checks the error bounds documented in fastmath.h against the C library,
+// evaluated in extended precision.
+
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <noise/fastmath.h>
+
+using namespace noise;
+
+namespace
+{
+
+	int failureCount = 0;
+
+	// Records a failure if the error exceeds its bound.
+	void Check(const char* name, double x, double y, long double error,
+		long double bound)
+	{
+		if (!(error <= bound))
+		{
+			if (failureCount < 20)
+			{
+				std::printf("%s (%.17g, %.17g): error %Lg exceeds %Lg\n", name,
+					x, y, error, bound);
+			}
+			failureCount++;
+		}
+	}
+
+	void CheckExp(double x)
+	{
+		long double expected = expl((long double)x);
+		long double error = fabsl(FastExp(x) - expected) / expected;
+		Check("FastExp", x, 0.0, error, FAST_EXP_MAX_ERROR);
+	}
+
+	void CheckLog(double x)
+	{
+		long double expected = logl((long double)x);
+		long double error = fabsl(FastLog(x) - expected);
+		Check("FastLog", x, 0.0, error,
+			FAST_LOG_MAX_ERROR * (1.0L + fabsl(expected)));
+	}
+
+	void CheckSinCos(double angle)
+	{
+		double sinValue, cosValue;
+		FastSinCos(angle, sinValue, cosValue);
+		Check("FastSinCos", angle, 0.0,
+			fabsl(sinValue - sinl((long double)angle)), FAST_SINCOS_MAX_ERROR);
+		Check("FastSinCos", angle, 0.0,
+			fabsl(cosValue - cosl((long double)angle)), FAST_SINCOS_MAX_ERROR);
+	}
+
+	void CheckPow(double base, double exponent)
+	{
+		long double expected = powl((long double)base, (long double)exponent);
+		if (expected == 0.0L || !std::isfinite((double)expected))
+		{
+			return;
+		}
+		long double y = (long double)exponent * logl((long double)base);
+		long double error = fabsl(FastPow(base, exponent) - expected)
+			/ expected;
+		Check("FastPow", base, exponent, error,
+			FAST_POW_MAX_ERROR * (1.0L + fabsl(y)));
+
+		// The ranges calculated by Noise modules are widened by
+		// MathPowError(), so it must cover the difference from pow().
+		double libValue = pow(base, exponent);
+		Check("MathPowError", base, exponent,
+			fabsl((long double)MathPow(base, exponent) - libValue),
+			MathPowError(base, exponent) * fabs(libValue)
+				+ 2.0 * DBL_EPSILON * fabs(libValue));
+	}
+
+}
+
+int main()
+{
+	std::mt19937_64 generator(12345);
+	std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+	for (int i = 0; i < 200000; i++)
+	{
+		CheckExp((2.0 * unit(generator) - 1.0) * (FAST_EXP_MAX_ARGUMENT - 1.0));
+	}
+
+	// The reduced mantissa is furthest from one, and the error of the
+	// polynomial largest, near sqrt (2) and sqrt (0.5).
+	const double mantissas[] = {1.0, 1.41421, 1.4142135623730951,
+		0.70710678118654757, 0.70711, 1.0000001, 0.9999999};
+	for (int i = 0; i < 200000; i++)
+	{
+		double x = std::ldexp(0.5 + unit(generator), (int)(unit(generator)
+			* 2000.0) - 1000);
+		CheckLog(x);
+	}
+	for (double mantissa : mantissas)
+	{
+		for (int e = -1020; e <= 1020; e += 5)
+		{
+			CheckLog(std::ldexp(mantissa, e));
+		}
+	}
+
+	for (int i = 0; i < 200000; i++)
+	{
+		CheckSinCos((2.0 * unit(generator) - 1.0) * FAST_SINCOS_MAX_ANGLE);
+		CheckSinCos((2.0 * unit(generator) - 1.0) * 10.0);
+	}
+
+	for (int i = 0; i < 200000; i++)
+	{
+		double base = std::ldexp(0.5 + unit(generator), (int)(unit(generator)
+			* 60.0) - 30);
+		double maxExponent = (FAST_EXP_MAX_ARGUMENT - 1.0) / fabs(log(base));
+		double exponent = (2.0 * unit(generator) - 1.0)
+			* std::fmin(maxExponent, 1.0e6);
+		CheckPow(base, exponent);
+	}
+	for (double mantissa : mantissas)
+	{
+		for (int e = -4; e <= 4; e++)
+		{
+			double base = std::ldexp(mantissa, e);
+			if (base == 1.0)
+			{
+				continue;
+			}
+			double maxExponent = (FAST_EXP_MAX_ARGUMENT - 1.0)
+				/ fabs(log(base));
+			for (int step = -100; step <= 100; step++)
+			{
+				CheckPow(base, maxExponent * step / 100.0);
+			}
+		}
+	}
+
+	if (failureCount > 0)
+	{
+		std::printf("%d checks failed\n", failureCount);
+		return 1;
+	}
+	std::printf("All checks passed\n");
+	return 0;
+}
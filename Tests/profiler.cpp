@@ -0,0 +1,85 @@
+// Checks that an instrumented graph is planned by RasterExecutor into the
+// same steps as the original graph and generates the same output values.
+
+#include <cstdio>
+#include <vector>
+#include <noise/noise.h>
+
+using namespace noise;
+
+int main()
+{
+	int failureCount = 0;
+
+	module::Perlin continents;
+	module::RidgedMulti mountains;
+	module::Billow plains;
+	module::ScaleBias flatPlains;
+	flatPlains.SetSourceModule(0, plains);
+	flatPlains.SetScale(0.25);
+	module::Select terrain;
+	terrain.SetSourceModule(0, flatPlains);
+	terrain.SetSourceModule(1, mountains);
+	terrain.SetControlModule(continents);
+	terrain.SetBounds(0.0, 1000.0);
+	terrain.SetEdgeFalloff(0.125);
+	module::Add root;
+	root.SetSourceModule(0, terrain);
+	root.SetSourceModule(1, continents);
+
+	Profiler profiler;
+	const module::Module& instrumented = profiler.Instrument(root);
+
+	RasterExecutor executor(root);
+	RasterExecutor instrumentedExecutor(instrumented);
+
+	const int count = 256;
+	std::vector<double> x(count), y(count), z(count);
+	for (int i = 0; i < count; i++)
+	{
+		x[i] = 0.5 + 2.0 * i / count;
+		y[i] = 0.25;
+		z[i] = 1.5 - 1.0 * i / count;
+	}
+	std::vector<double> expected(count), actual(count);
+	executor.GetValues(count, x.data(), y.data(), z.data(), expected.data());
+	instrumentedExecutor.GetValues(count, x.data(), y.data(), z.data(),
+		actual.data());
+
+	if (instrumentedExecutor.GetStepCount() != executor.GetStepCount())
+	{
+		std::printf("instrumented graph: %d steps instead of %d\n",
+			instrumentedExecutor.GetStepCount(), executor.GetStepCount());
+		failureCount++;
+	}
+	for (int i = 0; i < count; i++)
+	{
+		if (actual[i] != expected[i])
+		{
+			std::printf("instrumented graph: value %d is %.17g instead of "
+				"%.17g\n", i, actual[i], expected[i]);
+			failureCount++;
+			break;
+		}
+	}
+
+	// Every step of the plan is timed, including the pointwise ones.
+	if (Profiler::IsEnabled())
+	{
+		for (const ProfileRecord& record : profiler.GetRecords())
+		{
+			if (record.callCount == 0 || record.sampledCallCount == 0)
+			{
+				std::printf("%s: not timed\n", record.name.c_str());
+				failureCount++;
+			}
+		}
+	}
+
+	if (failureCount > 0)
+	{
+		return 1;
+	}
+	std::printf("All checks passed\n");
+	return 0;
+}
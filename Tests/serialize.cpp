@@ -0,0 +1,95 @@
+// Checks that the graph reader rejects corrupt binary graphs with
+// Noise::ExceptionInvalidFormat.
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <noise/noise.h>
+#include <noise/serialize.h>
+
+using namespace noise;
+
+namespace
+{
+
+	int failureCount = 0;
+
+	// Reads a buffer and records a failure unless it is rejected as an
+	// invalid format.
+	void CheckRejected(const char* name, const std::string& buffer)
+	{
+		std::istringstream is(buffer);
+		try
+		{
+			ReadGraph(is);
+			std::printf("%s: accepted\n", name);
+		}
+		catch (noise::ExceptionInvalidFormat&)
+		{
+			return;
+		}
+		catch (...)
+		{
+			std::printf("%s: wrong exception\n", name);
+		}
+		failureCount++;
+	}
+
+	// Overwrites a 32-bit little-endian count within a buffer.
+	std::string SetCount(std::string buffer, size_t position,
+		std::uint32_t count)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			buffer[position + i] = (char)((count >> (8 * i)) & 0xff);
+		}
+		return buffer;
+	}
+
+}
+
+int main()
+{
+	module::Perlin perlin;
+	module::Curve curve;
+	curve.SetSourceModule(0, perlin);
+	curve.AddControlPoint(-1.0, -1.0);
+	curve.AddControlPoint(0.0, 0.5);
+	curve.AddControlPoint(0.5, 0.6);
+	curve.AddControlPoint(1.0, 1.0);
+
+	std::ostringstream os;
+	WriteGraph(os, curve);
+	std::string buffer = os.str();
+
+	std::istringstream is(buffer);
+	if (ReadGraph(is)->GetRoot().GetValue(0.5, 0.25, 0.75)
+		!= curve.GetValue(0.5, 0.25, 0.75))
+	{
+		std::printf("round trip: different output value\n");
+		failureCount++;
+	}
+
+	// The class count follows the magic bytes and the format version.
+	CheckRejected("class count", SetCount(buffer, 8, 0xffffffff));
+
+	// The control point count is the last count of the root, which is
+	// followed by its eight control values.
+	size_t pointCountPosition = buffer.size() - 8 * 8 - 4;
+	CheckRejected("point count", SetCount(buffer, pointCountPosition,
+		0xffffffff));
+	CheckRejected("point count", SetCount(buffer, pointCountPosition, 9));
+
+	for (size_t length = 0; length < buffer.size(); length++)
+	{
+		CheckRejected("truncated", buffer.substr(0, length));
+	}
+
+	if (failureCount > 0)
+	{
+		std::printf("%d checks failed\n", failureCount);
+		return 1;
+	}
+	std::printf("All checks passed\n");
+	return 0;
+}
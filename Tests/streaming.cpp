@@ -0,0 +1,95 @@
+// Checks that a cancelled streaming build aborts its sink, so that the
+// sink can be used again by the next build.
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <noise/noise.h>
+#include <noiseutils.h>
+
+using namespace noise;
+using namespace noise::utils;
+
+namespace
+{
+
+	// Cancels the build once its first tile is complete.
+	void CancelBuild(const BuildProgress& progress)
+	{
+		if (progress.completedPointCount < progress.totalPointCount)
+		{
+			((CancellationToken*)progress.pContext)->Cancel();
+		}
+	}
+
+	std::string ReadFile(const char* filename)
+	{
+		std::ifstream is(filename, std::ios::binary);
+		return std::string(std::istreambuf_iterator<char>(is),
+			std::istreambuf_iterator<char>());
+	}
+
+}
+
+int main()
+{
+	const char* streamedFilename = "streaming_streamed.ter";
+	const char* wholeFilename = "streaming_whole.ter";
+	int failureCount = 0;
+
+	module::Perlin perlin;
+	NoiseMap noiseMap, strip;
+	NoiseMapBuilderPlane builder;
+	builder.SetSourceModule(perlin);
+	builder.SetBounds(0.0, 4.0, 0.0, 4.0);
+	builder.SetDestSize(256, 256);
+	builder.SetDestNoiseMap(noiseMap);
+	builder.Build();
+
+	WriterTER wholeWriter;
+	wholeWriter.SetSourceNoiseMap(noiseMap);
+	wholeWriter.SetDestFilename(wholeFilename);
+	wholeWriter.WriteDestFile();
+
+	WriterTER writer;
+	writer.SetDestFilename(streamedFilename);
+	CancellationToken token;
+	builder.SetDestNoiseMap(strip);
+	builder.SetDestSink(&writer, 64);
+	builder.SetCancellationToken(&token);
+	builder.SetProgressCallback(CancelBuild, &token);
+	try
+	{
+		builder.Build();
+		std::printf("cancelled build: completed\n");
+		failureCount++;
+	}
+	catch (noise::ExceptionCancelled&)
+	{
+	}
+	if (std::ifstream(streamedFilename))
+	{
+		std::printf("cancelled build: incomplete file left behind\n");
+		failureCount++;
+	}
+
+	token.Reset();
+	builder.SetProgressCallback(NULL);
+	builder.Build();
+	if (ReadFile(streamedFilename) != ReadFile(wholeFilename))
+	{
+		std::printf("build after cancellation: different file\n");
+		failureCount++;
+	}
+
+	std::remove(streamedFilename);
+	std::remove(wholeFilename);
+	if (failureCount > 0)
+	{
+		std::printf("%d checks failed\n", failureCount);
+		return 1;
+	}
+	std::printf("All checks passed\n");
+	return 0;
+}
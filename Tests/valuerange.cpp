@@ -0,0 +1,144 @@
+// Checks that the value ranges of the generator modules contain their
+// output values, and that a Select module controlled by a Perlin module
+// skips the source module it does not select on a small tile.
+
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <noise/noise.h>
+
+using namespace noise;
+
+namespace
+{
+
+	// Counts the output values requested from it.
+	class CountingModule: public module::Const
+	{
+
+	public:
+
+		void GetValues(int count, const double* x, const double* y,
+			const double* z, double* out) const override
+		{
+			m_valueCount += count;
+			module::Const::GetValues(count, x, y, z, out);
+		}
+
+		mutable int m_valueCount = 0;
+
+	};
+
+	// Checks that the range of a generator module over random boxes contains
+	// its output values at random points within each box.
+	int CheckRanges(const char* name, const module::Module& module)
+	{
+		std::mt19937 random(1);
+		std::uniform_real_distribution<double> unit(0.0, 1.0);
+		for (int i = 0; i < 2000; i++)
+		{
+			double size = 0.001 * (1 + i % 1000);
+			double x = 100.0 * unit(random) - 50.0;
+			double y = 100.0 * unit(random) - 50.0;
+			double z = 100.0 * unit(random) - 50.0;
+			Box box = {{x, x + size}, {y, y + size}, {z, z + size}};
+			Interval range = module.GetValueRange(box);
+			for (int j = 0; j < 20; j++)
+			{
+				double value = module.GetValue(x + size * unit(random),
+					y + size * unit(random), z + size * unit(random));
+				if (!(value >= range.lower && value <= range.upper))
+				{
+					std::printf("%s: %.17g outside [%.17g, %.17g]\n", name,
+						value, range.lower, range.upper);
+					return 1;
+				}
+			}
+		}
+		return 0;
+	}
+
+}
+
+int main()
+{
+	int failureCount = 0;
+
+	module::Perlin perlin;
+	module::Billow billow;
+	module::RidgedMulti ridgedMulti;
+	module::Voronoi voronoi;
+	voronoi.EnableDistance(true);
+	voronoi.SetDisplacement(0.0);
+	module::Spheres spheres;
+	module::Cylinders cylinders;
+	module::Checkerboard checkerboard;
+	failureCount += CheckRanges("Perlin", perlin);
+	failureCount += CheckRanges("Billow", billow);
+	failureCount += CheckRanges("RidgedMulti", ridgedMulti);
+	failureCount += CheckRanges("Voronoi", voronoi);
+	failureCount += CheckRanges("Spheres", spheres);
+	failureCount += CheckRanges("Cylinders", cylinders);
+	failureCount += CheckRanges("Checkerboard", checkerboard);
+
+	// Find a small tile that lies entirely in the mountains.
+	CountingModule ocean, mountains;
+	ocean.SetConstValue(-1.0);
+	mountains.SetConstValue(1.0);
+	module::Select terrain;
+	terrain.SetSourceModule(0, ocean);
+	terrain.SetSourceModule(1, mountains);
+	terrain.SetControlModule(perlin);
+	terrain.SetBounds(0.0, 1000.0);
+
+	const int count = 64;
+	const double tileSize = 0.01;
+	double xOrigin = 0.0;
+	while (perlin.GetValue(xOrigin, 0.5, 0.5) < 0.5)
+	{
+		xOrigin += 0.125;
+	}
+	std::vector<double> x(count), y(count), z(count), out(count);
+	for (int i = 0; i < count; i++)
+	{
+		x[i] = xOrigin + tileSize * (i % 8) / 8;
+		y[i] = 0.5 + tileSize * (i / 8) / 8;
+		z[i] = 0.5;
+	}
+
+	Box box = MakeBoundingBox(count, x.data(), y.data(), z.data());
+	bool isNeeded[3];
+	terrain.GetNeededSources(box, isNeeded);
+	if (isNeeded[0] || !isNeeded[1] || isNeeded[2])
+	{
+		std::printf("Select: needed sources %d %d %d instead of 0 1 0\n",
+			isNeeded[0], isNeeded[1], isNeeded[2]);
+		failureCount++;
+	}
+
+	RasterExecutor executor(terrain);
+	executor.GetValues(count, x.data(), y.data(), z.data(), out.data());
+	if (ocean.m_valueCount != 0)
+	{
+		std::printf("Select: unselected source evaluated for %d values\n",
+			ocean.m_valueCount);
+		failureCount++;
+	}
+	for (int i = 0; i < count; i++)
+	{
+		if (out[i] != terrain.GetValue(x[i], y[i], z[i]))
+		{
+			std::printf("Select: value %d is %.17g instead of %.17g\n", i,
+				out[i], terrain.GetValue(x[i], y[i], z[i]));
+			failureCount++;
+			break;
+		}
+	}
+
+	if (failureCount > 0)
+	{
+		return 1;
+	}
+	std::printf("All checks passed\n");
+	return 0;
+}
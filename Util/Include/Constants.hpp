@@ -15,8 +15,15 @@ namespace noise::utils
 	// The raster's stride length must be a multiple of this constant.
 	const int RASTER_STRIDE_BOUNDARY = 4;
 
+	// The base-2 logarithm of TILED_NOISE_MAP_TILE_SIZE.
+	const int TILED_NOISE_MAP_TILE_SHIFT = 8;
+
 #endif
 
+	/// The width and height of each tile of a TiledNoiseMap object, in
+	/// points.
+	const int TILED_NOISE_MAP_TILE_SIZE = 256;
+
 	/// Number of meters per point in a Terragen terrain (TER) file.
 	const double DEFAULT_METERS_PER_POINT = 30.0;
 
@@ -0,0 +1,421 @@
+
+#ifndef NOISE_TILEDNOISEMAP_HPP
+#define NOISE_TILEDNOISEMAP_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <NoiseMap.hpp>
+#include <Constants.hpp>
+
+namespace noise::utils
+{
+	/// Implements a tiled Noise map, a 2-dimensional array of floating-point
+	/// values that may be much larger than a NoiseMap object.
+	///
+	/// A NoiseMap object stores its values in a single buffer, and its width
+	/// and height cannot exceed Noise::utils::RASTER_MAX_WIDTH and
+	/// Noise::utils::RASTER_MAX_HEIGHT.  A tiled Noise map has 64-bit
+	/// dimensions instead, and stores its values in square tiles of
+	/// Noise::utils::TILED_NOISE_MAP_TILE_SIZE points on a side.  The values
+	/// of each tile are contiguous in memory, so the values near a point
+	/// share the same few cache lines whatever the width of the Noise map.
+	///
+	/// <b>Lazy Allocation</b>
+	///
+	/// A tile is only allocated the first time one of its values is
+	/// written.  Until then, every value within the tile is equal to the
+	/// <i>fill value</i> passed to the Clear() method.  A large Noise map
+	/// that is only partially written only uses the memory of the tiles that
+	/// were written.  Several threads may write to a tiled Noise map at once
+	/// as long as they write to different positions; the first thread to
+	/// write to a tile allocates it.
+	///
+	/// <b>Border Values</b>
+	///
+	/// All of the values outside of the Noise map are assumed to have a
+	/// common value known as the <i>border value</i>.
+	///
+	/// To set the border value, call the SetBorderValue() method.
+	///
+	/// The GetValue() method returns the border value if the specified value
+	/// lies outside of the Noise map.
+	///
+	/// <b>Slabs</b>
+	///
+	/// As in a NoiseMap object, each row of the Noise map is called a
+	/// @a slab, but a slab is only contiguous within a tile.  The
+	/// GetSlabPtr() and GetConstSlabPtr() methods return a pointer to the
+	/// values of a row starting at a position, and the GetSlabLength() method
+	/// returns the number of values that the pointer may access.  To iterate
+	/// a whole row, advance the position by that number of values:
+	///
+	/// @code
+	/// for (std::int64_t x = 0; x < noiseMap.GetWidth(); ) {
+	///   std::int64_t length = noiseMap.GetSlabLength(x);
+	///   const float* pSource = noiseMap.GetConstSlabPtr(x, y);
+	///   // Process length values from pSource.
+	///   x += length;
+	/// }
+	/// @endcode
+	///
+	/// The CopyToNoiseMap() method copies a rectangular region of the tiled
+	/// Noise map into a NoiseMap object, so that it can be passed to any
+	/// class that accepts a NoiseMap object.
+	class TiledNoiseMap
+	{
+
+	public:
+
+		/// Constructor.
+		///
+		/// Creates an empty Noise map.
+		TiledNoiseMap();
+
+		/// Constructor.
+		///
+		/// @param width The width of the new Noise map.
+		/// @param height The height of the new Noise map.
+		///
+		/// @pre The width and height values are positive.
+		///
+		/// @throw Noise::ExceptionInvalidParam See the preconditions.
+		/// @throw Noise::ExceptionOutOfMemory Out of memory.
+		///
+		/// Creates a Noise map without allocating any tile; every value is
+		/// equal to zero.
+		TiledNoiseMap(std::int64_t width, std::int64_t height);
+
+		/// Copy constructor.
+		///
+		/// @throw Noise::ExceptionOutOfMemory Out of memory.
+		///
+		/// Only the tiles allocated in the source Noise map are allocated in
+		/// the new Noise map.
+		TiledNoiseMap(const TiledNoiseMap& rhs);
+
+		/// Destructor.
+		///
+		/// Frees the allocated memory for the Noise map.
+		~TiledNoiseMap();
+
+		/// Assignment operator.
+		///
+		/// @throw Noise::ExceptionOutOfMemory Out of memory.
+		///
+		/// @returns Reference to self.
+		///
+		/// Creates a copy of the Noise map.
+		TiledNoiseMap& operator=(const TiledNoiseMap& rhs);
+
+		/// Clears the Noise map to a specified value.
+		///
+		/// @param value The value that all positions within the Noise map are
+		/// cleared to.
+		///
+		/// This method frees every tile, so that the specified value becomes
+		/// the fill value of the Noise map.
+		void Clear(float value);
+
+		/// Copies a NoiseMap object into a region of the Noise map.
+		///
+		/// @param source The Noise map to copy.
+		/// @param x The x coordinate of the position that receives the
+		/// lower-left value of the source Noise map.
+		/// @param y The y coordinate of the position that receives the
+		/// lower-left value of the source Noise map.
+		///
+		/// @throw Noise::ExceptionOutOfMemory Out of memory.
+		///
+		/// The values of the source Noise map that lie outside of this Noise
+		/// map are ignored.
+		void CopyFromNoiseMap(const NoiseMap& source, std::int64_t x,
+			std::int64_t y);
+
+		/// Copies a region of the Noise map into a NoiseMap object.
+		///
+		/// @param dest The Noise map that receives the region.
+		/// @param x The x coordinate of the lower-left position of the region.
+		/// @param y The y coordinate of the lower-left position of the region.
+		/// @param width The width of the region.
+		/// @param height The height of the region.
+		///
+		/// @pre The width and height values are positive.
+		/// @pre The width and height values do not exceed the maximum
+		/// possible width and height for a NoiseMap object.
+		///
+		/// @throw Noise::ExceptionInvalidParam See the preconditions.
+		/// @throw Noise::ExceptionOutOfMemory Out of memory.
+		///
+		/// The destination Noise map is resized to the size of the region.
+		/// The positions of the region that lie outside of this Noise map
+		/// receive the border value, which also becomes the border value of
+		/// the destination Noise map.
+		void CopyToNoiseMap(NoiseMap& dest, std::int64_t x, std::int64_t y,
+			int width, int height) const;
+
+		/// Returns the number of tiles allocated for this Noise map.
+		///
+		/// @returns The number of allocated tiles.
+		std::int64_t GetAllocatedTileCount() const
+		{
+			return m_allocatedTileCount;
+		}
+
+		/// Returns the value used for all positions outside of the Noise map.
+		///
+		/// @returns The value used for all positions outside of the Noise
+		/// map.
+		///
+		/// All positions outside of the Noise map are assumed to have a
+		/// common value known as the <i>border value</i>.
+		float GetBorderValue() const
+		{
+			return m_borderValue;
+		}
+
+		/// Returns a const pointer to a slab at the specified position.
+		///
+		/// @param x The x coordinate of the position.
+		/// @param y The y coordinate of the position.
+		///
+		/// @returns A const pointer to a slab at the position ( @a x, @a y ).
+		/// The pointer may access the number of values returned by
+		/// GetSlabLength().
+		///
+		/// @pre The coordinates must exist within the bounds of the Noise
+		/// map.
+		///
+		/// This method does not allocate the tile that contains the
+		/// position.  If the tile is not allocated yet, the returned pointer
+		/// refers to a row of fill values instead.
+		///
+		/// This method does not perform bounds checking so be careful when
+		/// calling it.
+		const float* GetConstSlabPtr(std::int64_t x, std::int64_t y) const;
+
+		/// Returns the fill value of the tiles that are not allocated yet.
+		///
+		/// @returns The value of every position within a tile that has never
+		/// been written.
+		float GetFillValue() const
+		{
+			return m_fillValue;
+		}
+
+		/// Returns the height of the Noise map.
+		///
+		/// @returns The height of the Noise map.
+		std::int64_t GetHeight() const
+		{
+			return m_height;
+		}
+
+		/// Returns the amount of memory allocated for this Noise map.
+		///
+		/// @returns The amount of memory allocated for this Noise map.
+		///
+		/// This method returns the number of @a float values allocated for
+		/// the tiles, not including the table of tiles.
+		size_t GetMemUsed() const
+		{
+			return (size_t)m_allocatedTileCount
+				* TILED_NOISE_MAP_TILE_SIZE * TILED_NOISE_MAP_TILE_SIZE;
+		}
+
+		/// Returns a pointer to a slab at the specified position.
+		///
+		/// @param x The x coordinate of the position.
+		/// @param y The y coordinate of the position.
+		///
+		/// @returns A pointer to a slab at the position ( @a x, @a y ).  The
+		/// pointer may access the number of values returned by
+		/// GetSlabLength().
+		///
+		/// @pre The coordinates must exist within the bounds of the Noise
+		/// map.
+		///
+		/// @throw Noise::ExceptionOutOfMemory Out of memory.
+		///
+		/// This method allocates the tile that contains the position if it
+		/// is not allocated yet, and fills it with the fill value.
+		///
+		/// This method does not perform bounds checking so be careful when
+		/// calling it.
+		float* GetSlabPtr(std::int64_t x, std::int64_t y);
+
+		/// Returns the number of values that a slab pointer may access.
+		///
+		/// @param x The x coordinate of the position passed to GetSlabPtr()
+		/// or GetConstSlabPtr().
+		///
+		/// @returns The number of contiguous values from that position to the
+		/// right edge of its tile or of the Noise map, whichever is nearer.
+		std::int64_t GetSlabLength(std::int64_t x) const
+		{
+			std::int64_t tileLength = TILED_NOISE_MAP_TILE_SIZE
+				- (x & (TILED_NOISE_MAP_TILE_SIZE - 1));
+			return tileLength < m_width - x? tileLength: m_width - x;
+		}
+
+		/// Returns a value from the specified position in the Noise map.
+		///
+		/// @param x The x coordinate of the position.
+		/// @param y The y coordinate of the position.
+		///
+		/// @returns The value at that position.
+		///
+		/// This method returns the border value if the coordinates exist
+		/// outside of the Noise map.
+		float GetValue(std::int64_t x, std::int64_t y) const;
+
+		/// Returns the width of the Noise map.
+		///
+		/// @returns The width of the Noise map.
+		std::int64_t GetWidth() const
+		{
+			return m_width;
+		}
+
+		/// Determines if the tile that contains a position is allocated.
+		///
+		/// @param x The x coordinate of the position.
+		/// @param y The y coordinate of the position.
+		///
+		/// @returns
+		/// - @a true if the tile is allocated.
+		/// - @a false if the tile is not allocated, or if the position lies
+		///   outside of the Noise map.
+		bool IsTileAllocated(std::int64_t x, std::int64_t y) const;
+
+		/// Sets the value to use for all positions outside of the Noise map.
+		///
+		/// @param borderValue The value to use for all positions outside of
+		/// the Noise map.
+		///
+		/// All positions outside of the Noise map are assumed to have a
+		/// common value known as the <i>border value</i>.
+		void SetBorderValue(float borderValue)
+		{
+			m_borderValue = borderValue;
+		}
+
+		/// Sets the new size for the Noise map.
+		///
+		/// @param width The new width for the Noise map.
+		/// @param height The new height for the Noise map.
+		///
+		/// @pre The width and height values are not negative.
+		///
+		/// @throw Noise::ExceptionInvalidParam See the preconditions.
+		/// @throw Noise::ExceptionOutOfMemory Out of memory.
+		///
+		/// This method frees every tile, so on exit, every value within the
+		/// Noise map is equal to the fill value.
+		///
+		/// If the @a INVALID_PARAM exception occurs, the Noise map is
+		/// unmodified.
+		void SetSize(std::int64_t width, std::int64_t height);
+
+		/// Sets a value at a specified position in the Noise map.
+		///
+		/// @param x The x coordinate of the position.
+		/// @param y The y coordinate of the position.
+		/// @param value The value to set at the given position.
+		///
+		/// @throw Noise::ExceptionOutOfMemory Out of memory.
+		///
+		/// This method does nothing if the position is outside the bounds of
+		/// the Noise map.
+		void SetValue(std::int64_t x, std::int64_t y, float value);
+
+	private:
+
+		/// Copies the size, the tiles and the border and fill values of the
+		/// source Noise map into this Noise map.
+		///
+		/// @param source The source Noise map.
+		///
+		/// @throw Noise::ExceptionOutOfMemory Out of memory.
+		void CopyNoiseMap(const TiledNoiseMap& source);
+
+		/// Frees every tile of the Noise map.
+		void DeleteTiles();
+
+		/// Returns the index of the tile that contains a position.
+		///
+		/// @param x The x coordinate of the position.
+		/// @param y The y coordinate of the position.
+		///
+		/// @returns The index of the tile within the table of tiles.
+		size_t GetTileIndex(std::int64_t x, std::int64_t y) const
+		{
+			return (size_t)(y >> TILED_NOISE_MAP_TILE_SHIFT)
+				* (size_t)m_xTileCount
+				+ (size_t)(x >> TILED_NOISE_MAP_TILE_SHIFT);
+		}
+
+		/// Returns the offset of a position within its tile.
+		///
+		/// @param x The x coordinate of the position.
+		/// @param y The y coordinate of the position.
+		///
+		/// @returns The number of @a float values between the first value of
+		/// the tile and the value at that position.
+		static size_t GetTileOffset(std::int64_t x, std::int64_t y)
+		{
+			return (size_t)(y & (TILED_NOISE_MAP_TILE_SIZE - 1))
+				* TILED_NOISE_MAP_TILE_SIZE
+				+ (size_t)(x & (TILED_NOISE_MAP_TILE_SIZE - 1));
+		}
+
+		/// Returns the tile at the specified index, allocating it if it does
+		/// not exist yet.
+		///
+		/// @param tileIndex The index of the tile.
+		///
+		/// @returns A pointer to the first value of the tile.
+		///
+		/// @throw Noise::ExceptionOutOfMemory Out of memory.
+		///
+		/// Several threads may call this method at once.  If two of them
+		/// allocate the same tile, only one of the allocations is kept.
+		float* GetOrAllocateTile(size_t tileIndex);
+
+		/// Number of tiles allocated for this Noise map.
+		std::atomic<std::int64_t> m_allocatedTileCount;
+
+		/// Value used for all positions outside of the Noise map.
+		float m_borderValue;
+
+		/// A row of a tile filled with the fill value.
+		///
+		/// GetConstSlabPtr() returns a pointer into this row for a tile that
+		/// is not allocated yet.
+		std::vector<float> m_fillSlab;
+
+		/// Value of every position within a tile that is not allocated.
+		float m_fillValue;
+
+		/// The current height of the Noise map.
+		std::int64_t m_height;
+
+		/// The table of tiles, ordered by row then by column.  An entry is
+		/// @a NULL if its tile is not allocated yet.
+		std::unique_ptr<std::atomic<float*>[]> m_pTiles;
+
+		/// The current width of the Noise map.
+		std::int64_t m_width;
+
+		/// The number of tiles in each row of the table of tiles.
+		std::int64_t m_xTileCount;
+
+		/// The number of rows in the table of tiles.
+		std::int64_t m_yTileCount;
+
+	};
+}
+
+#endif //NOISE_TILEDNOISEMAP_HPP
@@ -23,14 +23,21 @@
 #ifndef NOISEUTILS_H
 #define NOISEUTILS_H
 
+#include <atomic>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <Image.hpp>
 #include <Color.hpp>
 #include <NoiseMap.hpp>
 #include <Constants.hpp>
+#include <TiledNoiseMap.hpp>
 #include <GradientPoint.hpp>
 #include <GradientColor.hpp>
 #include <noise/noise.h>
@@ -63,12 +70,16 @@ namespace noise
     /// - A <i>Noise map</i> class: This class implements a two-dimensional
     ///   array that stores floating-point values.  It's designed to store
     ///   coherent-Noise values generated by a Noise module.
+    /// - A <i>tiled Noise map</i> class: This class stores a Noise map that
+    ///   is too large for a Noise map object in lazily allocated tiles.
     /// - Several <i>Noise-map builder</i> classes: Each of these classes
     ///   fills a Noise map with coherent-Noise values generated by a Noise
     ///   module.  While filling a Noise map, it iterates the coordinates of
     ///   the input value along the surface of a specific mathematical object.
     ///   Each of these classes implements a different mathematical object,
     ///   such as a plane, a cylinder, or a sphere.
+    /// - A <i>tile-pyramid builder</i> class: This class builds the tiles of
+    ///   every level of a quadtree tile pyramid of a sphere for map viewers.
     /// - An <i>image</i> class: This class implements a two-dimensional array
     ///   that stores color values.
     /// - Several <i>image-renderer</i> classes: these classes render images
@@ -92,6 +103,94 @@ namespace noise
     /// method.
     typedef void(*NoiseMapCallback) (int row);
 
+    /// The progress of a call to the NoiseMapBuilder::Build() method.
+    struct BuildProgress
+    {
+
+      /// Number of points of the Noise maps that have been filled in.
+      std::int64_t completedPointCount;
+
+      /// Number of points of the Noise maps that the build fills in.
+      std::int64_t totalPointCount;
+
+      /// Time since the build started, in seconds.
+      double elapsedTime;
+
+      /// Estimated time until the build completes, in seconds.
+      ///
+      /// The estimate assumes that the remaining points take as long on
+      /// average as the points that have been filled in.
+      double remainingTime;
+
+      /// The context pointer passed to the
+      /// NoiseMapBuilder::SetProgressCallback() method.
+      void* pContext;
+
+    };
+
+    /// A pointer to a progress callback function used by the
+    /// NoiseMapBuilder class.
+    ///
+    /// The NoiseMapBuilder::Build() method calls this callback function each
+    /// time it fills a tile of the Noise map, and once more when the Noise
+    /// map is complete.  The function may be called from any of the threads
+    /// that build the Noise map, but never by two threads at once.  Pass a
+    /// function with this signature to the
+    /// NoiseMapBuilder::SetProgressCallback() method.
+    typedef void(*NoiseMapProgressCallback) (const BuildProgress& progress);
+
+    /// A flag that an application sets to stop a running build.
+    ///
+    /// Pass this object to the NoiseMapBuilder::SetCancellationToken()
+    /// method, then call the Cancel() method from any thread, such as the
+    /// user-interface thread of an interactive tool.  Each thread that builds
+    /// the Noise map checks the flag before it starts a tile, so the
+    /// NoiseMapBuilder::Build() method stops within one tile's worth of work
+    /// and throws a Noise::ExceptionCancelled exception.
+    class CancellationToken
+    {
+
+      public:
+
+        /// Constructor.
+        CancellationToken ():
+          m_isCancelled (false)
+        {
+        }
+
+        /// Requests that the builds using this token stop.
+        void Cancel ()
+        {
+          m_isCancelled = true;
+        }
+
+        /// Determines if the builds using this token were requested to
+        /// stop.
+        ///
+        /// @returns
+        /// - @a true if the Cancel() method was called since this object
+        ///   was constructed or last reset.
+        /// - @a false otherwise.
+        bool IsCancelled () const
+        {
+          return m_isCancelled;
+        }
+
+        /// Clears the request to stop, so that the token can be used for
+        /// another build.
+        void Reset ()
+        {
+          m_isCancelled = false;
+        }
+
+      private:
+
+        /// Determines if the builds using this token were requested to
+        /// stop.
+        std::atomic<bool> m_isCancelled;
+
+    };
+
 
 
 
@@ -185,6 +284,61 @@ namespace noise
 
     };
 
+    /// Abstract base class for a receiver of Noise map strips.
+    ///
+    /// A NoiseMapBuilder object that is given a sink through its
+    /// NoiseMapBuilder::SetDestSink() or NoiseMapBuilder::AddLayer() method
+    /// builds its Noise maps one strip of rows at a time, and hands each
+    /// strip to the sink before it builds the next one into the same memory.
+    /// Derive a class from this one to write the strips to a file, or to
+    /// process them in any other way.
+    ///
+    /// The builder calls Begin() once, then WriteStrip() for each strip in
+    /// order from the first row to the last, then End().  All three methods
+    /// are called on the thread that called NoiseMapBuilder::Build().  If
+    /// the build throws an exception, End() is not called.
+    class NoiseMapSink
+    {
+
+      public:
+
+        /// Destructor.
+        virtual ~NoiseMapSink ()
+        {
+        }
+
+        /// Called instead of End() if the build stops before the last strip
+        /// of a Noise map, because it was cancelled or an exception was
+        /// thrown.
+        ///
+        /// The sink should release whatever it holds for the Noise map, so
+        /// that Begin() can be called again.  This method must not throw
+        /// an exception.  The default implementation does nothing.
+        virtual void Abort ()
+        {
+        }
+
+        /// Called before the first strip of a Noise map.
+        ///
+        /// @param width The width of the whole Noise map, in points.
+        /// @param height The height of the whole Noise map, in points.
+        virtual void Begin (int width, int height) = 0;
+
+        /// Called after the last strip of a Noise map.
+        virtual void End () = 0;
+
+        /// Receives a strip of a Noise map.
+        ///
+        /// @param strip The rows of the strip.  Its width is the width of
+        /// the whole Noise map.
+        /// @param firstRow The row of the whole Noise map that the first row
+        /// of the strip belongs to.
+        ///
+        /// The strip is only valid until this method returns.
+        virtual void WriteStrip (const NoiseMap& strip, int firstRow) = 0;
+
+    };
+
     /// Terragen Terrain writer class.
     ///
     /// This class creates a file in Terrage Terrain (*.ter) format given the
@@ -205,18 +359,51 @@ namespace noise
     ///
     /// The SetDestFilename() and SetSourceNoiseMap() methods must be called
     /// before calling the WriteDestFile() method.
-    class WriterTER
+    ///
+    /// A TiledNoiseMap object may be passed to the SetSourceNoiseMap() method
+    /// instead, so that a terrain file up to the 65535 by 65535 points that
+    /// the format allows can be written from a Noise map larger than a
+    /// NoiseMap object can hold.
+    ///
+    /// <b>Writing a Noise map while it is built</b>
+    ///
+    /// This class is also a Noise::utils::NoiseMapSink.  Pass it to the
+    /// NoiseMapBuilder::SetDestSink() method, after calling
+    /// SetDestFilename(), to write a Noise map that is too large to keep in
+    /// memory one strip at a time as it is built.
+    class WriterTER: public NoiseMapSink
     {
 
       public:
 
         /// Constructor.
         WriterTER ():
+          m_metersPerPoint (DEFAULT_METERS_PER_POINT),
           m_pSourceNoiseMap (NULL),
-          m_metersPerPoint (DEFAULT_METERS_PER_POINT)
+          m_pSourceTiledNoiseMap (NULL),
+          m_writtenRowCount (0)
         {
         }
 
+        /// Opens the file and writes its header.
+        ///
+        /// @param width The width of the Noise map, in points.
+        /// @param height The height of the Noise map, in points.
+        ///
+        /// @pre The width and height do not exceed 65535, the largest size
+        /// that the file format can store.
+        ///
+        /// @throw Noise::ExceptionInvalidParam See the preconditions.
+        /// @throw Noise::ExceptionUnknown An unknown exception occurred.
+        /// Possibly the file could not be written.
+        virtual void Begin (int width, int height);
+
+        /// Closes and deletes the incomplete file.
+        virtual void Abort ();
+
+        /// Closes the file.
+        virtual void End ();
+
         /// Returns the name of the file to write.
         ///
         /// @returns The name of the file to write.
@@ -263,12 +450,26 @@ namespace noise
         void SetSourceNoiseMap (NoiseMap& sourceNoiseMap)
         {
           m_pSourceNoiseMap = &sourceNoiseMap;
+          m_pSourceTiledNoiseMap = NULL;
+        }
+
+        /// Sets the tiled Noise map object that is written to the file.
+        ///
+        /// @param sourceNoiseMap The tiled Noise map object to write.
+        ///
+        /// This object only stores a pointer to a Noise map object, so make
+        /// sure this object exists before calling the WriteDestFile() method.
+        void SetSourceNoiseMap (const TiledNoiseMap& sourceNoiseMap)
+        {
+          m_pSourceNoiseMap = NULL;
+          m_pSourceTiledNoiseMap = &sourceNoiseMap;
         }
 
         /// Writes the contents of the Noise map object to the file.
         ///
         /// @pre SetDestFilename() has been previously called.
         /// @pre SetSourceNoiseMap() has been previously called.
+        /// @pre The width and height of the Noise map do not exceed 65535.
         ///
         /// @throw Noise::ExceptionInvalidParam See the preconditions.
         /// @throw Noise::ExceptionOutOfMemory Out of memory.
@@ -284,6 +485,20 @@ namespace noise
         /// meters.
         void WriteDestFile ();
 
+        /// Writes the rows of a strip of the Noise map to the file.
+        ///
+        /// @param strip The rows of the strip.
+        /// @param firstRow The row of the Noise map that the first row of the
+        /// strip belongs to.
+        ///
+        /// @pre Begin() has been previously called.
+        /// @pre The strip follows the rows already written to the file.
+        ///
+        /// @throw Noise::ExceptionInvalidParam See the preconditions.
+        /// @throw Noise::ExceptionUnknown An unknown exception occurred.
+        /// Possibly the file could not be written.
+        virtual void WriteStrip (const NoiseMap& strip, int firstRow);
+
       protected:
     
         /// Calculates the width of one horizontal line in the file, in bytes.
@@ -293,6 +508,22 @@ namespace noise
         /// @returns The width of one horizontal line in the file.
         int CalcWidthByteCount (int width) const;
 
+        /// Encodes Noise values into a horizontal line of the file.
+        ///
+        /// @param pSource The Noise values.
+        /// @param count The number of Noise values.
+        /// @param pDest The bytes that receive the encoded values.
+        ///
+        /// @returns A pointer to the byte that follows the encoded values.
+        noise::uint8* EncodeValues (const float* pSource, int count,
+          noise::uint8* pDest) const;
+
+        /// Writes the horizontal line held by the line buffer to the file.
+        ///
+        /// @throw Noise::ExceptionUnknown An unknown exception occurred.
+        /// Possibly the file could not be written.
+        void WriteLineBuffer ();
+
         /// Name of the file to write.
         std::string m_destFilename;
 
@@ -303,6 +534,67 @@ namespace noise
         /// A pointer to the Noise map that will be written to the file.
         NoiseMap* m_pSourceNoiseMap;
 
+        /// A pointer to the tiled Noise map that will be written to the
+        /// file, or @a NULL.
+        const TiledNoiseMap* m_pSourceTiledNoiseMap;
+
+        /// Buffer that holds one horizontal line in the file.
+        std::vector<noise::uint8> m_lineBuffer;
+
+        /// The file being written.
+        std::ofstream m_stream;
+
+        /// Number of rows written to the file since Begin() was called.
+        int m_writtenRowCount;
+
+    };
+
+    /// Default number of threads used by the NoiseMapBuilder class.
+    const int DEFAULT_BUILDER_THREAD_COUNT = 1;
+
+    /// Default width and height of the tiles built by the NoiseMapBuilder
+    /// class, in points.
+    const int DEFAULT_BUILDER_TILE_SIZE = 64;
+
+    /// Default number of rows in each strip streamed to a sink by the
+    /// NoiseMapBuilder class.
+    const int DEFAULT_BUILDER_STRIP_HEIGHT = 256;
+
+    /// Default width and height of the blocks that the NoiseMapBuilder class
+    /// refines, in points.
+    const int DEFAULT_REFINEMENT_BLOCK_SIZE = 8;
+
+    /// Default refinement tolerance of the NoiseMapBuilder class.  A
+    /// tolerance of zero evaluates every point.
+    const double DEFAULT_REFINEMENT_TOLERANCE = 0.0;
+
+    /// The statistics of the last call to the NoiseMapBuilder::Build()
+    /// method with adaptive refinement.
+    ///
+    /// Divide the number of evaluated points by the number of points to
+    /// obtain the fraction of the Noise map that the source modules
+    /// actually evaluated.
+    struct RefinementStats
+    {
+
+      /// Number of points of the Noise maps.
+      std::int64_t totalPointCount;
+
+      /// Number of points evaluated by the source modules, including the
+      /// corners and the test points of each block.
+      std::int64_t evaluatedPointCount;
+
+      /// Number of blocks in the Noise maps.
+      std::int64_t blockCount;
+
+      /// Number of blocks that were filled by bilinear interpolation
+      /// because the bounds of the source modules proved them smooth,
+      /// without evaluating their test points.
+      std::int64_t boundedBlockCount;
+
+      /// Number of blocks whose every point was evaluated.
+      std::int64_t refinedBlockCount;
+
     };
 
     /// Abstract base class for a Noise-map builder
@@ -337,6 +629,80 @@ namespace noise
     /// Note that SetBounds() is not defined in the abstract base class; it is
     /// only defined in the derived classes.  This is because each model uses
     /// a different coordinate system.
+    ///
+    /// <b>Building several Noise maps at once</b>
+    ///
+    /// To fill in additional Noise maps from other Noise modules at the same
+    /// input values, such as the surface, moisture or temperature derived
+    /// from an elevation, pass each of them to the AddLayer() method before
+    /// calling the Build() method.  The source module and the source modules
+    /// of the layers are evaluated together by a Noise::RasterExecutor, so
+    /// a Noise module that several of them share is evaluated once per
+    /// point instead of once per Noise map.
+    ///
+    /// <b>Building with several threads</b>
+    ///
+    /// The Noise map is built in rectangular tiles, whose size is set by the
+    /// SetTileSize() method.  Pass a value greater than one to the
+    /// SetThreadCount() method to build the tiles with that many threads.
+    /// The tiles are sorted along a Z-order curve, so that consecutive tiles
+    /// are neighbours, and run on a Noise::TaskScheduler: each thread builds
+    /// its own share of the tiles with its own Noise::RasterExecutor, and a
+    /// thread that finishes its share early takes tiles from the thread that
+    /// has the most left.  This keeps every thread busy even when some areas
+    /// of the Noise map are much more expensive than others.  The threads are
+    /// kept between calls to the Build() method.
+    ///
+    /// The coordinates of every point are calculated from its row and column
+    /// rather than accumulated from the previous point, so the Noise map is
+    /// identical whatever the number of threads and the size of the tiles.
+    /// The Noise modules in the graph must support being evaluated by several
+    /// threads at once; the Noise modules in libnoise do.
+    ///
+    /// A row of the Noise map is complete once every tile that covers it is
+    /// complete.  The callback function is never called by two threads at
+    /// once, and it receives the rows in the order they complete.
+    ///
+    /// <b>Building very large Noise maps</b>
+    ///
+    /// A NoiseMap object cannot exceed Noise::utils::RASTER_MAX_WIDTH and
+    /// Noise::utils::RASTER_MAX_HEIGHT.  To build a larger Noise map, pass a
+    /// TiledNoiseMap object to the SetDestNoiseMap() and AddLayer() methods
+    /// instead.  Each tile that the builder fills is written straight into
+    /// the tiled Noise map, which allocates its own tiles as they are first
+    /// written.
+    ///
+    /// <b>Refining smooth areas adaptively</b>
+    ///
+    /// Large parts of a Noise map are often smooth, such as the areas that a
+    /// Noise::module::Select or Noise::module::Clamp module flattens.  Pass
+    /// a positive tolerance to the SetRefinementTolerance() method to only
+    /// evaluate those areas coarsely.  The Noise map is then split into
+    /// square blocks, whose size is set by the SetRefinementBlockSize()
+    /// method, and the corners of every block are evaluated first.  The
+    /// center of each block and the midpoints of its edges are then
+    /// evaluated and compared with the bilinear interpolation of its
+    /// corners.  A block whose difference exceeds the tolerance is evaluated
+    /// at every point, and so are its eight neighbours, since a detail that
+    /// shows up in the test points of one block often extends into the next
+    /// one between their test points.  The other blocks are filled by
+    /// bilinear interpolation.  Call the GetRefinementStats() method after
+    /// the build to find out what fraction of the points was evaluated.
+    ///
+    /// The test points only estimate the error of a block, so an isolated
+    /// feature smaller than half a block may still be missed.  Call the
+    /// EnableRefinementBounds() method to also bound the output values of
+    /// each block with the Noise::module::Module::GetValueRange() method
+    /// first; a block whose output values are proven to lie within a range
+    /// no wider than the tolerance is filled without evaluating its test
+    /// points, and its interpolated values are guaranteed to be within the
+    /// tolerance.
+    ///
+    /// The blocks are aligned to the Noise map rather than to the tiles, so
+    /// the Noise map does not depend on the number of threads or the size of
+    /// the tiles.  The tolerance is ignored by a seamless
+    /// NoiseMapBuilderPlane object, by a NoiseMapBuilderSphere object with a
+    /// reduced grid, and by a NoiseMapBuilderCubeSphere object.
     class NoiseMapBuilder
     {
 
@@ -345,6 +711,44 @@ namespace noise
         /// Constructor.
         NoiseMapBuilder ();
 
+        /// Adds a layer to build alongside the destination Noise map.
+        ///
+        /// @param sourceModule The source module of the layer.
+        /// @param destNoiseMap The Noise map that receives the layer.
+        /// @param pSink The sink that receives the strips of the layer, or
+        /// @a NULL.
+        ///
+        /// After a successful call to the Build() method, the Noise map
+        /// contains the coherent-Noise values from the source module of the
+        /// layer, generated from the same input values as the destination
+        /// Noise map.
+        ///
+        /// If the destination Noise map is streamed to a sink, as described
+        /// for the SetDestSink() method, the Noise map of the layer only
+        /// holds one strip at a time, and each strip is passed to the sink of
+        /// the layer if there is one.
+        ///
+        /// The source module, the Noise map and the sink must exist
+        /// throughout the lifetime of this object unless the ClearLayers()
+        /// method is called.
+        void AddLayer (const module::Module& sourceModule,
+          NoiseMap& destNoiseMap, NoiseMapSink* pSink = NULL);
+
+        /// Adds a layer to build into a tiled Noise map alongside the
+        /// destination Noise map.
+        ///
+        /// @param sourceModule The source module of the layer.
+        /// @param destNoiseMap The tiled Noise map that receives the layer.
+        ///
+        /// The tiled Noise map is always built whole, even if the
+        /// destination Noise map is streamed to a sink.
+        ///
+        /// The source module and the Noise map must exist throughout the
+        /// lifetime of this object unless the ClearLayers() method is
+        /// called.
+        void AddLayer (const module::Module& sourceModule,
+          TiledNoiseMap& destNoiseMap);
+
         /// Builds the Noise map.
         ///
         /// @pre SetBounds() was previously called.
@@ -360,12 +764,40 @@ namespace noise
         ///
         /// @throw Noise::ExceptionInvalidParam See the preconditions.
         /// @throw Noise::ExceptionOutOfMemory Out of memory.
+        /// @throw Noise::ExceptionCancelled The cancellation token passed to
+        /// SetCancellationToken() was cancelled before the Noise map was
+        /// complete.  The contents of the Noise maps are undefined.
         ///
         /// If this method is successful, the destination Noise map contains
         /// the coherent-Noise values from the Noise module specified by
-        /// SetSourceModule().
+        /// SetSourceModule(), and the Noise map of each layer contains the
+        /// coherent-Noise values from the source module of that layer.
         virtual void Build () = 0;
 
+        /// Removes every layer added by the AddLayer() method.
+        void ClearLayers ();
+
+        /// Enables or disables bounding the output values of each block
+        /// before it is refined.
+        ///
+        /// @param enable Specify @a true to enable the bounds.
+        ///
+        /// With the bounds enabled, the Build() method passes a box that
+        /// contains the input values of each block to the
+        /// Noise::module::Module::GetValueRange() method of every source
+        /// module.  If no range is wider than the refinement tolerance, the
+        /// block is filled by bilinear interpolation of its corners without
+        /// evaluating any other point.  The range of a coherent-Noise
+        /// generator, such as Noise::module::Perlin, narrows in proportion
+        /// to the size of the block and to its Lipschitz bound, so the
+        /// bounds are worthwhile for small blocks of smooth source modules,
+        /// and for source modules that are flattened by
+        /// Noise::module::Clamp or Noise::module::Select modules.
+        void EnableRefinementBounds (bool enable = true)
+        {
+          m_isRefinementBoundsEnabled = enable;
+        }
+
         /// Returns the height of the destination Noise map.
         ///
         /// @returns The height of the destination Noise map, in points.
@@ -388,6 +820,77 @@ namespace noise
           return m_destWidth;
         }
 
+        /// Returns the number of layers added by the AddLayer() method.
+        ///
+        /// @returns The number of layers.
+        int GetLayerCount () const
+        {
+          return (int)m_layerModules.size ();
+        }
+
+        /// Returns the width and height of the blocks that the Noise map is
+        /// refined in.
+        ///
+        /// @returns The size of the blocks, in points.
+        int GetRefinementBlockSize () const
+        {
+          return m_refinementBlockSize;
+        }
+
+        /// Returns the statistics of the last call to the Build() method.
+        ///
+        /// @returns The statistics.  Every count is zero if the last build
+        /// did not refine the Noise map adaptively.
+        const RefinementStats& GetRefinementStats () const
+        {
+          return m_refinementStats;
+        }
+
+        /// Returns the largest difference allowed between an interpolated
+        /// output value and the evaluated output value.
+        ///
+        /// @returns The refinement tolerance, or zero if every point is
+        /// evaluated.
+        double GetRefinementTolerance () const
+        {
+          return m_refinementTolerance;
+        }
+
+        /// Returns the number of threads that build the Noise map.
+        ///
+        /// @returns The number of threads, including the calling thread.
+        int GetThreadCount () const
+        {
+          return m_threadCount;
+        }
+
+        /// Returns the height of the tiles that the Noise map is built in.
+        ///
+        /// @returns The height of the tiles, in points.
+        int GetTileHeight () const
+        {
+          return m_tileHeight;
+        }
+
+        /// Returns the width of the tiles that the Noise map is built in.
+        ///
+        /// @returns The width of the tiles, in points.
+        int GetTileWidth () const
+        {
+          return m_tileWidth;
+        }
+
+        /// Determines if the output values of each block are bounded before
+        /// it is refined.
+        ///
+        /// @returns
+        /// - @a true if the bounds are enabled.
+        /// - @a false if they are not.
+        bool IsRefinementBoundsEnabled () const
+        {
+          return m_isRefinementBoundsEnabled;
+        }
+
         /// Sets the callback function that Build() calls each time it fills a
         /// row of the Noise map with coherent-Noise values.
         ///
@@ -399,6 +902,104 @@ namespace noise
         /// method.
         void SetCallback (NoiseMapCallback pCallback);
 
+        /// Sets the cancellation token that stops the build.
+        ///
+        /// @param pToken The cancellation token, or @a NULL to build every
+        /// Noise map to completion.
+        ///
+        /// The cancellation token must exist throughout the lifetime of this
+        /// object unless another cancellation token replaces it.
+        void SetCancellationToken (const CancellationToken* pToken)
+        {
+          m_pCancellationToken = pToken;
+        }
+
+        /// Sets the progress callback function that Build() calls each time
+        /// it fills a tile of the Noise map.
+        ///
+        /// @param pCallback The progress callback function, or @a NULL to
+        /// report no progress.
+        /// @param pContext A pointer that is passed back to the progress
+        /// callback function in the Noise::utils::BuildProgress structure.
+        ///
+        /// The threads that build the Noise map count the filled points with
+        /// an atomic counter.  A thread that completes a tile while another
+        /// thread is calling the progress callback function skips its call
+        /// instead of waiting, so the reports never slow the build down.
+        void SetProgressCallback (NoiseMapProgressCallback pCallback,
+          void* pContext = NULL)
+        {
+          m_pProgressCallback = pCallback;
+          m_pProgressContext  = pContext;
+        }
+
+        /// Sets the width and height of the blocks that the Noise map is
+        /// refined in.
+        ///
+        /// @param blockSize The size of the blocks, in points.
+        ///
+        /// @pre The size of the blocks is at least two.
+        ///
+        /// @throw Noise::ExceptionInvalidParam An invalid parameter was
+        /// specified; see the preconditions for more information.
+        ///
+        /// Only the corners of a smooth block and five test points are
+        /// evaluated, so larger blocks evaluate fewer points in smooth
+        /// areas, but refine more points around each detail.  The tiles are
+        /// best made a multiple of this size, so that each block lies within
+        /// a single tile.
+        void SetRefinementBlockSize (int blockSize);
+
+        /// Sets the largest difference allowed between an interpolated
+        /// output value and the evaluated output value.
+        ///
+        /// @param tolerance The refinement tolerance, or zero to evaluate
+        /// every point.
+        ///
+        /// @pre The tolerance is not negative.
+        ///
+        /// @throw Noise::ExceptionInvalidParam An invalid parameter was
+        /// specified; see the preconditions for more information.
+        ///
+        /// The tolerance applies to the output values of the source module
+        /// and of the source module of every layer; a block is refined if
+        /// any of them exceeds it.
+        void SetRefinementTolerance (double tolerance);
+
+        /// Streams the destination Noise map to a sink instead of building it
+        /// whole.
+        ///
+        /// @param pSink The sink that receives the strips of the destination
+        /// Noise map, or @a NULL to build the Noise maps whole.
+        /// @param stripHeight The number of rows in each strip.
+        ///
+        /// @pre The number of rows is positive.
+        ///
+        /// @throw Noise::ExceptionInvalidParam An invalid parameter was
+        /// specified; see the preconditions for more information.
+        ///
+        /// With a sink, the Build() method sizes the destination Noise map
+        /// and the Noise map of each layer to hold a single strip.  It builds
+        /// the strips from the first row to the last, handing each one to the
+        /// sinks before it builds the next, so the memory used does not grow
+        /// with the height of the Noise map.  The tiles of each strip are
+        /// split between the threads as usual.  After the build, the Noise
+        /// maps hold the last strip.
+        ///
+        /// If the build stops early, because it was cancelled or an
+        /// exception was thrown, each sink that began the Noise map receives
+        /// a call to the NoiseMapSink::Abort() method instead of the
+        /// NoiseMapSink::End() method.
+        ///
+        /// Only a NoiseMap object can be streamed; the Build() method throws
+        /// Noise::ExceptionInvalidParam if the destination Noise map is a
+        /// TiledNoiseMap object.
+        ///
+        /// The sink must exist throughout the lifetime of this object unless
+        /// another sink replaces it.
+        void SetDestSink (NoiseMapSink* pSink,
+          int stripHeight = DEFAULT_BUILDER_STRIP_HEIGHT);
+
         /// Sets the destination Noise map.
         ///
         /// @param destNoiseMap The destination Noise map.
@@ -411,6 +1012,24 @@ namespace noise
         void SetDestNoiseMap (NoiseMap& destNoiseMap)
         {
           m_pDestNoiseMap = &destNoiseMap;
+          m_pDestTiledNoiseMap = NULL;
+        }
+
+        /// Sets a tiled Noise map as the destination Noise map.
+        ///
+        /// @param destNoiseMap The destination Noise map.
+        ///
+        /// The width and height specified by SetDestSize() may then exceed
+        /// the maximum width and height of a NoiseMap object.  The Build()
+        /// method resizes the tiled Noise map, which frees its tiles, then
+        /// writes every tile that it fills into it.
+        ///
+        /// The destination Noise map must exist throughout the lifetime of
+        /// this object unless another Noise map replaces that Noise map.
+        void SetDestNoiseMap (TiledNoiseMap& destNoiseMap)
+        {
+          m_pDestNoiseMap = NULL;
+          m_pDestTiledNoiseMap = &destNoiseMap;
         }
 
         /// Sets the source module.
@@ -442,8 +1061,155 @@ namespace noise
           m_destHeight = destHeight;
         }
 
+        /// Sets the number of threads that build the Noise map.
+        ///
+        /// @param threadCount The number of threads, including the calling
+        /// thread.
+        ///
+        /// @pre The number of threads is positive.
+        ///
+        /// @throw Noise::ExceptionInvalidParam An invalid parameter was
+        /// specified; see the preconditions for more information.
+        ///
+        /// The additional threads are started by the next call to the
+        /// Build() method, and are kept until the number of threads changes
+        /// or this object is destroyed.
+        void SetThreadCount (int threadCount);
+
+        /// Sets the size of the tiles that the Noise map is built in.
+        ///
+        /// @param tileWidth The width of the tiles, in points.
+        /// @param tileHeight The height of the tiles, in points.
+        ///
+        /// @pre The width and height are positive.
+        ///
+        /// @throw Noise::ExceptionInvalidParam An invalid parameter was
+        /// specified; see the preconditions for more information.
+        ///
+        /// Each tile is evaluated by a single call to the
+        /// Noise::RasterExecutor::GetValues() method.  Larger tiles spread
+        /// the cost of each Noise module over more points; smaller tiles
+        /// balance the work between the threads more evenly.
+        void SetTileSize (int tileWidth, int tileHeight);
+
       protected:
 
+        /// A function that generates the output values of one tile of the
+        /// Noise maps.
+        ///
+        /// The function receives the column and row of the upper-left point
+        /// of the tile, the width and height of the tile, the executor of the
+        /// calling thread, a scratch array that belongs to the calling
+        /// thread, and for each Noise map returned by GetDestNoiseMaps(), an
+        /// array that receives the output values of the tile, one row after
+        /// another.
+        using TileGenerator = std::function<void (int x, int y, int width,
+          int height, RasterExecutor& executor, std::vector<double>& workspace,
+          double* const* values)>;
+
+        /// Fills every tile of the destination Noise map and the Noise map of
+        /// each layer.
+        ///
+        /// @param generateTile The function that generates the output values
+        /// of a tile.
+        ///
+        /// The Noise maps are resized to the size specified by SetDestSize(),
+        /// or to one strip if they are streamed to a sink.  The generator
+        /// always receives the row within the whole Noise map.
+        ///
+        /// The tiles are split between the threads specified by
+        /// SetThreadCount().  If the function throws an exception on any
+        /// thread, the remaining tiles are abandoned and the exception is
+        /// rethrown on the calling thread.
+        void BuildTiles (const TileGenerator& generateTile);
+
+        /// A function that calculates the input values of several points of
+        /// the Noise map.
+        ///
+        /// The function receives the number of points, the column and row of
+        /// each point within the whole Noise map, and three arrays that
+        /// receive the ( @a x, @a y, @a z ) coordinates of the input value of
+        /// each point.
+        using PointMapper = std::function<void (int count, const int* columns,
+          const int* rows, double* x, double* y, double* z)>;
+
+        /// Fills every tile of the destination Noise map and the Noise map of
+        /// each layer, only evaluating the blocks of the tiles that are not
+        /// smooth.
+        ///
+        /// @param mapPoints The function that calculates the input values of
+        /// the points.
+        ///
+        /// The function must calculate the input values exactly as the
+        /// builder does without refinement, so that the evaluated points are
+        /// identical.  The statistics returned by GetRefinementStats() are
+        /// updated once the Noise maps are complete.
+        void BuildRefinedTiles (const PointMapper& mapPoints);
+
+        /// Returns the sink of the destination Noise map followed by the sink
+        /// of each layer.
+        ///
+        /// @returns The sinks, in the order of the Noise maps returned by
+        /// GetDestNoiseMaps(); an entry is @a NULL if its Noise map has no
+        /// sink.
+        std::vector<NoiseMapSink*> GetDestSinks () const;
+
+        /// Returns the destination Noise map followed by the Noise map of
+        /// each layer.
+        ///
+        /// @returns The Noise maps filled in by the Build() method; an entry
+        /// is @a NULL if that Noise map is a TiledNoiseMap object.
+        std::vector<NoiseMap*> GetDestNoiseMaps () const;
+
+        /// Returns the tiled destination Noise map followed by the tiled
+        /// Noise map of each layer.
+        ///
+        /// @returns The tiled Noise maps, in the order of the Noise maps
+        /// returned by GetDestNoiseMaps(); an entry is @a NULL if that Noise
+        /// map is a NoiseMap object.
+        std::vector<TiledNoiseMap*> GetDestTiledNoiseMaps () const;
+
+        /// Returns the source module followed by the source module of each
+        /// layer.
+        ///
+        /// @returns The roots passed to the executor by the Build() method.
+        std::vector<const module::Module*> GetSourceModules () const;
+
+        /// Determines if a destination Noise map was set.
+        ///
+        /// @returns
+        /// - @a true if SetDestNoiseMap() was previously called.
+        /// - @a false if it was not.
+        bool HasDestNoiseMap () const
+        {
+          return m_pDestNoiseMap != NULL || m_pDestTiledNoiseMap != NULL;
+        }
+
+        /// Writes a tile of output values to the destination Noise map and
+        /// the Noise map of each layer.
+        ///
+        /// @param destNoiseMaps The Noise maps returned by
+        /// GetDestNoiseMaps().
+        /// @param destTiledNoiseMaps The tiled Noise maps returned by
+        /// GetDestTiledNoiseMaps().
+        /// @param x The column of the upper-left point of the tile.
+        /// @param y The row of the strip that holds the upper-left point of
+        /// the tile.
+        /// @param stripRow The row of the whole Noise map that holds the
+        /// first row of the strip.
+        /// @param width The width of the tile.
+        /// @param height The height of the tile.
+        /// @param values For each Noise map, the output values of the tile,
+        /// one row after another.
+        ///
+        /// A NoiseMap object only holds the current strip, so the tile is
+        /// written to its row @a y; a tiled Noise map holds the whole Noise
+        /// map, so the tile is written to its row @a stripRow + @a y.
+        void WriteTile (const std::vector<NoiseMap*>& destNoiseMaps,
+          const std::vector<TiledNoiseMap*>& destTiledNoiseMaps, int x, int y,
+          int stripRow, int width, int height,
+          const std::vector<double*>& values) const;
+
         /// The callback function that Build() calls each time it fills a row
         /// of the Noise map with coherent-Noise values.
         ///
@@ -453,17 +1219,292 @@ namespace noise
         /// method.
         NoiseMapCallback m_pCallback;
 
-        /// Height of the destination Noise map, in points.
-        int m_destHeight;
+        /// The cancellation token that stops the build, or @a NULL.
+        const CancellationToken* m_pCancellationToken;
+
+        /// Height of the destination Noise map, in points.
+        int m_destHeight;
+
+        /// Width of the destination Noise map, in points.
+        int m_destWidth;
+
+        /// Destination Noise map that will contain the coherent-Noise values.
+        NoiseMap* m_pDestNoiseMap;
+
+        /// The sink that the destination Noise map is streamed to, or
+        /// @a NULL.
+        NoiseMapSink* m_pDestSink;
+
+        /// Tiled destination Noise map that will contain the coherent-Noise
+        /// values, or @a NULL if the destination Noise map is a NoiseMap
+        /// object.
+        TiledNoiseMap* m_pDestTiledNoiseMap;
+
+        /// The progress callback function, or @a NULL.
+        NoiseMapProgressCallback m_pProgressCallback;
+
+        /// The context pointer passed to the progress callback function.
+        void* m_pProgressContext;
+
+        /// Determines if the output values of each block are bounded before
+        /// it is refined.
+        bool m_isRefinementBoundsEnabled;
+
+        /// Width and height of the blocks that the Noise map is refined in,
+        /// in points.
+        int m_refinementBlockSize;
+
+        /// The statistics of the last build.
+        RefinementStats m_refinementStats;
+
+        /// Largest difference allowed between an interpolated output value
+        /// and the evaluated output value, or zero.
+        double m_refinementTolerance;
+
+        /// Source Noise module that will generate the coherent-Noise values.
+        const module::Module* m_pSourceModule;
+
+        /// The source module of each layer.
+        std::vector<const module::Module*> m_layerModules;
+
+        /// The Noise map of each layer, or @a NULL.
+        std::vector<NoiseMap*> m_layerNoiseMaps;
+
+        /// The sink of each layer, or @a NULL.
+        std::vector<NoiseMapSink*> m_layerSinks;
+
+        /// The tiled Noise map of each layer, or @a NULL.
+        std::vector<TiledNoiseMap*> m_layerTiledNoiseMaps;
+
+        /// Number of rows in each strip streamed to the sinks.
+        int m_stripHeight;
+
+        /// Number of threads that build the Noise map.
+        int m_threadCount;
+
+        /// Height of the tiles that the Noise map is built in, in points.
+        int m_tileHeight;
+
+        /// Width of the tiles that the Noise map is built in, in points.
+        int m_tileWidth;
+
+        /// The threads that build the tiles, or an empty pointer if they
+        /// have not been started yet.
+        std::unique_ptr<TaskScheduler> m_pScheduler;
+
+    };
+
+    /// Enumerates the faces of the cube of a
+    /// NoiseMapBuilderCubeSphere object.
+    ///
+    /// The faces are stored in this order in the Noise map.  Each face is
+    /// named after the axis that passes through its center.
+    enum CubeFace
+    {
+
+      /// The face centered on the positive @a x axis.
+      CUBE_FACE_POSITIVE_X = 0,
+
+      /// The face centered on the negative @a x axis.
+      CUBE_FACE_NEGATIVE_X = 1,
+
+      /// The face centered on the positive @a y axis.
+      CUBE_FACE_POSITIVE_Y = 2,
+
+      /// The face centered on the negative @a y axis.
+      CUBE_FACE_NEGATIVE_Y = 3,
+
+      /// The face centered on the positive @a z axis.
+      CUBE_FACE_POSITIVE_Z = 4,
+
+      /// The face centered on the negative @a z axis.
+      CUBE_FACE_NEGATIVE_Z = 5
+
+    };
+
+    /// Number of faces of the cube of a NoiseMapBuilderCubeSphere object.
+    const int CUBE_FACE_COUNT = 6;
+
+    /// Enumerates the projections from the faces of a cube onto a sphere.
+    enum CubeProjection
+    {
+
+      /// Points evenly spaced across a face are projected straight onto
+      /// the sphere.  A point near a corner of a face covers about a fifth
+      /// of the area of a point at its center.
+      CUBE_PROJECTION_NORMALIZED = 0,
+
+      /// Points evenly spaced across a face are projected onto the sphere
+      /// at evenly spaced angles from the center of the face.  The area
+      /// covered by a point varies by at most a factor of about 1.4 across
+      /// a face.
+      CUBE_PROJECTION_EQUAL_ANGLE = 1
+
+    };
+
+    /// Default projection used by the NoiseMapBuilderCubeSphere class.
+    const CubeProjection DEFAULT_CUBE_PROJECTION = CUBE_PROJECTION_EQUAL_ANGLE;
+
+    /// Builds the six faces of a cube-mapped spherical Noise map.
+    ///
+    /// This class builds a Noise map by filling it with coherent-Noise values
+    /// generated from the surface of a sphere, projected from the six faces
+    /// of a cube that encloses it.  Unlike a NoiseMapBuilderSphere object,
+    /// whose rows all have the same number of points however close they are
+    /// to a pole, this class spreads its points almost evenly across the
+    /// sphere.  A cube map with faces a quarter as wide as an equirectangular
+    /// Noise map has the same spacing between points at the equator, and
+    /// 25 percent fewer points in all.
+    ///
+    /// The sphere model has a radius of 1.0 unit and its center is at the
+    /// origin, like the model of the NoiseMapBuilderSphere class.
+    ///
+    /// The faces are stored one below the other in the destination Noise
+    /// map, in the order of the Noise::utils::CubeFace enumeration, so the
+    /// Noise map is GetFaceSpan() points wide and six times as high.  Call
+    /// the GetFaceNoiseMap() method to copy a face into a Noise map of its
+    /// own.  The size passed to the SetDestSize() method is ignored.
+    ///
+    /// Within a face, the coordinates (@a u, @a v) range from -1.0 at the
+    /// first column or row to +1.0 at the last, and pass through the centers
+    /// of the points.  They are projected onto the sphere from the following
+    /// points on the cube, following the usual convention for cube maps:
+    /// - positive @a x face: (1, -@a v, -@a u)
+    /// - negative @a x face: (-1, -@a v, @a u)
+    /// - positive @a y face: (@a u, 1, @a v)
+    /// - negative @a y face: (@a u, -1, -@a v)
+    /// - positive @a z face: (@a u, -@a v, 1)
+    /// - negative @a z face: (-@a u, -@a v, -1)
+    ///
+    /// To filter a face without seams, such as when generating normal maps,
+    /// call the SetApronWidth() method.  Each face is then extended by that
+    /// many points on every side, continuing its projection past its edges.
+    /// The apron holds the Noise values of the neighbouring faces at the
+    /// positions that a filter applied to the edge of the face would read.
+    ///
+    /// The tiles of every face are built together, so all six faces are
+    /// split between the threads specified by SetThreadCount().
+    class NoiseMapBuilderCubeSphere: public NoiseMapBuilder
+    {
+
+      public:
+
+        /// Constructor.
+        NoiseMapBuilderCubeSphere ();
+
+        virtual void Build ();
+
+        /// Returns the width of the apron around each face.
+        ///
+        /// @returns The width of the apron, in points.
+        int GetApronWidth () const
+        {
+          return m_apronWidth;
+        }
+
+        /// Copies a face out of a Noise map built by this object.
+        ///
+        /// @param cubeNoiseMap The Noise map built by this object, or one of
+        /// its layers.
+        /// @param face The face to copy.
+        /// @param faceNoiseMap The Noise map that receives the face,
+        /// including its apron.
+        ///
+        /// @pre The Noise map was built with the current face size and apron
+        /// width.
+        ///
+        /// @throw Noise::ExceptionInvalidParam See the preconditions.
+        void GetFaceNoiseMap (const NoiseMap& cubeNoiseMap, CubeFace face,
+          NoiseMap& faceNoiseMap) const;
+
+        /// Returns the first row of a face in the Noise map.
+        ///
+        /// @param face The face.
+        ///
+        /// @returns The row of the Noise map that holds the first row of the
+        /// face's apron.
+        int GetFaceRow (CubeFace face) const
+        {
+          return (int)face * GetFaceSpan ();
+        }
+
+        /// Returns the width of a face, not including its apron.
+        ///
+        /// @returns The width of a face, in points.
+        int GetFaceSize () const
+        {
+          return m_faceSize;
+        }
+
+        /// Returns the width of a face, including its apron on both sides.
+        ///
+        /// @returns The width of a face and its apron, in points.
+        int GetFaceSpan () const
+        {
+          return m_faceSize + 2 * m_apronWidth;
+        }
+
+        /// Returns the projection from the faces of the cube onto the
+        /// sphere.
+        ///
+        /// @returns The projection.
+        CubeProjection GetProjection () const
+        {
+          return m_projection;
+        }
+
+        /// Sets the width of the apron around each face.
+        ///
+        /// @param apronWidth The width of the apron, in points.
+        ///
+        /// @pre The width of the apron is not negative.
+        ///
+        /// @throw Noise::ExceptionInvalidParam See the preconditions.
+        ///
+        /// Build() also throws Noise::ExceptionInvalidParam if the apron is
+        /// wider than half a face.
+        void SetApronWidth (int apronWidth)
+        {
+          if (apronWidth < 0) {
+            throw noise::ExceptionInvalidParam ();
+          }
+          m_apronWidth = apronWidth;
+        }
+
+        /// Sets the width of a face.
+        ///
+        /// @param faceSize The width and height of each face, in points, not
+        /// including its apron.
+        ///
+        /// @pre The width is positive.
+        ///
+        /// @throw Noise::ExceptionInvalidParam See the preconditions.
+        void SetFaceSize (int faceSize)
+        {
+          if (faceSize <= 0) {
+            throw noise::ExceptionInvalidParam ();
+          }
+          m_faceSize = faceSize;
+        }
+
+        /// Sets the projection from the faces of the cube onto the sphere.
+        ///
+        /// @param projection The projection.
+        void SetProjection (CubeProjection projection)
+        {
+          m_projection = projection;
+        }
+
+      private:
 
-        /// Width of the destination Noise map, in points.
-        int m_destWidth;
+        /// Width of the apron around each face, in points.
+        int m_apronWidth;
 
-        /// Destination Noise map that will contain the coherent-Noise values.
-        NoiseMap* m_pDestNoiseMap;
+        /// Width of a face, in points, not including its apron.
+        int m_faceSize;
 
-        /// Source Noise module that will generate the coherent-Noise values.
-        const module::Module* m_pSourceModule;
+        /// The projection from the faces of the cube onto the sphere.
+        CubeProjection m_projection;
 
     };
 
@@ -730,6 +1771,10 @@ namespace noise
     ///
     /// The application must provide the southern, northern, western, and
     /// eastern bounds of the Noise map, in degrees.
+    ///
+    /// Every row of the Noise map has the same number of points, so the
+    /// rows near the poles are sampled far more densely than the equator.
+    /// To evaluate fewer points there, call the EnableReducedGrid() method.
     class NoiseMapBuilderSphere: public NoiseMapBuilder
     {
 
@@ -740,6 +1785,26 @@ namespace noise
 
         virtual void Build ();
 
+        /// Enables or disables the reduced grid.
+        ///
+        /// @param enable A flag that enables or disables the reduced grid.
+        ///
+        /// With the reduced grid enabled, each row of the Noise map is
+        /// evaluated at a number of evenly spaced longitudes proportional to
+        /// the cosine of its latitude, rounded up, rather than at every
+        /// column.  The columns are then filled in by linear interpolation
+        /// between the two nearest longitudes of the row.  This keeps the
+        /// points about equally far apart over the whole sphere.  A Noise map
+        /// of the whole sphere needs about 36 percent fewer evaluations, and
+        /// the rows near the poles lose the detail that was too fine to show
+        /// at the equator.  The rows close enough to the equator to need
+        /// every column are identical to the rows built without the reduced
+        /// grid.
+        void EnableReducedGrid (bool enable = true)
+        {
+          m_isReducedGridEnabled = enable;
+        }
+
         /// Returns the eastern boundary of the spherical Noise map.
         ///
         /// @returns The eastern boundary of the Noise map, in degrees.
@@ -772,6 +1837,16 @@ namespace noise
           return m_westLonBound;
         }
 
+        /// Determines if the reduced grid is enabled.
+        ///
+        /// @returns
+        /// - @a true if the reduced grid is enabled.
+        /// - @a false if the reduced grid is disabled.
+        bool IsReducedGridEnabled () const
+        {
+          return m_isReducedGridEnabled;
+        }
+
         /// Sets the coordinate boundaries of the Noise map.
         ///
         /// @param southLatBound The southern boundary of the Noise map, in
@@ -803,6 +1878,9 @@ namespace noise
 
       private:
 
+        /// A flag specifying whether the reduced grid is enabled.
+        bool m_isReducedGridEnabled;
+
         /// Eastern boundary of the spherical Noise map, in degrees.
         double m_eastLonBound;
 
@@ -817,6 +1895,499 @@ namespace noise
 
     };
 
+    /// Enumerates the map projections of a TilePyramidBuilder object.
+    enum PyramidProjection
+    {
+
+      /// The equirectangular projection.  Longitude and latitude are mapped
+      /// linearly onto the columns and rows.  Level @a n has 2 ^ ( @a n + 1 )
+      /// columns and 2 ^ @a n rows of tiles, so that every tile covers the
+      /// same number of degrees in both directions.
+      PYRAMID_PROJECTION_EQUIRECTANGULAR = 0,
+
+      /// The spherical Mercator projection used by web map viewers.  Level
+      /// @a n has 2 ^ @a n columns and 2 ^ @a n rows of tiles, between the
+      /// latitudes of -85.05 and +85.05 degrees.
+      PYRAMID_PROJECTION_MERCATOR = 1
+
+    };
+
+    /// Default map projection of the TilePyramidBuilder class.
+    const PyramidProjection DEFAULT_PYRAMID_PROJECTION =
+      PYRAMID_PROJECTION_MERCATOR;
+
+    /// Default width and height of the tiles built by the TilePyramidBuilder
+    /// class, in points.
+    const int DEFAULT_PYRAMID_TILE_SIZE = 256;
+
+    /// Largest level that the TilePyramidBuilder class can build.
+    const int PYRAMID_MAX_LEVEL = 24;
+
+    /// Identifies a tile of a tile pyramid.
+    ///
+    /// Tiles are numbered as in the XYZ scheme of web map viewers: the tile
+    /// in column zero and row zero of every level lies in the north-western
+    /// corner of the map, columns increase eastward and rows increase
+    /// southward.
+    struct PyramidTile
+    {
+
+      /// The level of the tile; level zero is the coarsest.
+      int level;
+
+      /// The column of the tile within its level.
+      int x;
+
+      /// The row of the tile within its level, counted from the north.
+      int y;
+
+    };
+
+    /// Abstract base class for a receiver of the tiles built by a
+    /// TilePyramidBuilder object.
+    ///
+    /// Derive a class from this one to write the tiles to files, to a
+    /// database or to a map viewer.
+    class PyramidTileSink
+    {
+
+      public:
+
+        /// Destructor.
+        virtual ~PyramidTileSink ()
+        {
+        }
+
+        /// Called if the build stops before every tile was written, because
+        /// it was cancelled or an exception was thrown.
+        ///
+        /// This method must not throw an exception.  The default
+        /// implementation does nothing.
+        virtual void Abort ()
+        {
+        }
+
+        /// Receives a tile.
+        ///
+        /// @param tile The level, column and row of the tile.
+        /// @param noiseMap The Noise map of the tile.  As in any Noise map,
+        /// its first row is the southern edge of the tile.
+        ///
+        /// This method may be called by any of the threads that build the
+        /// tiles, but never by two threads at once.  The Noise map is only
+        /// valid until this method returns.
+        virtual void WriteTile (const PyramidTile& tile,
+          const NoiseMap& noiseMap) = 0;
+
+    };
+
+    /// Builds every tile of a quadtree tile pyramid of a sphere.
+    ///
+    /// A tile pyramid stores a map of a sphere, such as a planet, at several
+    /// levels of detail for web and engine map viewers.  Level zero covers
+    /// the whole map with the fewest tiles; each following level splits each
+    /// tile of the previous level into four tiles of the same size in
+    /// points, which doubles the resolution.
+    ///
+    /// <b>Building the pyramid</b>
+    ///
+    /// To build the tiles, perform the following steps:
+    /// - Pass the Noise module to the SetSourceModule() method.
+    /// - Pass a PyramidTileSink object to the SetDestSink() method.
+    /// - Pass the finest level to build to the SetMaxLevel() method.
+    /// - Call the Build() method.
+    ///
+    /// Every tile is a Noise map of the size specified by SetTileSize().
+    /// Each point is evaluated at the center of its area, at the position
+    /// on the unit sphere given by the map projection, which is set by the
+    /// SetProjection() method.  A point of a tile therefore lies at the
+    /// center of the four points of the next level that cover it.
+    ///
+    /// To only build the tiles that overlap a region of the sphere, pass its
+    /// boundaries to the SetBounds() method.
+    ///
+    /// <b>Order of the tiles</b>
+    ///
+    /// The tiles are built by the number of threads specified by
+    /// SetThreadCount().  The threads take the tiles from a single queue in
+    /// which every tile of a level comes before the tiles of the next level,
+    /// so the coarse levels are complete early and can be shown as a
+    /// preview while the fine levels are built.
+    ///
+    /// <b>Level of detail</b>
+    ///
+    /// The octaves of a fractal Noise module whose frequency is higher than
+    /// the spacing of the points of a level can resolve only add aliasing,
+    /// yet each of them costs as much to evaluate as the first.  By default,
+    /// each level is built from a copy of the graph of Noise modules made by
+    /// Noise::LimitGraphDetail(), whose octaves stop at the highest
+    /// frequency that the points at the equator of that level can resolve.
+    /// The copies require every Noise module of the graph to be part of
+    /// libnoise; call EnableDetailLimit() with @a false to build every level
+    /// from the source module itself.
+    class TilePyramidBuilder
+    {
+
+      public:
+
+        /// Constructor.
+        TilePyramidBuilder ();
+
+        /// Builds every tile of the pyramid and passes it to the sink.
+        ///
+        /// @pre SetDestSink() was previously called.
+        /// @pre SetSourceModule() was previously called.
+        ///
+        /// @throw Noise::ExceptionInvalidParam See the preconditions, or
+        /// the level of detail is limited and the graph contains a Noise
+        /// module whose class is not part of libnoise.
+        /// @throw Noise::ExceptionOutOfMemory Out of memory.
+        /// @throw Noise::ExceptionCancelled The cancellation token passed to
+        /// SetCancellationToken() was cancelled before every tile was built.
+        /// The tiles already passed to the sink are complete.
+        void Build ();
+
+        /// Enables or disables the level-of-detail limit.
+        ///
+        /// @param enable A flag that enables or disables the limit.
+        ///
+        /// With the limit enabled, each level is built from a copy of the
+        /// graph of Noise modules whose octaves stop at the highest
+        /// frequency that the level can resolve.  The limit is enabled by
+        /// default.
+        void EnableDetailLimit (bool enable = true)
+        {
+          m_isDetailLimitEnabled = enable;
+        }
+
+        /// Returns the eastern boundary of the region to build.
+        ///
+        /// @returns The eastern boundary of the region, in degrees.
+        double GetEastLonBound () const
+        {
+          return m_eastLonBound;
+        }
+
+        /// Returns the finest level to build.
+        ///
+        /// @returns The finest level; levels zero to this level are built.
+        int GetMaxLevel () const
+        {
+          return m_maxLevel;
+        }
+
+        /// Returns the highest frequency that a level can resolve.
+        ///
+        /// @param level The level.
+        ///
+        /// @returns The frequency, in cycles per unit of the input
+        /// coordinates, of a wave that spans two points at the equator of
+        /// that level.
+        double GetMaxFrequency (int level) const;
+
+        /// Returns the northern boundary of the region to build.
+        ///
+        /// @returns The northern boundary of the region, in degrees.
+        double GetNorthLatBound () const
+        {
+          return m_northLatBound;
+        }
+
+        /// Returns the map projection of the tiles.
+        ///
+        /// @returns The map projection.
+        PyramidProjection GetProjection () const
+        {
+          return m_projection;
+        }
+
+        /// Returns the southern boundary of the region to build.
+        ///
+        /// @returns The southern boundary of the region, in degrees.
+        double GetSouthLatBound () const
+        {
+          return m_southLatBound;
+        }
+
+        /// Returns the number of threads that build the tiles.
+        ///
+        /// @returns The number of threads, including the calling thread.
+        int GetThreadCount () const
+        {
+          return m_threadCount;
+        }
+
+        /// Returns the boundaries of a tile.
+        ///
+        /// @param tile The level, column and row of the tile.
+        /// @param southLatBound On exit, the southern boundary of the tile,
+        /// in degrees.
+        /// @param northLatBound On exit, the northern boundary of the tile,
+        /// in degrees.
+        /// @param westLonBound On exit, the western boundary of the tile, in
+        /// degrees.
+        /// @param eastLonBound On exit, the eastern boundary of the tile, in
+        /// degrees.
+        void GetTileBounds (const PyramidTile& tile, double& southLatBound,
+          double& northLatBound, double& westLonBound,
+          double& eastLonBound) const;
+
+        /// Returns the number of columns of tiles in a level.
+        ///
+        /// @param level The level.
+        ///
+        /// @returns The number of columns of tiles covering the whole map.
+        int GetTileColumnCount (int level) const;
+
+        /// Returns the number of rows of tiles in a level.
+        ///
+        /// @param level The level.
+        ///
+        /// @returns The number of rows of tiles covering the whole map.
+        int GetTileRowCount (int level) const
+        {
+          return 1 << level;
+        }
+
+        /// Returns the width and height of the tiles.
+        ///
+        /// @returns The width and height of the tiles, in points.
+        int GetTileSize () const
+        {
+          return m_tileSize;
+        }
+
+        /// Returns the western boundary of the region to build.
+        ///
+        /// @returns The western boundary of the region, in degrees.
+        double GetWestLonBound () const
+        {
+          return m_westLonBound;
+        }
+
+        /// Determines if the level-of-detail limit is enabled.
+        ///
+        /// @returns
+        /// - @a true if the level-of-detail limit is enabled.
+        /// - @a false if it is disabled.
+        bool IsDetailLimitEnabled () const
+        {
+          return m_isDetailLimitEnabled;
+        }
+
+        /// Restricts the tiles to build to those that overlap a region.
+        ///
+        /// @param southLatBound The southern boundary of the region, in
+        /// degrees.
+        /// @param northLatBound The northern boundary of the region, in
+        /// degrees.
+        /// @param westLonBound The western boundary of the region, in
+        /// degrees.
+        /// @param eastLonBound The eastern boundary of the region, in
+        /// degrees.
+        ///
+        /// @pre The southern boundary is less than the northern boundary.
+        /// @pre The western boundary is less than the eastern boundary.
+        /// @pre The latitudes range from -90 to +90 degrees, and the
+        /// longitudes from -180 to +180 degrees.
+        ///
+        /// @throw Noise::ExceptionInvalidParam See the preconditions.
+        ///
+        /// By default, the region is the whole sphere.
+        void SetBounds (double southLatBound, double northLatBound,
+          double westLonBound, double eastLonBound);
+
+        /// Sets the cancellation token that stops the build.
+        ///
+        /// @param pToken The cancellation token, or @a NULL to build every
+        /// tile.
+        ///
+        /// The cancellation token must exist throughout the lifetime of this
+        /// object unless another cancellation token replaces it.
+        void SetCancellationToken (const CancellationToken* pToken)
+        {
+          m_pCancellationToken = pToken;
+        }
+
+        /// Sets the sink that receives the tiles.
+        ///
+        /// @param pSink The sink.
+        ///
+        /// If the build stops before every tile was written, the sink
+        /// receives a call to the PyramidTileSink::Abort() method.
+        ///
+        /// The sink must exist throughout the lifetime of this object unless
+        /// another sink replaces it.
+        void SetDestSink (PyramidTileSink* pSink)
+        {
+          m_pDestSink = pSink;
+        }
+
+        /// Sets the finest level to build.
+        ///
+        /// @param maxLevel The finest level; levels zero to this level are
+        /// built.
+        ///
+        /// @pre The level ranges from zero to
+        /// Noise::utils::PYRAMID_MAX_LEVEL.
+        ///
+        /// @throw Noise::ExceptionInvalidParam See the preconditions.
+        void SetMaxLevel (int maxLevel);
+
+        /// Sets the progress callback function that Build() calls each time
+        /// it builds a tile.
+        ///
+        /// @param pCallback The progress callback function, or @a NULL to
+        /// report no progress.
+        /// @param pContext A pointer that is passed back to the progress
+        /// callback function in the Noise::utils::BuildProgress structure.
+        ///
+        /// As for the NoiseMapBuilder class, a thread that builds a tile
+        /// while another thread is calling the progress callback function
+        /// skips its call instead of waiting.
+        void SetProgressCallback (NoiseMapProgressCallback pCallback,
+          void* pContext = NULL)
+        {
+          m_pProgressCallback = pCallback;
+          m_pProgressContext  = pContext;
+        }
+
+        /// Sets the map projection of the tiles.
+        ///
+        /// @param projection The map projection.
+        void SetProjection (PyramidProjection projection)
+        {
+          m_projection = projection;
+        }
+
+        /// Sets the source module.
+        ///
+        /// @param sourceModule The source module.
+        ///
+        /// The source module must exist throughout the lifetime of this
+        /// object unless another Noise module replaces that Noise module.
+        void SetSourceModule (const module::Module& sourceModule)
+        {
+          m_pSourceModule = &sourceModule;
+        }
+
+        /// Sets the number of threads that build the tiles.
+        ///
+        /// @param threadCount The number of threads, including the calling
+        /// thread.
+        ///
+        /// @pre The number of threads is positive.
+        ///
+        /// @throw Noise::ExceptionInvalidParam See the preconditions.
+        void SetThreadCount (int threadCount);
+
+        /// Sets the width and height of the tiles.
+        ///
+        /// @param tileSize The width and height of the tiles, in points.
+        ///
+        /// @pre The size is positive.
+        /// @pre The size does not exceed the maximum possible width and
+        /// height for a Noise map.
+        ///
+        /// @throw Noise::ExceptionInvalidParam See the preconditions.
+        void SetTileSize (int tileSize);
+
+      private:
+
+        /// The range of tiles of a level that overlap the region to build.
+        struct LevelRange
+        {
+
+          /// The first column of tiles.
+          int xBegin;
+
+          /// One past the last column of tiles.
+          int xEnd;
+
+          /// The first row of tiles.
+          int yBegin;
+
+          /// One past the last row of tiles.
+          int yEnd;
+
+          /// The number of tiles of the previous levels.
+          std::int64_t firstTile;
+
+        };
+
+        /// Returns the tiles of a level that overlap the region to build.
+        ///
+        /// @param level The level.
+        ///
+        /// @returns The range of tiles; its @a firstTile member is not set.
+        LevelRange GetLevelRange (int level) const;
+
+        /// Returns the latitude of a row of points.
+        ///
+        /// @param level The level.
+        /// @param row The row of points within the whole level, counted from
+        /// the north; a fractional row lies between two rows.
+        ///
+        /// @returns The latitude, in degrees.
+        double GetRowLatitude (int level, double row) const;
+
+        /// Returns the row of points at a latitude.
+        ///
+        /// @param level The level.
+        /// @param lat The latitude, in degrees.
+        ///
+        /// @returns The row of points within the whole level, counted from
+        /// the north, as a fractional number.
+        double GetLatitudeRow (int level, double lat) const;
+
+        /// Eastern boundary of the region to build, in degrees.
+        double m_eastLonBound;
+
+        /// Determines if the level-of-detail limit is enabled.
+        bool m_isDetailLimitEnabled;
+
+        /// The finest level to build.
+        int m_maxLevel;
+
+        /// Northern boundary of the region to build, in degrees.
+        double m_northLatBound;
+
+        /// The cancellation token that stops the build, or @a NULL.
+        const CancellationToken* m_pCancellationToken;
+
+        /// The sink that receives the tiles.
+        PyramidTileSink* m_pDestSink;
+
+        /// The progress callback function, or @a NULL.
+        NoiseMapProgressCallback m_pProgressCallback;
+
+        /// The context pointer passed to the progress callback function.
+        void* m_pProgressContext;
+
+        /// The map projection of the tiles.
+        PyramidProjection m_projection;
+
+        /// The threads that build the tiles, or an empty pointer if they
+        /// have not been started yet.
+        std::unique_ptr<TaskScheduler> m_pScheduler;
+
+        /// Source Noise module that will generate the coherent-Noise values.
+        const module::Module* m_pSourceModule;
+
+        /// Southern boundary of the region to build, in degrees.
+        double m_southLatBound;
+
+        /// Number of threads that build the tiles.
+        int m_threadCount;
+
+        /// Width and height of the tiles, in points.
+        int m_tileSize;
+
+        /// Western boundary of the region to build, in degrees.
+        double m_westLonBound;
+
+    };
+
     /// Renders an image from a Noise map.
     ///
     /// This class renders an image given the contents of a Noise-map object.
@@ -1264,6 +2835,35 @@ namespace noise
         void SetSourceNoiseMap (const NoiseMap& sourceNoiseMap)
         {
           m_pSourceNoiseMap = &sourceNoiseMap;
+          m_pSourceTiledNoiseMap = NULL;
+        }
+
+        /// Sets a window of a tiled Noise map as the source Noise map.
+        ///
+        /// @param sourceNoiseMap The tiled Noise map.
+        /// @param x The x coordinate of the lower-left position of the
+        /// window.
+        /// @param y The y coordinate of the lower-left position of the
+        /// window.
+        /// @param width The width of the window.
+        /// @param height The height of the window.
+        ///
+        /// The Render() method copies the window into a Noise map with the
+        /// TiledNoiseMap::CopyToNoiseMap() method, then renders it as if it
+        /// were the whole source Noise map.  The window must not exceed the
+        /// maximum width and height of an image.
+        ///
+        /// The tiled Noise map must exist throughout the lifetime of this
+        /// object unless another Noise map replaces that Noise map.
+        void SetSourceNoiseMap (const TiledNoiseMap& sourceNoiseMap,
+          std::int64_t x, std::int64_t y, int width, int height)
+        {
+          m_pSourceNoiseMap = NULL;
+          m_pSourceTiledNoiseMap = &sourceNoiseMap;
+          m_sourceWindowX = x;
+          m_sourceWindowY = y;
+          m_sourceWindowWidth  = width ;
+          m_sourceWindowHeight = height;
         }
 
       private:
@@ -1337,6 +2937,23 @@ namespace noise
         /// A pointer to the source Noise map.
         const NoiseMap* m_pSourceNoiseMap;
 
+        /// A pointer to the tiled source Noise map, or @a NULL.
+        const TiledNoiseMap* m_pSourceTiledNoiseMap;
+
+        /// Height of the window of the tiled source Noise map.
+        int m_sourceWindowHeight;
+
+        /// Width of the window of the tiled source Noise map.
+        int m_sourceWindowWidth;
+
+        /// The x coordinate of the lower-left position of the window of the
+        /// tiled source Noise map.
+        std::int64_t m_sourceWindowX;
+
+        /// The y coordinate of the lower-left position of the window of the
+        /// tiled source Noise map.
+        std::int64_t m_sourceWindowY;
+
         /// Used by the CalcLightIntensity() method to recalculate the light
         /// values only if the light parameters change.
         ///
@@ -1491,6 +3108,35 @@ namespace noise
         void SetSourceNoiseMap (const NoiseMap& sourceNoiseMap)
         {
           m_pSourceNoiseMap = &sourceNoiseMap;
+          m_pSourceTiledNoiseMap = NULL;
+        }
+
+        /// Sets a window of a tiled Noise map as the source Noise map.
+        ///
+        /// @param sourceNoiseMap The tiled Noise map.
+        /// @param x The x coordinate of the lower-left position of the
+        /// window.
+        /// @param y The y coordinate of the lower-left position of the
+        /// window.
+        /// @param width The width of the window.
+        /// @param height The height of the window.
+        ///
+        /// The Render() method copies the window into a Noise map with the
+        /// TiledNoiseMap::CopyToNoiseMap() method, then renders it as if it
+        /// were the whole source Noise map.  The window must not exceed the
+        /// maximum width and height of an image.
+        ///
+        /// The tiled Noise map must exist throughout the lifetime of this
+        /// object unless another Noise map replaces that Noise map.
+        void SetSourceNoiseMap (const TiledNoiseMap& sourceNoiseMap,
+          std::int64_t x, std::int64_t y, int width, int height)
+        {
+          m_pSourceNoiseMap = NULL;
+          m_pSourceTiledNoiseMap = &sourceNoiseMap;
+          m_sourceWindowX = x;
+          m_sourceWindowY = y;
+          m_sourceWindowWidth  = width ;
+          m_sourceWindowHeight = height;
         }
 
       private:
@@ -1531,6 +3177,23 @@ namespace noise
         /// A pointer to the source Noise map.
         const NoiseMap* m_pSourceNoiseMap;
 
+        /// A pointer to the tiled source Noise map, or @a NULL.
+        const TiledNoiseMap* m_pSourceTiledNoiseMap;
+
+        /// Height of the window of the tiled source Noise map.
+        int m_sourceWindowHeight;
+
+        /// Width of the window of the tiled source Noise map.
+        int m_sourceWindowWidth;
+
+        /// The x coordinate of the lower-left position of the window of the
+        /// tiled source Noise map.
+        std::int64_t m_sourceWindowX;
+
+        /// The y coordinate of the lower-left position of the window of the
+        /// tiled source Noise map.
+        std::int64_t m_sourceWindowY;
+
     };
 
   }
@@ -0,0 +1,287 @@
+#include <algorithm>
+#include <cstring>
+#include <noise/exception.h>
+#include <TiledNoiseMap.hpp>
+
+using namespace noise::utils;
+
+TiledNoiseMap::TiledNoiseMap():
+	m_allocatedTileCount(0),
+	m_borderValue(0.0),
+	m_fillSlab(TILED_NOISE_MAP_TILE_SIZE, 0.0f),
+	m_fillValue(0.0),
+	m_height(0),
+	m_width(0),
+	m_xTileCount(0),
+	m_yTileCount(0)
+{
+}
+
+TiledNoiseMap::TiledNoiseMap(std::int64_t width, std::int64_t height):
+	TiledNoiseMap()
+{
+	SetSize(width, height);
+}
+
+TiledNoiseMap::TiledNoiseMap(const TiledNoiseMap& rhs):
+	TiledNoiseMap()
+{
+	CopyNoiseMap(rhs);
+}
+
+TiledNoiseMap::~TiledNoiseMap()
+{
+	DeleteTiles();
+}
+
+TiledNoiseMap& TiledNoiseMap::operator=(const TiledNoiseMap& rhs)
+{
+	if (this != &rhs)
+	{
+		CopyNoiseMap(rhs);
+	}
+
+	return *this;
+}
+
+void TiledNoiseMap::Clear(float value)
+{
+	DeleteTiles();
+	m_fillValue = value;
+	std::fill(m_fillSlab.begin(), m_fillSlab.end(), value);
+}
+
+void TiledNoiseMap::CopyFromNoiseMap(const NoiseMap& source, std::int64_t x,
+	std::int64_t y)
+{
+	// Clip the source Noise map to this Noise map, then copy each row one
+	// slab at a time.
+	std::int64_t xBegin = std::max<std::int64_t>(x, 0);
+	std::int64_t yBegin = std::max<std::int64_t>(y, 0);
+	std::int64_t xEnd = std::min<std::int64_t>(x + source.GetWidth(), m_width);
+	std::int64_t yEnd = std::min<std::int64_t>(y + source.GetHeight(),
+		m_height);
+	for (std::int64_t row = yBegin; row < yEnd; row++)
+	{
+		const float* pSource = source.GetConstSlabPtr((int)(xBegin - x),
+			(int)(row - y));
+		for (std::int64_t column = xBegin; column < xEnd; )
+		{
+			std::int64_t length = std::min(GetSlabLength(column), xEnd - column);
+			std::memcpy(GetSlabPtr(column, row), pSource,
+				(size_t)length * sizeof(float));
+			pSource += length;
+			column += length;
+		}
+	}
+}
+
+void TiledNoiseMap::CopyNoiseMap(const TiledNoiseMap& source)
+{
+	SetSize(source.m_width, source.m_height);
+	m_borderValue = source.m_borderValue;
+	m_fillValue = source.m_fillValue;
+	m_fillSlab = source.m_fillSlab;
+
+	// Only copy the tiles that the source Noise map has allocated.
+	size_t tileCount = (size_t)(m_xTileCount * m_yTileCount);
+	size_t tileSize = (size_t)TILED_NOISE_MAP_TILE_SIZE
+		* TILED_NOISE_MAP_TILE_SIZE;
+	for (size_t i = 0; i < tileCount; i++)
+	{
+		const float* pSourceTile = source.m_pTiles[i];
+		if (pSourceTile != NULL)
+		{
+			std::memcpy(GetOrAllocateTile(i), pSourceTile,
+				tileSize * sizeof(float));
+		}
+	}
+}
+
+void TiledNoiseMap::CopyToNoiseMap(NoiseMap& dest, std::int64_t x,
+	std::int64_t y, int width, int height) const
+{
+	if (width <= 0 || height <= 0)
+	{
+		throw noise::ExceptionInvalidParam();
+	}
+
+	dest.SetSize(width, height);
+	dest.SetBorderValue(m_borderValue);
+	for (int row = 0; row < height; row++)
+	{
+		float* pDest = dest.GetSlabPtr(row);
+		std::int64_t sourceRow = y + row;
+		if (sourceRow < 0 || sourceRow >= m_height)
+		{
+			std::fill(pDest, pDest + width, m_borderValue);
+			continue;
+		}
+
+		// The columns to the left and right of this Noise map receive the
+		// border value; the columns in between are copied one slab at a
+		// time.
+		std::int64_t column = x;
+		std::int64_t columnEnd = x + width;
+		while (column < columnEnd)
+		{
+			std::int64_t length;
+			if (column < 0)
+			{
+				length = std::min<std::int64_t>(-column, columnEnd - column);
+				std::fill(pDest, pDest + length, m_borderValue);
+			}
+			else if (column >= m_width)
+			{
+				length = columnEnd - column;
+				std::fill(pDest, pDest + length, m_borderValue);
+			}
+			else
+			{
+				length = std::min(GetSlabLength(column), columnEnd - column);
+				std::memcpy(pDest, GetConstSlabPtr(column, sourceRow),
+					(size_t)length * sizeof(float));
+			}
+			pDest += length;
+			column += length;
+		}
+	}
+}
+
+void TiledNoiseMap::DeleteTiles()
+{
+	size_t tileCount = (size_t)(m_xTileCount * m_yTileCount);
+	for (size_t i = 0; i < tileCount; i++)
+	{
+		delete[] m_pTiles[i].exchange(NULL);
+	}
+	m_allocatedTileCount = 0;
+}
+
+const float* TiledNoiseMap::GetConstSlabPtr(std::int64_t x,
+	std::int64_t y) const
+{
+	const float* pTile = m_pTiles[GetTileIndex(x, y)].load(
+		std::memory_order_acquire);
+	if (pTile == NULL)
+	{
+		return &m_fillSlab[(size_t)(x & (TILED_NOISE_MAP_TILE_SIZE - 1))];
+	}
+	return pTile + GetTileOffset(x, y);
+}
+
+float* TiledNoiseMap::GetOrAllocateTile(size_t tileIndex)
+{
+	float* pTile = m_pTiles[tileIndex].load(std::memory_order_acquire);
+	if (pTile != NULL)
+	{
+		return pTile;
+	}
+
+	float* pNewTile = NULL;
+	try
+	{
+		pNewTile = new float[(size_t)TILED_NOISE_MAP_TILE_SIZE
+			* TILED_NOISE_MAP_TILE_SIZE];
+	}
+	catch (...)
+	{
+		throw noise::ExceptionOutOfMemory();
+	}
+	std::fill(pNewTile, pNewTile + (size_t)TILED_NOISE_MAP_TILE_SIZE
+		* TILED_NOISE_MAP_TILE_SIZE, m_fillValue);
+
+	// Another thread may have allocated the same tile in the meantime.  In
+	// that case, keep its tile, which may already hold values.
+	if (!m_pTiles[tileIndex].compare_exchange_strong(pTile, pNewTile,
+		std::memory_order_acq_rel, std::memory_order_acquire))
+	{
+		delete[] pNewTile;
+		return pTile;
+	}
+	++m_allocatedTileCount;
+	return pNewTile;
+}
+
+float* TiledNoiseMap::GetSlabPtr(std::int64_t x, std::int64_t y)
+{
+	return GetOrAllocateTile(GetTileIndex(x, y)) + GetTileOffset(x, y);
+}
+
+float TiledNoiseMap::GetValue(std::int64_t x, std::int64_t y) const
+{
+	if (x >= 0 && x < m_width && y >= 0 && y < m_height)
+	{
+		return *(GetConstSlabPtr(x, y));
+	}
+	// The coordinates specified are outside the Noise map.  Return the border
+	// value.
+	return m_borderValue;
+}
+
+bool TiledNoiseMap::IsTileAllocated(std::int64_t x, std::int64_t y) const
+{
+	if (x >= 0 && x < m_width && y >= 0 && y < m_height)
+	{
+		return m_pTiles[GetTileIndex(x, y)].load() != NULL;
+	}
+	return false;
+}
+
+void TiledNoiseMap::SetSize(std::int64_t width, std::int64_t height)
+{
+	if (width < 0 || height < 0)
+	{
+		// Invalid width or height.
+		throw noise::ExceptionInvalidParam();
+	}
+
+	// The table of tiles is indexed with size_t values, so the number of
+	// tiles must fit within one.
+	std::int64_t xTileCount = (width + TILED_NOISE_MAP_TILE_SIZE - 1)
+		>> TILED_NOISE_MAP_TILE_SHIFT;
+	std::int64_t yTileCount = (height + TILED_NOISE_MAP_TILE_SIZE - 1)
+		>> TILED_NOISE_MAP_TILE_SHIFT;
+	if (xTileCount > 0 && (std::uint64_t)yTileCount
+		> (std::uint64_t)SIZE_MAX / sizeof(float*) / (std::uint64_t)xTileCount)
+	{
+		throw noise::ExceptionInvalidParam();
+	}
+
+	DeleteTiles();
+	m_pTiles.reset();
+	m_width = 0;
+	m_height = 0;
+	m_xTileCount = 0;
+	m_yTileCount = 0;
+	if (width == 0 || height == 0)
+	{
+		return;
+	}
+
+	size_t tileCount = (size_t)(xTileCount * yTileCount);
+	try
+	{
+		m_pTiles.reset(new std::atomic<float*>[tileCount]);
+	}
+	catch (...)
+	{
+		throw noise::ExceptionOutOfMemory();
+	}
+	for (size_t i = 0; i < tileCount; i++)
+	{
+		m_pTiles[i] = NULL;
+	}
+	m_width = width;
+	m_height = height;
+	m_xTileCount = xTileCount;
+	m_yTileCount = yTileCount;
+}
+
+void TiledNoiseMap::SetValue(std::int64_t x, std::int64_t y, float value)
+{
+	if (x >= 0 && x < m_width && y >= 0 && y < m_height)
+	{
+		*(GetSlabPtr(x, y)) = value;
+	}
+}
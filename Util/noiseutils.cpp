@@ -20,10 +20,22 @@
 // off every 'zig'.)
 //
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
 
+#include <noise/executor.h>
+#include <noise/fastmath.h>
+#include <noise/graph.h>
 #include <noise/interp.h>
 #include <noise/mathconsts.h>
+#include <noise/serialize.h>
 
 #include "noiseutils.h"
 
@@ -199,92 +211,140 @@ int WriterTER::CalcWidthByteCount (int width) const
   return (width * sizeof (int16));
 }
 
-void WriterTER::WriteDestFile ()
+void WriterTER::Begin (int width, int height)
 {
-  if (m_pSourceNoiseMap == NULL) {
+  // The header stores the width and height in 16-bit fields.
+  if (width > 65535 || height > 65535) {
     throw noise::ExceptionInvalidParam ();
   }
 
-  int width  = m_pSourceNoiseMap->GetWidth  ();
-  int height = m_pSourceNoiseMap->GetHeight ();
+  m_lineBuffer.resize ((size_t)CalcWidthByteCount (width));
+  m_writtenRowCount = 0;
 
-  int bufferSize = CalcWidthByteCount (width);
-  int destSize   = bufferSize * height;
-
-  // This buffer holds one horizontal line in the destination file.
-  noise::uint8* pLineBuffer = NULL;
-
-  // File object used to write the file.
-  std::ofstream os;
-  os.clear ();
-
-  // Allocate a buffer to hold one horizontal line in the height map.
-  try {
-    pLineBuffer = new noise::uint8[bufferSize];
-  }
-  catch (...) {
-    throw noise::ExceptionOutOfMemory ();
+  // Open the destination file.  A file left open by a build that stopped
+  // without calling End() or Abort() is closed first.
+  if (m_stream.is_open ()) {
+    m_stream.close ();
   }
-
-  // Open the destination file.
-  os.open (m_destFilename.c_str (), std::ios::out | std::ios::binary);
-  if (os.fail () || os.bad ()) {
-    os.clear ();
-    delete[] pLineBuffer;
+  m_stream.clear ();
+  m_stream.open (m_destFilename.c_str (), std::ios::out | std::ios::binary);
+  if (m_stream.fail () || m_stream.bad ()) {
+    m_stream.clear ();
     throw noise::ExceptionUnknown ();
   }
 
   // Build the header.
   noise::uint8 d[4];
   int16 heightScale = (int16)(floor (32768.0 / (double)m_metersPerPoint));
-  os.write ("TERRAGENTERRAIN ", 16);
-  os.write ("SIZE", 4);
-  os.write ((char*)UnpackLittle16 (d, GetMin (width, height) - 1), 2);
-  os.write ("\0\0", 2);
-  os.write ("XPTS", 4);
-  os.write ((char*)UnpackLittle16 (d, width), 2);
-  os.write ("\0\0", 2);
-  os.write ("YPTS", 4);
-  os.write ((char*)UnpackLittle16 (d, height), 2);
-  os.write ("\0\0", 2);
-  os.write ("SCAL", 4);
-  os.write ((char*)UnpackFloat (d, m_metersPerPoint), 4);
-  os.write ((char*)UnpackFloat (d, m_metersPerPoint), 4);
-  os.write ((char*)UnpackFloat (d, m_metersPerPoint), 4);
-  os.write ("ALTW", 4);
-  os.write ((char*)UnpackLittle16 (d, heightScale), 2);
-  os.write ("\0\0", 2);
-  if (os.fail () || os.bad ()) {
-    os.clear ();
-    os.close ();
-    os.clear ();
-    delete[] pLineBuffer;
+  m_stream.write ("TERRAGENTERRAIN ", 16);
+  m_stream.write ("SIZE", 4);
+  m_stream.write ((char*)UnpackLittle16 (d, GetMin (width, height) - 1), 2);
+  m_stream.write ("\0\0", 2);
+  m_stream.write ("XPTS", 4);
+  m_stream.write ((char*)UnpackLittle16 (d, width), 2);
+  m_stream.write ("\0\0", 2);
+  m_stream.write ("YPTS", 4);
+  m_stream.write ((char*)UnpackLittle16 (d, height), 2);
+  m_stream.write ("\0\0", 2);
+  m_stream.write ("SCAL", 4);
+  m_stream.write ((char*)UnpackFloat (d, m_metersPerPoint), 4);
+  m_stream.write ((char*)UnpackFloat (d, m_metersPerPoint), 4);
+  m_stream.write ((char*)UnpackFloat (d, m_metersPerPoint), 4);
+  m_stream.write ("ALTW", 4);
+  m_stream.write ((char*)UnpackLittle16 (d, heightScale), 2);
+  m_stream.write ("\0\0", 2);
+  if (m_stream.fail () || m_stream.bad ()) {
+    m_stream.clear ();
+    m_stream.close ();
+    m_stream.clear ();
     throw noise::ExceptionUnknown ();
   }
+}
 
-  // Build and write each horizontal line to the file.
-  for (int y = 0; y < height; y++) {
-    float* pSource = m_pSourceNoiseMap->GetSlabPtr (y);
-    noise::uint8* pDest   = pLineBuffer;
-    for (int x = 0; x < width; x++) {
-      int16 scaledHeight = (int16)(floor (*pSource * 2.0));
-      UnpackLittle16 (pDest, scaledHeight);
-      pDest += 2;
-      ++pSource;
+void WriterTER::Abort ()
+{
+  if (m_stream.is_open ()) {
+    m_stream.close ();
+    m_stream.clear ();
+    std::remove (m_destFilename.c_str ());
+  }
+}
+
+void WriterTER::End ()
+{
+  m_stream.close ();
+  m_stream.clear ();
+}
+
+noise::uint8* WriterTER::EncodeValues (const float* pSource, int count,
+  noise::uint8* pDest) const
+{
+  for (int x = 0; x < count; x++) {
+    int16 scaledHeight = (int16)(floor (*pSource * 2.0));
+    UnpackLittle16 (pDest, scaledHeight);
+    pDest += 2;
+    ++pSource;
+  }
+  return pDest;
+}
+
+void WriterTER::WriteDestFile ()
+{
+  if (m_pSourceTiledNoiseMap != NULL) {
+    const TiledNoiseMap& source = *m_pSourceTiledNoiseMap;
+    if (source.GetWidth () > 65535 || source.GetHeight () > 65535) {
+      throw noise::ExceptionInvalidParam ();
     }
-    os.write ((char*)pLineBuffer, (size_t)bufferSize);
-    if (os.fail () || os.bad ()) {
-      os.clear ();
-      os.close ();
-      os.clear ();
-      delete[] pLineBuffer;
-      throw noise::ExceptionUnknown ();
+
+    // Each horizontal line is gathered from the slabs of the tiles that it
+    // crosses.
+    Begin ((int)source.GetWidth (), (int)source.GetHeight ());
+    for (std::int64_t y = 0; y < source.GetHeight (); y++) {
+      noise::uint8* pDest = &m_lineBuffer[0];
+      for (std::int64_t x = 0; x < source.GetWidth (); ) {
+        int length = (int)source.GetSlabLength (x);
+        pDest = EncodeValues (source.GetConstSlabPtr (x, y), length, pDest);
+        x += length;
+      }
+      WriteLineBuffer ();
     }
+    End ();
+    return;
   }
 
-  os.close ();
-  os.clear ();
-  delete[] pLineBuffer;
+  if (m_pSourceNoiseMap == NULL) {
+    throw noise::ExceptionInvalidParam ();
+  }
+
+  Begin (m_pSourceNoiseMap->GetWidth (), m_pSourceNoiseMap->GetHeight ());
+  WriteStrip (*m_pSourceNoiseMap, 0);
+  End ();
+}
+
+void WriterTER::WriteLineBuffer ()
+{
+  m_stream.write ((char*)&m_lineBuffer[0], m_lineBuffer.size ());
+  if (m_stream.fail () || m_stream.bad ()) {
+    m_stream.clear ();
+    m_stream.close ();
+    m_stream.clear ();
+    throw noise::ExceptionUnknown ();
+  }
+}
+
+void WriterTER::WriteStrip (const NoiseMap& strip, int firstRow)
+{
+  if (firstRow != m_writtenRowCount) {
+    throw noise::ExceptionInvalidParam ();
+  }
+
+  // Build and write each horizontal line to the file.
+  int width = strip.GetWidth ();
+  for (int y = 0; y < strip.GetHeight (); y++) {
+    EncodeValues (strip.GetConstSlabPtr (y), width, &m_lineBuffer[0]);
+    WriteLineBuffer ();
+  }
+  m_writtenRowCount += strip.GetHeight ();
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -292,11 +352,553 @@ void WriterTER::WriteDestFile ()
 
 NoiseMapBuilder::NoiseMapBuilder ():
   m_pCallback (NULL),
+  m_pCancellationToken (NULL),
   m_destHeight (0),
   m_destWidth  (0),
   m_pDestNoiseMap (NULL),
-  m_pSourceModule (NULL)
+  m_pDestSink (NULL),
+  m_pDestTiledNoiseMap (NULL),
+  m_pProgressCallback (NULL),
+  m_pProgressContext (NULL),
+  m_isRefinementBoundsEnabled (false),
+  m_refinementBlockSize (DEFAULT_REFINEMENT_BLOCK_SIZE),
+  m_refinementStats (),
+  m_refinementTolerance (DEFAULT_REFINEMENT_TOLERANCE),
+  m_pSourceModule (NULL),
+  m_stripHeight (DEFAULT_BUILDER_STRIP_HEIGHT),
+  m_threadCount (DEFAULT_BUILDER_THREAD_COUNT),
+  m_tileHeight (DEFAULT_BUILDER_TILE_SIZE),
+  m_tileWidth  (DEFAULT_BUILDER_TILE_SIZE)
+{
+}
+
+void NoiseMapBuilder::AddLayer (const Module& sourceModule,
+  NoiseMap& destNoiseMap, NoiseMapSink* pSink)
+{
+  m_layerModules.push_back (&sourceModule);
+  m_layerNoiseMaps.push_back (&destNoiseMap);
+  m_layerSinks.push_back (pSink);
+  m_layerTiledNoiseMaps.push_back (NULL);
+}
+
+void NoiseMapBuilder::AddLayer (const Module& sourceModule,
+  TiledNoiseMap& destNoiseMap)
+{
+  m_layerModules.push_back (&sourceModule);
+  m_layerNoiseMaps.push_back (NULL);
+  m_layerSinks.push_back (NULL);
+  m_layerTiledNoiseMaps.push_back (&destNoiseMap);
+}
+
+void NoiseMapBuilder::ClearLayers ()
 {
+  m_layerModules.clear ();
+  m_layerNoiseMaps.clear ();
+  m_layerSinks.clear ();
+  m_layerTiledNoiseMaps.clear ();
+}
+
+void NoiseMapBuilder::BuildTiles (const TileGenerator& generateTile)
+{
+  m_refinementStats = RefinementStats ();
+
+  // When streaming, the Noise maps only hold one strip at a time.  The
+  // tiled Noise maps always hold the whole Noise map.
+  std::vector<NoiseMap*> destNoiseMaps = GetDestNoiseMaps ();
+  std::vector<TiledNoiseMap*> destTiledNoiseMaps = GetDestTiledNoiseMaps ();
+  std::vector<NoiseMapSink*> sinks = GetDestSinks ();
+  size_t outputCount = destNoiseMaps.size ();
+  bool isStreaming = m_pDestSink != NULL;
+  if (isStreaming && m_pDestNoiseMap == NULL) {
+    throw noise::ExceptionInvalidParam ();
+  }
+  int stripHeight = isStreaming? GetMin (m_stripHeight, m_destHeight):
+    m_destHeight;
+  for (size_t i = 0; i < outputCount; i++) {
+    if (destNoiseMaps[i] != NULL) {
+      destNoiseMaps[i]->SetSize (m_destWidth, stripHeight);
+    } else {
+      destTiledNoiseMaps[i]->SetSize (m_destWidth, m_destHeight);
+    }
+  }
+
+  int tileWidth  = GetMin (m_tileWidth , m_destWidth );
+  int tileHeight = GetMin (m_tileHeight, stripHeight );
+  int xTileCount = (m_destWidth  + tileWidth  - 1) / tileWidth ;
+
+  if (m_pScheduler == nullptr
+    || m_pScheduler->GetThreadCount () != m_threadCount) {
+    m_pScheduler.reset ();
+    m_pScheduler = std::make_unique<TaskScheduler> (m_threadCount);
+  }
+
+  // Each thread evaluates its tiles with its own executor, since an
+  // executor stores the intermediate output values of the tile it is
+  // evaluating.  The executors are created up front so that a graph with a
+  // missing source module is reported before any tile is built.
+  struct ThreadBuffers
+  {
+    std::unique_ptr<RasterExecutor> pExecutor;
+    std::vector<double> workspace;
+    std::vector<double> values;
+    std::vector<double*> valueTiles;
+  };
+  std::vector<ThreadBuffers> threadBuffers (m_threadCount);
+  for (ThreadBuffers& buffers: threadBuffers) {
+    buffers.pExecutor = std::make_unique<RasterExecutor> (GetSourceModules ());
+    buffers.values.resize (outputCount * tileWidth * tileHeight);
+    buffers.valueTiles.resize (outputCount);
+  }
+
+  std::mutex callbackMutex;
+  int completedRowCount = 0;
+
+  // The threads add up the points they fill in without taking a lock.  The
+  // progress callback function is only called by a thread that can take
+  // the lock at once; the other threads carry on with their next tile.
+  std::atomic<std::int64_t> completedPointCount (0);
+  std::mutex progressMutex;
+  auto startTime = std::chrono::steady_clock::now ();
+  auto reportProgress = [&] () {
+    BuildProgress progress;
+    progress.completedPointCount = completedPointCount;
+    progress.totalPointCount = (std::int64_t)m_destWidth * m_destHeight;
+    progress.elapsedTime = std::chrono::duration<double> (
+      std::chrono::steady_clock::now () - startTime).count ();
+    progress.remainingTime = 0.0;
+    if (progress.completedPointCount > 0) {
+      progress.remainingTime = progress.elapsedTime
+        * (double)(progress.totalPointCount - progress.completedPointCount)
+        / (double)progress.completedPointCount;
+    }
+    progress.pContext = m_pProgressContext;
+    m_pProgressCallback (progress);
+  };
+
+  // A sink that began the Noise map but did not end it is aborted if the
+  // build stops early, such as when it is cancelled.
+  struct SinkGuard
+  {
+    std::vector<NoiseMapSink*> openSinks;
+    ~SinkGuard ()
+    {
+      for (NoiseMapSink* pSink: openSinks) {
+        pSink->Abort ();
+      }
+    }
+  } sinkGuard;
+
+  if (isStreaming) {
+    for (NoiseMapSink* pSink: sinks) {
+      if (pSink != NULL) {
+        pSink->Begin (m_destWidth, m_destHeight);
+        sinkGuard.openSinks.push_back (pSink);
+      }
+    }
+  }
+
+  for (int stripRow = 0; stripRow < m_destHeight; stripRow += stripHeight) {
+    int stripRowCount = GetMin (stripHeight, m_destHeight - stripRow);
+    if (stripRowCount < stripHeight) {
+      for (NoiseMap* pDestNoiseMap: destNoiseMaps) {
+        if (pDestNoiseMap != NULL) {
+          pDestNoiseMap->SetSize (m_destWidth, stripRowCount);
+        }
+      }
+    }
+    int yTileCount = (stripRowCount + tileHeight - 1) / tileHeight;
+
+    // Sort the tiles of the strip along a Z-order curve, so that each
+    // thread builds a compact block of the Noise map and a thread that
+    // steals tiles takes a compact block as well.
+    std::vector<std::pair<std::uint64_t, int>> tileOrder;
+    for (int ty = 0; ty < yTileCount; ty++) {
+      for (int tx = 0; tx < xTileCount; tx++) {
+        std::uint64_t key = 0;
+        for (int bit = 0; bit < 32; bit++) {
+          key |= (std::uint64_t)((tx >> bit) & 1) << (2 * bit);
+          key |= (std::uint64_t)((ty >> bit) & 1) << (2 * bit + 1);
+        }
+        tileOrder.push_back (std::make_pair (key, ty * xTileCount + tx));
+      }
+    }
+    std::sort (tileOrder.begin (), tileOrder.end ());
+
+    // The rows covered by a row of tiles are complete once its last tile
+    // is.
+    std::unique_ptr<std::atomic<int>[]> remainingTileCounts (
+      new std::atomic<int>[yTileCount]);
+    for (int ty = 0; ty < yTileCount; ty++) {
+      remainingTileCounts[ty] = xTileCount;
+    }
+
+    m_pScheduler->Run ((int)tileOrder.size (), [&] (int task, int thread) {
+      if (m_pCancellationToken != NULL
+        && m_pCancellationToken->IsCancelled ()) {
+        throw noise::ExceptionCancelled ();
+      }
+      int tileIndex = tileOrder[task].second;
+      int ty = tileIndex / xTileCount;
+      int x = (tileIndex % xTileCount) * tileWidth;
+      int y = ty * tileHeight;
+      int width  = GetMin (tileWidth , m_destWidth   - x);
+      int height = GetMin (tileHeight, stripRowCount - y);
+      ThreadBuffers& buffers = threadBuffers[thread];
+      for (size_t i = 0; i < outputCount; i++) {
+        buffers.valueTiles[i] = &buffers.values[i * width * height];
+      }
+      generateTile (x, stripRow + y, width, height, *buffers.pExecutor,
+        buffers.workspace, &buffers.valueTiles[0]);
+      WriteTile (destNoiseMaps, destTiledNoiseMaps, x, y, stripRow, width,
+        height, buffers.valueTiles);
+      if (--remainingTileCounts[ty] == 0 && m_pCallback != NULL) {
+        std::lock_guard<std::mutex> lock (callbackMutex);
+        for (int row = 0; row < height; row++) {
+          m_pCallback (completedRowCount++);
+        }
+      }
+      completedPointCount.fetch_add (width * height,
+        std::memory_order_relaxed);
+      if (m_pProgressCallback != NULL) {
+        std::unique_lock<std::mutex> lock (progressMutex, std::try_to_lock);
+        if (lock.owns_lock ()) {
+          reportProgress ();
+        }
+      }
+    });
+
+    if (isStreaming) {
+      for (size_t i = 0; i < outputCount; i++) {
+        if (sinks[i] != NULL) {
+          sinks[i]->WriteStrip (*destNoiseMaps[i], stripRow);
+        }
+      }
+    }
+  }
+
+  while (!sinkGuard.openSinks.empty ()) {
+    sinkGuard.openSinks.front ()->End ();
+    sinkGuard.openSinks.erase (sinkGuard.openSinks.begin ());
+  }
+
+  // Report the completed Noise map, which a skipped call may have missed.
+  if (m_pProgressCallback != NULL) {
+    std::lock_guard<std::mutex> lock (progressMutex);
+    reportProgress ();
+  }
+}
+
+void NoiseMapBuilder::BuildRefinedTiles (const PointMapper& mapPoints)
+{
+  std::vector<const Module*> sourceModules = GetSourceModules ();
+  size_t outputCount = sourceModules.size ();
+  int blockSize = m_refinementBlockSize;
+  double tolerance = m_refinementTolerance;
+
+  // The threads add up their counts without taking a lock.  A block is
+  // counted by the tile that holds its upper-left point, so a block that
+  // spans several tiles is only counted once.
+  std::atomic<std::int64_t> evaluatedPointCount (0);
+  std::atomic<std::int64_t> blockCount (0);
+  std::atomic<std::int64_t> boundedBlockCount (0);
+  std::atomic<std::int64_t> refinedBlockCount (0);
+
+  BuildTiles ([&] (int x0, int y0, int width, int height,
+    RasterExecutor& executor, std::vector<double>& workspace,
+    double* const* values) {
+    // Evaluates a list of points; the output values of each Noise map are
+    // stored one after another.
+    auto evaluatePoints = [&] (const std::vector<int>& columns,
+      const std::vector<int>& rows, std::vector<double>& pointValues) {
+      int count = (int)columns.size ();
+      pointValues.resize (outputCount * count);
+      if (count == 0) {
+        return;
+      }
+      workspace.resize (3 * count);
+      double* xPoints = &workspace[0];
+      double* yPoints = xPoints + count;
+      double* zPoints = yPoints + count;
+      mapPoints (count, &columns[0], &rows[0], xPoints, yPoints, zPoints);
+      std::vector<double*> valueRows (outputCount);
+      for (size_t i = 0; i < outputCount; i++) {
+        valueRows[i] = &pointValues[i * count];
+      }
+      executor.GetValues (count, xPoints, yPoints, zPoints, &valueRows[0]);
+      evaluatedPointCount.fetch_add (count, std::memory_order_relaxed);
+    };
+
+    // The lattice holds the corners of the blocks that overlap the tile
+    // and of their neighbours, the midpoints of their edges and their
+    // centers.  Each block spans three columns and three rows of the
+    // lattice, and shares the outer ones with its neighbours.  The blocks
+    // are aligned to the whole Noise map, and the last block of each row
+    // and column ends on the edge of the Noise map, so a block is handled
+    // identically by every tile that it overlaps or borders.
+    int xBlockBegin = GetMax (x0 / blockSize - 1, 0);
+    int yBlockBegin = GetMax (y0 / blockSize - 1, 0);
+    int xBlockCount = GetMin ((x0 + width  - 1) / blockSize + 1,
+      (m_destWidth  - 1) / blockSize) - xBlockBegin + 1;
+    int yBlockCount = GetMin ((y0 + height - 1) / blockSize + 1,
+      (m_destHeight - 1) / blockSize) - yBlockBegin + 1;
+    int latticeWidth  = 2 * xBlockCount + 1;
+    int latticeHeight = 2 * yBlockCount + 1;
+    int latticeSize = latticeWidth * latticeHeight;
+    std::vector<int> latticeColumns (latticeWidth);
+    std::vector<int> latticeRows (latticeHeight);
+    for (int bx = 0; bx < xBlockCount; bx++) {
+      int first = (xBlockBegin + bx) * blockSize;
+      int last = GetMin (first + blockSize, m_destWidth - 1);
+      latticeColumns[2 * bx    ] = first;
+      latticeColumns[2 * bx + 1] = (first + last) / 2;
+      latticeColumns[2 * bx + 2] = last;
+    }
+    for (int by = 0; by < yBlockCount; by++) {
+      int first = (yBlockBegin + by) * blockSize;
+      int last = GetMin (first + blockSize, m_destHeight - 1);
+      latticeRows[2 * by    ] = first;
+      latticeRows[2 * by + 1] = (first + last) / 2;
+      latticeRows[2 * by + 2] = last;
+    }
+
+    std::vector<double> latticeValues (outputCount * latticeSize);
+    std::vector<bool> isListed (latticeSize, false);
+    std::vector<int> columns, rows, latticeIndices;
+    std::vector<double> pointValues;
+    auto addLatticePoint = [&] (int lx, int ly) {
+      int index = ly * latticeWidth + lx;
+      if (!isListed[index]) {
+        isListed[index] = true;
+        columns.push_back (latticeColumns[lx]);
+        rows.push_back (latticeRows[ly]);
+        latticeIndices.push_back (index);
+      }
+    };
+    auto evaluateLatticePoints = [&] () {
+      evaluatePoints (columns, rows, pointValues);
+      size_t count = latticeIndices.size ();
+      for (size_t i = 0; i < outputCount; i++) {
+        for (size_t j = 0; j < count; j++) {
+          latticeValues[i * latticeSize + latticeIndices[j]] =
+            pointValues[i * count + j];
+        }
+      }
+      columns.clear ();
+      rows.clear ();
+      latticeIndices.clear ();
+    };
+
+    // Bilinearly interpolates an output value from the corners of a block.
+    auto interpolate = [&] (size_t i, int bx, int by, int column, int row) {
+      const double* pCorners = &latticeValues[i * latticeSize
+        + 2 * by * latticeWidth + 2 * bx];
+      int left  = latticeColumns[2 * bx], right  = latticeColumns[2 * bx + 2];
+      int top   = latticeRows   [2 * by], bottom = latticeRows   [2 * by + 2];
+      double xAlpha = right  > left? (double)(column - left) / (right  - left):
+        0.0;
+      double yAlpha = bottom > top ? (double)(row    - top ) / (bottom - top ):
+        0.0;
+      double topValue = LinearInterp (pCorners[0], pCorners[2], xAlpha);
+      double bottomValue = LinearInterp (pCorners[2 * latticeWidth],
+        pCorners[2 * latticeWidth + 2], xAlpha);
+      return LinearInterp (topValue, bottomValue, yAlpha);
+    };
+
+    // Evaluate the corners of every block first.
+    for (int ly = 0; ly < latticeHeight; ly += 2) {
+      for (int lx = 0; lx < latticeWidth; lx += 2) {
+        addLatticePoint (lx, ly);
+      }
+    }
+    evaluateLatticePoints ();
+
+    // A block whose output values are bounded within the tolerance needs
+    // no test points.  Every point of the block, including its corners, has
+    // its input value within the bounding box of the points, so both the
+    // evaluated and the interpolated output values lie within the bounds.
+    int blockTotal = xBlockCount * yBlockCount;
+    std::vector<bool> isBounded (blockTotal, false);
+    std::vector<bool> isOverTolerance (blockTotal, false);
+    std::vector<bool> isRefined (blockTotal, false);
+    if (m_isRefinementBoundsEnabled) {
+      std::vector<int> blockColumns, blockRows;
+      for (int by = 0; by < yBlockCount; by++) {
+        for (int bx = 0; bx < xBlockCount; bx++) {
+          blockColumns.clear ();
+          blockRows.clear ();
+          for (int row = latticeRows[2 * by]; row <= latticeRows[2 * by + 2];
+            row++) {
+            for (int column = latticeColumns[2 * bx];
+              column <= latticeColumns[2 * bx + 2]; column++) {
+              blockColumns.push_back (column);
+              blockRows.push_back (row);
+            }
+          }
+          int count = (int)blockColumns.size ();
+          workspace.resize (3 * count);
+          double* xPoints = &workspace[0];
+          double* yPoints = xPoints + count;
+          double* zPoints = yPoints + count;
+          mapPoints (count, &blockColumns[0], &blockRows[0], xPoints, yPoints,
+            zPoints);
+          Box box = MakeBoundingBox (count, xPoints, yPoints, zPoints);
+          bool isWithinTolerance = true;
+          for (const Module* pSourceModule: sourceModules) {
+            Interval range = pSourceModule->GetValueRange (box);
+            if (!(range.upper - range.lower <= tolerance)) {
+              isWithinTolerance = false;
+              break;
+            }
+          }
+          isBounded[by * xBlockCount + bx] = isWithinTolerance;
+        }
+      }
+    }
+
+    // Evaluate the midpoints of the edges and the center of every other
+    // block, and compare them with the interpolated output values.
+    for (int by = 0; by < yBlockCount; by++) {
+      for (int bx = 0; bx < xBlockCount; bx++) {
+        if (!isBounded[by * xBlockCount + bx]) {
+          addLatticePoint (2 * bx + 1, 2 * by    );
+          addLatticePoint (2 * bx    , 2 * by + 1);
+          addLatticePoint (2 * bx + 1, 2 * by + 1);
+          addLatticePoint (2 * bx + 2, 2 * by + 1);
+          addLatticePoint (2 * bx + 1, 2 * by + 2);
+        }
+      }
+    }
+    evaluateLatticePoints ();
+    const int testPoints[5][2] = {{1, 0}, {0, 1}, {1, 1}, {2, 1}, {1, 2}};
+    for (int by = 0; by < yBlockCount; by++) {
+      for (int bx = 0; bx < xBlockCount; bx++) {
+        int block = by * xBlockCount + bx;
+        if (isBounded[block]) {
+          continue;
+        }
+        double error = 0.0;
+        for (const int* pTestPoint: testPoints) {
+          int lx = 2 * bx + pTestPoint[0];
+          int ly = 2 * by + pTestPoint[1];
+          for (size_t i = 0; i < outputCount; i++) {
+            double value = latticeValues[i * latticeSize
+              + ly * latticeWidth + lx];
+            error = GetMax (error, fabs (value - interpolate (i, bx, by,
+              latticeColumns[lx], latticeRows[ly])));
+          }
+        }
+        isOverTolerance[block] = error > tolerance;
+      }
+    }
+
+    // A detail smaller than half a block may slip between the test points
+    // of one block but not those of its neighbours, so every block next to
+    // a block over the tolerance is refined as well, unless its bounds
+    // already prove it smooth.
+    for (int by = 0; by < yBlockCount; by++) {
+      for (int bx = 0; bx < xBlockCount; bx++) {
+        int block = by * xBlockCount + bx;
+        if (isBounded[block]) {
+          continue;
+        }
+        for (int ny = GetMax (by - 1, 0);
+          ny <= GetMin (by + 1, yBlockCount - 1); ny++) {
+          for (int nx = GetMax (bx - 1, 0);
+            nx <= GetMin (bx + 1, xBlockCount - 1); nx++) {
+            if (isOverTolerance[ny * xBlockCount + nx]) {
+              isRefined[block] = true;
+            }
+          }
+        }
+      }
+    }
+
+    for (int by = 0; by < yBlockCount; by++) {
+      for (int bx = 0; bx < xBlockCount; bx++) {
+        int block = by * xBlockCount + bx;
+        if (latticeColumns[2 * bx] >= x0 && latticeColumns[2 * bx] < x0 + width
+          && latticeRows[2 * by] >= y0 && latticeRows[2 * by] < y0 + height) {
+          blockCount.fetch_add (1, std::memory_order_relaxed);
+          if (isBounded[block]) {
+            boundedBlockCount.fetch_add (1, std::memory_order_relaxed);
+          }
+          if (isRefined[block]) {
+            refinedBlockCount.fetch_add (1, std::memory_order_relaxed);
+          }
+        }
+      }
+    }
+
+    // Evaluate every point of the tile that lies within a refined block,
+    // and interpolate the others.
+    std::vector<int> denseIndices;
+    for (int y = 0; y < height; y++) {
+      int by = (y0 + y) / blockSize - yBlockBegin;
+      for (int x = 0; x < width; x++) {
+        int bx = (x0 + x) / blockSize - xBlockBegin;
+        if (isRefined[by * xBlockCount + bx]) {
+          columns.push_back (x0 + x);
+          rows.push_back (y0 + y);
+          denseIndices.push_back (y * width + x);
+        }
+      }
+    }
+    evaluatePoints (columns, rows, pointValues);
+    size_t denseCount = denseIndices.size ();
+    for (size_t i = 0; i < outputCount; i++) {
+      double* pValue = values[i];
+      for (int y = 0; y < height; y++) {
+        int by = (y0 + y) / blockSize - yBlockBegin;
+        for (int x = 0; x < width; x++) {
+          int bx = (x0 + x) / blockSize - xBlockBegin;
+          if (!isRefined[by * xBlockCount + bx]) {
+            pValue[y * width + x] = interpolate (i, bx, by, x0 + x, y0 + y);
+          }
+        }
+      }
+      for (size_t j = 0; j < denseCount; j++) {
+        pValue[denseIndices[j]] = pointValues[i * denseCount + j];
+      }
+    }
+  });
+
+  m_refinementStats.totalPointCount = (std::int64_t)m_destWidth
+    * m_destHeight;
+  m_refinementStats.evaluatedPointCount = evaluatedPointCount;
+  m_refinementStats.blockCount = blockCount;
+  m_refinementStats.boundedBlockCount = boundedBlockCount;
+  m_refinementStats.refinedBlockCount = refinedBlockCount;
+}
+
+std::vector<NoiseMapSink*> NoiseMapBuilder::GetDestSinks () const
+{
+  std::vector<NoiseMapSink*> sinks (1, m_pDestSink);
+  sinks.insert (sinks.end (), m_layerSinks.begin (), m_layerSinks.end ());
+  return sinks;
+}
+
+std::vector<NoiseMap*> NoiseMapBuilder::GetDestNoiseMaps () const
+{
+  std::vector<NoiseMap*> destNoiseMaps (1, m_pDestNoiseMap);
+  destNoiseMaps.insert (destNoiseMaps.end (), m_layerNoiseMaps.begin (),
+    m_layerNoiseMaps.end ());
+  return destNoiseMaps;
+}
+
+std::vector<TiledNoiseMap*> NoiseMapBuilder::GetDestTiledNoiseMaps () const
+{
+  std::vector<TiledNoiseMap*> destTiledNoiseMaps (1, m_pDestTiledNoiseMap);
+  destTiledNoiseMaps.insert (destTiledNoiseMaps.end (),
+    m_layerTiledNoiseMaps.begin (), m_layerTiledNoiseMaps.end ());
+  return destTiledNoiseMaps;
+}
+
+std::vector<const Module*> NoiseMapBuilder::GetSourceModules () const
+{
+  std::vector<const Module*> sourceModules (1, m_pSourceModule);
+  sourceModules.insert (sourceModules.end (), m_layerModules.begin (),
+    m_layerModules.end ());
+  return sourceModules;
 }
 
 void NoiseMapBuilder::SetCallback (NoiseMapCallback pCallback)
@@ -304,6 +906,178 @@ void NoiseMapBuilder::SetCallback (NoiseMapCallback pCallback)
   m_pCallback = pCallback;
 }
 
+void NoiseMapBuilder::SetDestSink (NoiseMapSink* pSink, int stripHeight)
+{
+  if (stripHeight < 1) {
+    throw noise::ExceptionInvalidParam ();
+  }
+  m_pDestSink = pSink;
+  m_stripHeight = stripHeight;
+}
+
+void NoiseMapBuilder::SetRefinementBlockSize (int blockSize)
+{
+  if (blockSize < 2) {
+    throw noise::ExceptionInvalidParam ();
+  }
+  m_refinementBlockSize = blockSize;
+}
+
+void NoiseMapBuilder::SetRefinementTolerance (double tolerance)
+{
+  if (tolerance < 0.0) {
+    throw noise::ExceptionInvalidParam ();
+  }
+  m_refinementTolerance = tolerance;
+}
+
+void NoiseMapBuilder::SetThreadCount (int threadCount)
+{
+  if (threadCount < 1) {
+    throw noise::ExceptionInvalidParam ();
+  }
+  m_threadCount = threadCount;
+}
+
+void NoiseMapBuilder::SetTileSize (int tileWidth, int tileHeight)
+{
+  if (tileWidth < 1 || tileHeight < 1) {
+    throw noise::ExceptionInvalidParam ();
+  }
+  m_tileWidth  = tileWidth ;
+  m_tileHeight = tileHeight;
+}
+
+void NoiseMapBuilder::WriteTile (const std::vector<NoiseMap*>& destNoiseMaps,
+  const std::vector<TiledNoiseMap*>& destTiledNoiseMaps, int x, int y,
+  int stripRow, int width, int height,
+  const std::vector<double*>& values) const
+{
+  for (size_t i = 0; i < destNoiseMaps.size (); i++) {
+    const double* pValue = values[i];
+    if (destNoiseMaps[i] != NULL) {
+      for (int row = y; row < y + height; row++) {
+        float* pDest = destNoiseMaps[i]->GetSlabPtr (x, row);
+        for (int column = 0; column < width; column++) {
+          *pDest++ = (float)*pValue++;
+        }
+      }
+      continue;
+    }
+
+    // A row of the tile may span several tiles of the tiled Noise map.
+    TiledNoiseMap* pDestNoiseMap = destTiledNoiseMaps[i];
+    for (int row = stripRow + y; row < stripRow + y + height; row++) {
+      for (int column = x; column < x + width; ) {
+        int length = (int)GetMin<std::int64_t> (
+          pDestNoiseMap->GetSlabLength (column), x + width - column);
+        float* pDest = pDestNoiseMap->GetSlabPtr (column, row);
+        for (int point = 0; point < length; point++) {
+          *pDest++ = (float)*pValue++;
+        }
+        column += length;
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// NoiseMapBuilderCubeSphere class
+
+NoiseMapBuilderCubeSphere::NoiseMapBuilderCubeSphere ():
+  m_apronWidth (0),
+  m_faceSize (0),
+  m_projection (DEFAULT_CUBE_PROJECTION)
+{
+}
+
+void NoiseMapBuilderCubeSphere::Build ()
+{
+  if ( m_faceSize <= 0
+    || 2 * m_apronWidth > m_faceSize
+    || m_pSourceModule == NULL
+    || !HasDestNoiseMap ()) {
+    throw noise::ExceptionInvalidParam ();
+  }
+
+  // The Noise maps store the six faces and their aprons.
+  int faceSpan = GetFaceSpan ();
+  m_destWidth  = faceSpan;
+  m_destHeight = CUBE_FACE_COUNT * faceSpan;
+
+  // Every face has the same coordinates along its columns and its rows, so
+  // they are only projected once.  The apron continues the projection past
+  // the edges of the face; since it is at most half a face wide, the
+  // equal-angle projection stays below a right angle.
+  std::vector<double> coords (faceSpan);
+  for (int i = 0; i < faceSpan; i++) {
+    double u = (2.0 * (i - m_apronWidth) + 1.0) / (double)m_faceSize - 1.0;
+    if (m_projection == CUBE_PROJECTION_EQUAL_ANGLE) {
+      u = tan (u * PI / 4.0);
+    }
+    coords[i] = u;
+  }
+
+  // Each tile of the Noise map is evaluated as a single tile of input values
+  // located on the surface of the sphere.  A tile may cover the rows of two
+  // faces, so the face is looked up for every row.
+  BuildTiles ([&] (int x0, int y0, int width, int height,
+    RasterExecutor& executor, std::vector<double>& workspace,
+    double* const* values) {
+    int count = width * height;
+    workspace.resize (3 * count);
+    double* xTile = &workspace[0];
+    double* yTile = xTile + count;
+    double* zTile = yTile + count;
+    for (int y = 0; y < height; y++) {
+      int face = (y0 + y) / faceSpan;
+      double v = coords[(y0 + y) % faceSpan];
+      for (int x = 0; x < width; x++) {
+        double u = coords[x0 + x];
+        double cubeX, cubeY, cubeZ;
+        switch (face) {
+          case CUBE_FACE_POSITIVE_X:
+            cubeX =  1.0; cubeY = -v; cubeZ = -u ; break;
+          case CUBE_FACE_NEGATIVE_X:
+            cubeX = -1.0; cubeY = -v; cubeZ =  u ; break;
+          case CUBE_FACE_POSITIVE_Y:
+            cubeX =  u  ; cubeY = 1.0; cubeZ =  v; break;
+          case CUBE_FACE_NEGATIVE_Y:
+            cubeX =  u  ; cubeY = -1.0; cubeZ = -v; break;
+          case CUBE_FACE_POSITIVE_Z:
+            cubeX =  u  ; cubeY = -v; cubeZ =  1.0; break;
+          default:
+            cubeX = -u  ; cubeY = -v; cubeZ = -1.0; break;
+        }
+        double scale = 1.0 / sqrt (u * u + v * v + 1.0);
+        xTile[y * width + x] = cubeX * scale;
+        yTile[y * width + x] = cubeY * scale;
+        zTile[y * width + x] = cubeZ * scale;
+      }
+    }
+    executor.GetValues (count, xTile, yTile, zTile, values);
+  });
+}
+
+void NoiseMapBuilderCubeSphere::GetFaceNoiseMap (const NoiseMap& cubeNoiseMap,
+  CubeFace face, NoiseMap& faceNoiseMap) const
+{
+  int faceSpan = GetFaceSpan ();
+  if ( cubeNoiseMap.GetWidth  () != faceSpan
+    || cubeNoiseMap.GetHeight () != CUBE_FACE_COUNT * faceSpan
+    || face < 0 || face >= CUBE_FACE_COUNT) {
+    throw noise::ExceptionInvalidParam ();
+  }
+
+  faceNoiseMap.SetSize (faceSpan, faceSpan);
+  for (int y = 0; y < faceSpan; y++) {
+    const float* pSource = cubeNoiseMap.GetConstSlabPtr (GetFaceRow (face)
+      + y);
+    float* pDest = faceNoiseMap.GetSlabPtr (y);
+    memcpy (pDest, pSource, (size_t)faceSpan * sizeof (float));
+  }
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // NoiseMapBuilderCylinder class
 
@@ -322,39 +1096,60 @@ void NoiseMapBuilderCylinder::Build ()
     || m_destWidth <= 0
     || m_destHeight <= 0
     || m_pSourceModule == NULL
-    || m_pDestNoiseMap == NULL) {
+    || !HasDestNoiseMap ()) {
     throw noise::ExceptionInvalidParam ();
   }
 
-  // Resize the destination Noise map so that it can store the new output
-  // values from the source model.
-  m_pDestNoiseMap->SetSize (m_destWidth, m_destHeight);
-
-  // Create the cylinder model.
-  model::Cylinder cylinderModel;
-  cylinderModel.SetModule (*m_pSourceModule);
-
   double angleExtent  = m_upperAngleBound  - m_lowerAngleBound ;
   double heightExtent = m_upperHeightBound - m_lowerHeightBound;
   double xDelta = angleExtent  / (double)m_destWidth ;
   double yDelta = heightExtent / (double)m_destHeight;
-  double curAngle  = m_lowerAngleBound ;
-  double curHeight = m_lowerHeightBound;
 
-  // Fill every point in the Noise map with the output values from the model.
-  for (int y = 0; y < m_destHeight; y++) {
-    float* pDest = m_pDestNoiseMap->GetSlabPtr (y);
-    curAngle = m_lowerAngleBound;
-    for (int x = 0; x < m_destWidth; x++) {
-      float curValue = (float)cylinderModel.GetValue (curAngle, curHeight);
-      *pDest++ = curValue;
-      curAngle += xDelta;
-    }
-    curHeight += yDelta;
-    if (m_pCallback != NULL) {
-      m_pCallback (y);
-    }
+  // Every row has the same angles, so their sines and cosines are only
+  // calculated once.  The coordinates of each point are calculated from its
+  // indices, so that every tile can be generated independently.
+  std::vector<double> angles (m_destWidth);
+  std::vector<double> xColumns (m_destWidth);
+  std::vector<double> zColumns (m_destWidth);
+  for (int x = 0; x < m_destWidth; x++) {
+    angles[x] = (m_lowerAngleBound + x * xDelta) * DEG_TO_RAD;
   }
+  MathSinCos (m_destWidth, &angles[0], &zColumns[0], &xColumns[0]);
+
+  if (m_refinementTolerance > 0.0) {
+    BuildRefinedTiles ([&] (int count, const int* columns, const int* rows,
+      double* x, double* y, double* z) {
+      for (int i = 0; i < count; i++) {
+        x[i] = xColumns[columns[i]];
+        y[i] = m_lowerHeightBound + rows[i] * yDelta;
+        z[i] = zColumns[columns[i]];
+      }
+    });
+    return;
+  }
+
+  // Each tile of the Noise map is evaluated as a single tile of input values
+  // located on the surface of the cylinder.  The executor evaluates the
+  // source module and the source modules of the layers together, one Noise
+  // module at a time over the whole tile.
+  BuildTiles ([&] (int x0, int y0, int width, int height,
+    RasterExecutor& executor, std::vector<double>& workspace,
+    double* const* values) {
+    int count = width * height;
+    workspace.resize (3 * count);
+    double* xTile = &workspace[0];
+    double* yTile = xTile + count;
+    double* zTile = yTile + count;
+    for (int y = 0; y < height; y++) {
+      double curHeight = m_lowerHeightBound + (y0 + y) * yDelta;
+      for (int x = 0; x < width; x++) {
+        xTile[y * width + x] = xColumns[x0 + x];
+        yTile[y * width + x] = curHeight;
+        zTile[y * width + x] = zColumns[x0 + x];
+      }
+    }
+    executor.GetValues (count, xTile, yTile, zTile, values);
+  });
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -376,59 +1171,125 @@ void NoiseMapBuilderPlane::Build ()
     || m_destWidth <= 0
     || m_destHeight <= 0
     || m_pSourceModule == NULL
-    || m_pDestNoiseMap == NULL) {
+    || !HasDestNoiseMap ()) {
     throw noise::ExceptionInvalidParam ();
   }
 
-  // Resize the destination Noise map so that it can store the new output
-  // values from the source model.
-  m_pDestNoiseMap->SetSize (m_destWidth, m_destHeight);
-
-  // Create the plane model.
-  model::Plane planeModel;
-  planeModel.SetModule (*m_pSourceModule);
-
   double xExtent = m_upperXBound - m_lowerXBound;
   double zExtent = m_upperZBound - m_lowerZBound;
   double xDelta  = xExtent / (double)m_destWidth ;
   double zDelta  = zExtent / (double)m_destHeight;
-  double xCur    = m_lowerXBound;
-  double zCur    = m_lowerZBound;
-
-  // Fill every point in the Noise map with the output values from the model.
-  for (int z = 0; z < m_destHeight; z++) {
-    float* pDest = m_pDestNoiseMap->GetSlabPtr (z);
-    xCur = m_lowerXBound;
-    for (int x = 0; x < m_destWidth; x++) {
-      float finalValue;
-      if (!m_isSeamlessEnabled) {
-        finalValue = planeModel.GetValue (xCur, zCur);
-      } else {
-        double swValue, seValue, nwValue, neValue;
-        swValue = planeModel.GetValue (xCur          , zCur          );
-        seValue = planeModel.GetValue (xCur + xExtent, zCur          );
-        nwValue = planeModel.GetValue (xCur          , zCur + zExtent);
-        neValue = planeModel.GetValue (xCur + xExtent, zCur + zExtent);
-        double xBlend = 1.0 - ((xCur - m_lowerXBound) / xExtent);
-        double zBlend = 1.0 - ((zCur - m_lowerZBound) / zExtent);
-        double z0 = LinearInterp (swValue, seValue, xBlend);
-        double z1 = LinearInterp (nwValue, neValue, xBlend);
-        finalValue = (float)LinearInterp (z0, z1, zBlend);
+
+  // Every row has the same x coordinates.  The coordinates of each point
+  // are calculated from its indices, so that every tile can be generated
+  // independently.
+  std::vector<double> xColumns (m_destWidth);
+  std::vector<double> xBlends (m_destWidth);
+  for (int x = 0; x < m_destWidth; x++) {
+    xColumns[x] = m_lowerXBound + x * xDelta;
+    xBlends[x] = 1.0 - ((xColumns[x] - m_lowerXBound) / xExtent);
+  }
+
+  if (m_refinementTolerance > 0.0 && !m_isSeamlessEnabled) {
+    BuildRefinedTiles ([&] (int count, const int* columns, const int* rows,
+      double* x, double* y, double* z) {
+      for (int i = 0; i < count; i++) {
+        x[i] = xColumns[columns[i]];
+        y[i] = 0.0;
+        z[i] = m_lowerZBound + rows[i] * zDelta;
+      }
+    });
+    return;
+  }
+
+  // Each tile of the Noise map is evaluated as a single tile of input values
+  // located on the surface of the plane.  The executor evaluates the
+  // source module and the source modules of the layers together, one Noise
+  // module at a time over the whole tile.
+  //
+  // A seamless Noise map blends each point with the points offset by the
+  // extents of the plane, which lie in the other three quadrants of a plane
+  // twice as wide and twice as high.  The tile is extended into those
+  // quadrants so that all four samples of every point are evaluated by a
+  // single pass of the executor, and then blended in a separate pass.
+  size_t outputCount = GetDestNoiseMaps ().size ();
+  BuildTiles ([&] (int x0, int z0, int width, int height,
+    RasterExecutor& executor, std::vector<double>& workspace,
+    double* const* values) {
+    int count = width * height;
+    if (!m_isSeamlessEnabled) {
+      workspace.resize (3 * count);
+      double* xTile = &workspace[0];
+      double* yTile = xTile + count;
+      double* zTile = yTile + count;
+      for (int z = 0; z < height; z++) {
+        double zCur = m_lowerZBound + (z0 + z) * zDelta;
+        for (int x = 0; x < width; x++) {
+          xTile[z * width + x] = xColumns[x0 + x];
+          yTile[z * width + x] = 0.0;
+          zTile[z * width + x] = zCur;
+        }
+      }
+      executor.GetValues (count, xTile, yTile, zTile, values);
+      return;
+    }
+
+    // The extended tile stores the quadrants one after another: the points
+    // themselves, then the points offset along x, along z, and along both.
+    // The offset coordinates are calculated exactly as before, so that the
+    // output values are unchanged.
+    int quadCount = 4 * count;
+    workspace.resize ((3 + outputCount) * quadCount);
+    double* xQuad = &workspace[0];
+    double* yQuad = xQuad + quadCount;
+    double* zQuad = yQuad + quadCount;
+    double* valueQuads = zQuad + quadCount;
+    for (int z = 0; z < height; z++) {
+      double zCur = m_lowerZBound + (z0 + z) * zDelta;
+      double zOffset = zCur + zExtent;
+      for (int x = 0; x < width; x++) {
+        int i = z * width + x;
+        double xCur = xColumns[x0 + x];
+        double xOffset = xCur + xExtent;
+        xQuad[i            ] = xCur   ; zQuad[i            ] = zCur   ;
+        xQuad[i +     count] = xOffset; zQuad[i +     count] = zCur   ;
+        xQuad[i + 2 * count] = xCur   ; zQuad[i + 2 * count] = zOffset;
+        xQuad[i + 3 * count] = xOffset; zQuad[i + 3 * count] = zOffset;
       }
-      *pDest++ = finalValue;
-      xCur += xDelta;
     }
-    zCur += zDelta;
-    if (m_pCallback != NULL) {
-      m_pCallback (z);
+    std::fill (yQuad, yQuad + quadCount, 0.0);
+    std::vector<double*> valueQuadRows (outputCount);
+    for (size_t i = 0; i < outputCount; i++) {
+      valueQuadRows[i] = valueQuads + i * quadCount;
     }
-  }
+    executor.GetValues (quadCount, xQuad, yQuad, zQuad, &valueQuadRows[0]);
+
+    for (size_t i = 0; i < outputCount; i++) {
+      const double* sw = valueQuadRows[i];
+      const double* se = sw + count;
+      const double* nw = se + count;
+      const double* ne = nw + count;
+      double* pValue = values[i];
+      for (int z = 0; z < height; z++) {
+        double zCur = m_lowerZBound + (z0 + z) * zDelta;
+        double zBlend = 1.0 - ((zCur - m_lowerZBound) / zExtent);
+        const double* pXBlend = &xBlends[x0];
+        for (int x = 0; x < width; x++) {
+          int j = z * width + x;
+          double z0Value = LinearInterp (sw[j], se[j], pXBlend[x]);
+          double z1Value = LinearInterp (nw[j], ne[j], pXBlend[x]);
+          pValue[j] = LinearInterp (z0Value, z1Value, zBlend);
+        }
+      }
+    }
+  });
 }
 
 /////////////////////////////////////////////////////////////////////////////
 // NoiseMapBuilderSphere class
 
 NoiseMapBuilderSphere::NoiseMapBuilderSphere ():
+  m_isReducedGridEnabled (false),
   m_eastLonBound  (0.0),
   m_northLatBound (0.0),
   m_southLatBound (0.0),
@@ -443,39 +1304,472 @@ void NoiseMapBuilderSphere::Build ()
     || m_destWidth <= 0
     || m_destHeight <= 0
     || m_pSourceModule == NULL
-    || m_pDestNoiseMap == NULL) {
+    || !HasDestNoiseMap ()) {
     throw noise::ExceptionInvalidParam ();
   }
 
-  // Resize the destination Noise map so that it can store the new output
-  // values from the source model.
-  m_pDestNoiseMap->SetSize (m_destWidth, m_destHeight);
-
-  // Create the plane model.
-  model::Sphere sphereModel;
-  sphereModel.SetModule (*m_pSourceModule);
-
   double lonExtent = m_eastLonBound  - m_westLonBound ;
   double latExtent = m_northLatBound - m_southLatBound;
   double xDelta = lonExtent / (double)m_destWidth ;
   double yDelta = latExtent / (double)m_destHeight;
-  double curLon = m_westLonBound ;
-  double curLat = m_southLatBound;
 
-  // Fill every point in the Noise map with the output values from the model.
+  // Every row has the same longitudes, so their sines and cosines are only
+  // calculated once.  The coordinates of each point are calculated from its
+  // indices, so that every tile can be generated independently, and then
+  // the same way as LatLonToXYZ() calculates them.
+  std::vector<double> lonAngles (m_destWidth);
+  std::vector<double> sinLon (m_destWidth);
+  std::vector<double> cosLon (m_destWidth);
+  for (int x = 0; x < m_destWidth; x++) {
+    lonAngles[x] = DEG_TO_RAD * (m_westLonBound + x * xDelta);
+  }
+  MathSinCos (m_destWidth, &lonAngles[0], &sinLon[0], &cosLon[0]);
+
+  if (m_refinementTolerance > 0.0 && !m_isReducedGridEnabled) {
+    std::vector<double> sinLat (m_destHeight);
+    std::vector<double> cosLat (m_destHeight);
+    for (int y = 0; y < m_destHeight; y++) {
+      MathSinCos (DEG_TO_RAD * (m_southLatBound + y * yDelta), sinLat[y],
+        cosLat[y]);
+    }
+    BuildRefinedTiles ([&] (int count, const int* columns, const int* rows,
+      double* x, double* y, double* z) {
+      for (int i = 0; i < count; i++) {
+        x[i] = cosLat[rows[i]] * cosLon[columns[i]];
+        y[i] = sinLat[rows[i]];
+        z[i] = cosLat[rows[i]] * sinLon[columns[i]];
+      }
+    });
+    return;
+  }
+
+  // Each tile of the Noise map is evaluated as a single tile of input values
+  // located on the surface of the sphere.  The executor evaluates the
+  // source module and the source modules of the layers together, one Noise
+  // module at a time over the whole tile.
+  if (!m_isReducedGridEnabled) {
+    BuildTiles ([&] (int x0, int y0, int width, int height,
+      RasterExecutor& executor, std::vector<double>& workspace,
+      double* const* values) {
+      int count = width * height;
+      workspace.resize (3 * count);
+      double* xTile = &workspace[0];
+      double* yTile = xTile + count;
+      double* zTile = yTile + count;
+      for (int y = 0; y < height; y++) {
+        double sinLat, cosLat;
+        MathSinCos (DEG_TO_RAD * (m_southLatBound + (y0 + y) * yDelta),
+          sinLat, cosLat);
+        for (int x = 0; x < width; x++) {
+          xTile[y * width + x] = cosLat * cosLon[x0 + x];
+          yTile[y * width + x] = sinLat;
+          zTile[y * width + x] = cosLat * sinLon[x0 + x];
+        }
+      }
+      executor.GetValues (count, xTile, yTile, zTile, values);
+    });
+    return;
+  }
+
+  // The reduced grid evaluates each row at a number of evenly spaced
+  // longitudes that is proportional to the cosine of its latitude, so the
+  // points are about as far apart near the poles as at the equator.  A row
+  // with fewer points than the Noise map is wide is evaluated at one more
+  // point, on its eastern boundary, so that every column of the Noise map
+  // lies between two points of the row.
+  std::vector<int> rowPointCounts (m_destHeight);
   for (int y = 0; y < m_destHeight; y++) {
-    float* pDest = m_pDestNoiseMap->GetSlabPtr (y);
-    curLon = m_westLonBound;
-    for (int x = 0; x < m_destWidth; x++) {
-      float curValue = (float)sphereModel.GetValue (curLat, curLon);
-      *pDest++ = curValue;
-      curLon += xDelta;
+    double lat = m_southLatBound + y * yDelta;
+    int pointCount = (int)ceil (m_destWidth * cos (DEG_TO_RAD * lat));
+    rowPointCounts[y] = GetMax (1, GetMin (pointCount, m_destWidth));
+  }
+
+  // Each tile evaluates the points of its rows that lie within or next to
+  // it, then resamples them onto its columns by linear interpolation along
+  // the row.  The points that two tiles share are evaluated by both, at the
+  // same coordinates, so the Noise map does not depend on the size of the
+  // tiles.  A row with as many points as the Noise map is wide is evaluated
+  // exactly as if the reduced grid were disabled.
+  size_t outputCount = GetDestNoiseMaps ().size ();
+  BuildTiles ([&] (int x0, int y0, int width, int height,
+    RasterExecutor& executor, std::vector<double>& workspace,
+    double* const* values) {
+    std::vector<int> firstPoints (height);
+    std::vector<int> rowOffsets (height + 1, 0);
+    for (int y = 0; y < height; y++) {
+      int pointCount = rowPointCounts[y0 + y];
+      int firstPoint = x0, lastPoint = x0 + width - 1;
+      if (pointCount < m_destWidth) {
+        firstPoint = (int)((double)x0 * pointCount / m_destWidth);
+        lastPoint = (int)((double)lastPoint * pointCount / m_destWidth) + 1;
+      }
+      firstPoints[y] = firstPoint;
+      rowOffsets[y + 1] = rowOffsets[y] + lastPoint - firstPoint + 1;
+    }
+
+    int count = rowOffsets[height];
+    workspace.resize ((5 + outputCount) * count);
+    double* xPoints = &workspace[0];
+    double* yPoints = xPoints + count;
+    double* zPoints = yPoints + count;
+    double* sinPoints = zPoints + count;
+    double* cosPoints = sinPoints + count;
+    std::vector<double*> pointValues (outputCount);
+    for (size_t i = 0; i < outputCount; i++) {
+      pointValues[i] = cosPoints + (1 + i) * count;
     }
-    curLat += yDelta;
-    if (m_pCallback != NULL) {
-      m_pCallback (y);
+    for (int y = 0; y < height; y++) {
+      int pointCount = rowPointCounts[y0 + y];
+      double pointDelta = lonExtent / (double)pointCount;
+      for (int i = rowOffsets[y]; i < rowOffsets[y + 1]; i++) {
+        int point = firstPoints[y] + i - rowOffsets[y];
+        xPoints[i] = DEG_TO_RAD * (m_westLonBound + point * pointDelta);
+      }
+    }
+    MathSinCos (count, xPoints, sinPoints, cosPoints);
+    for (int y = 0; y < height; y++) {
+      double sinLat, cosLat;
+      MathSinCos (DEG_TO_RAD * (m_southLatBound + (y0 + y) * yDelta),
+        sinLat, cosLat);
+      for (int i = rowOffsets[y]; i < rowOffsets[y + 1]; i++) {
+        xPoints[i] = cosLat * cosPoints[i];
+        yPoints[i] = sinLat;
+        zPoints[i] = cosLat * sinPoints[i];
+      }
     }
+    executor.GetValues (count, xPoints, yPoints, zPoints, &pointValues[0]);
+
+    for (size_t i = 0; i < outputCount; i++) {
+      for (int y = 0; y < height; y++) {
+        int pointCount = rowPointCounts[y0 + y];
+        const double* pRowValues = pointValues[i] + rowOffsets[y]
+          - firstPoints[y];
+        double* pDest = values[i] + y * width;
+        for (int x = 0; x < width; x++) {
+          if (pointCount == m_destWidth) {
+            pDest[x] = pRowValues[x0 + x];
+          } else {
+            double t = (double)(x0 + x) * pointCount / m_destWidth;
+            int point = (int)t;
+            pDest[x] = LinearInterp (pRowValues[point], pRowValues[point + 1],
+              t - point);
+          }
+        }
+      }
+    }
+  });
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// TilePyramidBuilder class
+
+TilePyramidBuilder::TilePyramidBuilder ():
+  m_eastLonBound  (180.0),
+  m_isDetailLimitEnabled (true),
+  m_maxLevel      (0),
+  m_northLatBound (90.0),
+  m_pCancellationToken (NULL),
+  m_pDestSink     (NULL),
+  m_pProgressCallback (NULL),
+  m_pProgressContext (NULL),
+  m_projection    (DEFAULT_PYRAMID_PROJECTION),
+  m_pSourceModule (NULL),
+  m_southLatBound (-90.0),
+  m_threadCount   (DEFAULT_BUILDER_THREAD_COUNT),
+  m_tileSize      (DEFAULT_PYRAMID_TILE_SIZE),
+  m_westLonBound  (-180.0)
+{
+}
+
+void TilePyramidBuilder::Build ()
+{
+  if (m_pSourceModule == NULL || m_pDestSink == NULL) {
+    throw noise::ExceptionInvalidParam ();
+  }
+
+  // The sink is aborted if the build stops before every tile was written.
+  struct SinkGuard
+  {
+    PyramidTileSink* pSink;
+    ~SinkGuard ()
+    {
+      if (pSink != NULL) {
+        pSink->Abort ();
+      }
+    }
+  } sinkGuard = {m_pDestSink};
+
+  // The tiles of every level are numbered one after another, coarse levels
+  // first, so that the order of the numbers is the order of priority.
+  std::vector<LevelRange> ranges (m_maxLevel + 1);
+  std::int64_t tileCount = 0;
+  for (int level = 0; level <= m_maxLevel; level++) {
+    ranges[level] = GetLevelRange (level);
+    ranges[level].firstTile = tileCount;
+    tileCount += (std::int64_t)(ranges[level].xEnd - ranges[level].xBegin)
+      * (ranges[level].yEnd - ranges[level].yBegin);
+  }
+
+  // Each level is evaluated from its own copy of the graph, whose octaves
+  // stop at the detail that the points of the level can resolve.
+  std::vector<std::unique_ptr<ModuleGraph>> levelGraphs (m_maxLevel + 1);
+  std::vector<const Module*> levelModules (m_maxLevel + 1, m_pSourceModule);
+  if (m_isDetailLimitEnabled) {
+    for (int level = 0; level <= m_maxLevel; level++) {
+      levelGraphs[level] = LimitGraphDetail (*m_pSourceModule,
+        GetMaxFrequency (level));
+      levelModules[level] = &levelGraphs[level]->GetRoot ();
+    }
+  }
+
+  if (m_pScheduler == nullptr
+    || m_pScheduler->GetThreadCount () != m_threadCount) {
+    m_pScheduler.reset ();
+    m_pScheduler = std::make_unique<TaskScheduler> (m_threadCount);
+  }
+
+  // Each thread keeps the executor of the level it last built a tile of.
+  // Since the tiles are handed out level by level, a thread creates at most
+  // one executor per level.
+  struct ThreadBuffers
+  {
+    int level = -1;
+    std::unique_ptr<RasterExecutor> pExecutor;
+    std::vector<double> workspace;
+    NoiseMap noiseMap;
+  };
+  std::vector<ThreadBuffers> threadBuffers (m_threadCount);
+  int tileSize = m_tileSize;
+  int count = tileSize * tileSize;
+  for (ThreadBuffers& buffers: threadBuffers) {
+    buffers.workspace.resize (4 * (size_t)count + 3 * (size_t)tileSize);
+    buffers.noiseMap.SetSize (tileSize, tileSize);
+  }
+
+  std::mutex sinkMutex;
+  std::atomic<std::int64_t> completedPointCount (0);
+  std::mutex progressMutex;
+  auto startTime = std::chrono::steady_clock::now ();
+  auto reportProgress = [&] () {
+    BuildProgress progress;
+    progress.completedPointCount = completedPointCount;
+    progress.totalPointCount = tileCount * count;
+    progress.elapsedTime = std::chrono::duration<double> (
+      std::chrono::steady_clock::now () - startTime).count ();
+    progress.remainingTime = 0.0;
+    if (progress.completedPointCount > 0) {
+      progress.remainingTime = progress.elapsedTime
+        * (double)(progress.totalPointCount - progress.completedPointCount)
+        / (double)progress.completedPointCount;
+    }
+    progress.pContext = m_pProgressContext;
+    m_pProgressCallback (progress);
+  };
+
+  // The scheduler splits its tasks into a contiguous range per thread,
+  // which would leave the fine levels of one thread waiting behind the
+  // coarse levels of another.  Instead, every task takes the next tile from
+  // a shared counter, so the tiles start in the order of their numbers
+  // whichever thread runs them.  The tasks are run in batches so that their
+  // number fits within an int.
+  const std::int64_t batchSize = 1 << 20;
+  for (std::int64_t firstTile = 0; firstTile < tileCount;
+    firstTile += batchSize) {
+    int batchTileCount = (int)GetMin (batchSize, tileCount - firstTile);
+    std::atomic<int> nextTask (0);
+    m_pScheduler->Run (batchTileCount, [&] (int, int thread) {
+      if (m_pCancellationToken != NULL
+        && m_pCancellationToken->IsCancelled ()) {
+        throw noise::ExceptionCancelled ();
+      }
+      std::int64_t tileIndex = firstTile + nextTask++;
+      PyramidTile tile;
+      tile.level = 0;
+      while (tile.level < m_maxLevel
+        && ranges[tile.level + 1].firstTile <= tileIndex) {
+        ++tile.level;
+      }
+      const LevelRange& range = ranges[tile.level];
+      int rangeWidth = range.xEnd - range.xBegin;
+      tile.x = range.xBegin
+        + (int)((tileIndex - range.firstTile) % rangeWidth);
+      tile.y = range.yBegin
+        + (int)((tileIndex - range.firstTile) / rangeWidth);
+
+      ThreadBuffers& buffers = threadBuffers[thread];
+      if (buffers.level != tile.level) {
+        buffers.pExecutor.reset ();
+        buffers.pExecutor = std::make_unique<RasterExecutor> (
+          *levelModules[tile.level]);
+        buffers.level = tile.level;
+      }
+
+      // Every row of the tile has the same longitudes, so their sines and
+      // cosines are only calculated once.  Each point lies at the center of
+      // its area, and the first row of the Noise map is the southern edge
+      // of the tile.
+      double* xTile = &buffers.workspace[0];
+      double* yTile = xTile + count;
+      double* zTile = yTile + count;
+      double* values = zTile + count;
+      double* lonAngles = values + count;
+      double* sinLon = lonAngles + tileSize;
+      double* cosLon = sinLon + tileSize;
+      double levelWidth = (double)GetTileColumnCount (tile.level) * tileSize;
+      for (int x = 0; x < tileSize; x++) {
+        double column = (double)tile.x * tileSize + x + 0.5;
+        lonAngles[x] = DEG_TO_RAD * (-180.0 + column * 360.0 / levelWidth);
+      }
+      MathSinCos (tileSize, lonAngles, sinLon, cosLon);
+      for (int y = 0; y < tileSize; y++) {
+        double row = (double)tile.y * tileSize + (tileSize - 1 - y) + 0.5;
+        double sinLat, cosLat;
+        MathSinCos (DEG_TO_RAD * GetRowLatitude (tile.level, row), sinLat,
+          cosLat);
+        for (int x = 0; x < tileSize; x++) {
+          xTile[y * tileSize + x] = cosLat * cosLon[x];
+          yTile[y * tileSize + x] = sinLat;
+          zTile[y * tileSize + x] = cosLat * sinLon[x];
+        }
+      }
+      buffers.pExecutor->GetValues (count, xTile, yTile, zTile, values);
+
+      const double* pValue = values;
+      for (int y = 0; y < tileSize; y++) {
+        float* pDest = buffers.noiseMap.GetSlabPtr (y);
+        for (int x = 0; x < tileSize; x++) {
+          *pDest++ = (float)*pValue++;
+        }
+      }
+      {
+        std::lock_guard<std::mutex> lock (sinkMutex);
+        m_pDestSink->WriteTile (tile, buffers.noiseMap);
+      }
+
+      completedPointCount.fetch_add (count, std::memory_order_relaxed);
+      if (m_pProgressCallback != NULL) {
+        std::unique_lock<std::mutex> lock (progressMutex, std::try_to_lock);
+        if (lock.owns_lock ()) {
+          reportProgress ();
+        }
+      }
+    });
+  }
+  sinkGuard.pSink = NULL;
+
+  // Report the completed pyramid, which a skipped call may have missed.
+  if (m_pProgressCallback != NULL) {
+    std::lock_guard<std::mutex> lock (progressMutex);
+    reportProgress ();
+  }
+}
+
+double TilePyramidBuilder::GetLatitudeRow (int level, double lat) const
+{
+  double levelHeight = (double)GetTileRowCount (level) * m_tileSize;
+  if (m_projection == PYRAMID_PROJECTION_MERCATOR) {
+    double maxLat = RAD_TO_DEG * atan (sinh (PI));
+    double angle = DEG_TO_RAD * GetMax (-maxLat, GetMin (lat, maxLat));
+    return levelHeight * (1.0 - log (tan (angle) + 1.0 / cos (angle)) / PI)
+      / 2.0;
+  }
+  return levelHeight * (90.0 - lat) / 180.0;
+}
+
+TilePyramidBuilder::LevelRange TilePyramidBuilder::GetLevelRange (
+  int level) const
+{
+  // The region is converted to tile coordinates, then widened to whole
+  // tiles.
+  int columnCount = GetTileColumnCount (level);
+  int rowCount = GetTileRowCount (level);
+  LevelRange range;
+  range.xBegin = (int)floor ((m_westLonBound + 180.0) / 360.0 * columnCount);
+  range.xEnd = (int)ceil ((m_eastLonBound + 180.0) / 360.0 * columnCount);
+  range.yBegin = (int)floor (GetLatitudeRow (level, m_northLatBound)
+    / m_tileSize);
+  range.yEnd = (int)ceil (GetLatitudeRow (level, m_southLatBound)
+    / m_tileSize);
+  range.xBegin = GetMax (0, GetMin (range.xBegin, columnCount));
+  range.xEnd = GetMax (range.xBegin, GetMin (range.xEnd, columnCount));
+  range.yBegin = GetMax (0, GetMin (range.yBegin, rowCount));
+  range.yEnd = GetMax (range.yBegin, GetMin (range.yEnd, rowCount));
+  range.firstTile = 0;
+  return range;
+}
+
+double TilePyramidBuilder::GetMaxFrequency (int level) const
+{
+  // The equator of the unit sphere is 2 * PI long.
+  double levelWidth = (double)GetTileColumnCount (level) * m_tileSize;
+  return levelWidth / (4.0 * PI);
+}
+
+double TilePyramidBuilder::GetRowLatitude (int level, double row) const
+{
+  double levelHeight = (double)GetTileRowCount (level) * m_tileSize;
+  if (m_projection == PYRAMID_PROJECTION_MERCATOR) {
+    return RAD_TO_DEG * atan (sinh (PI * (1.0 - 2.0 * row / levelHeight)));
+  }
+  return 90.0 - 180.0 * row / levelHeight;
+}
+
+void TilePyramidBuilder::GetTileBounds (const PyramidTile& tile,
+  double& southLatBound, double& northLatBound, double& westLonBound,
+  double& eastLonBound) const
+{
+  double columnCount = GetTileColumnCount (tile.level);
+  westLonBound = -180.0 + 360.0 * tile.x / columnCount;
+  eastLonBound = -180.0 + 360.0 * (tile.x + 1) / columnCount;
+  northLatBound = GetRowLatitude (tile.level, (double)tile.y * m_tileSize);
+  southLatBound = GetRowLatitude (tile.level,
+    (double)(tile.y + 1) * m_tileSize);
+}
+
+int TilePyramidBuilder::GetTileColumnCount (int level) const
+{
+  if (m_projection == PYRAMID_PROJECTION_EQUIRECTANGULAR) {
+    return 2 << level;
   }
+  return 1 << level;
+}
+
+void TilePyramidBuilder::SetBounds (double southLatBound,
+  double northLatBound, double westLonBound, double eastLonBound)
+{
+  if (!(southLatBound < northLatBound) || !(westLonBound < eastLonBound)
+    || southLatBound < -90.0 || northLatBound > 90.0
+    || westLonBound < -180.0 || eastLonBound > 180.0) {
+    throw noise::ExceptionInvalidParam ();
+  }
+  m_southLatBound = southLatBound;
+  m_northLatBound = northLatBound;
+  m_westLonBound  = westLonBound ;
+  m_eastLonBound  = eastLonBound ;
+}
+
+void TilePyramidBuilder::SetMaxLevel (int maxLevel)
+{
+  if (maxLevel < 0 || maxLevel > PYRAMID_MAX_LEVEL) {
+    throw noise::ExceptionInvalidParam ();
+  }
+  m_maxLevel = maxLevel;
+}
+
+void TilePyramidBuilder::SetThreadCount (int threadCount)
+{
+  if (threadCount < 1) {
+    throw noise::ExceptionInvalidParam ();
+  }
+  m_threadCount = threadCount;
+}
+
+void TilePyramidBuilder::SetTileSize (int tileSize)
+{
+  if (tileSize < 1 || tileSize > RASTER_MAX_WIDTH) {
+    throw noise::ExceptionInvalidParam ();
+  }
+  m_tileSize = tileSize;
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -493,6 +1787,11 @@ RendererImage::RendererImage ():
   m_pBackgroundImage  (NULL),
   m_pDestImage        (NULL),
   m_pSourceNoiseMap   (NULL),
+  m_pSourceTiledNoiseMap (NULL),
+  m_sourceWindowHeight (0),
+  m_sourceWindowWidth  (0),
+  m_sourceWindowX      (0),
+  m_sourceWindowY      (0),
   m_recalcLightValues (true)
 {
   BuildGrayscaleGradient ();
@@ -608,16 +1907,26 @@ void RendererImage::ClearGradient ()
 
 void RendererImage::Render ()
 {
-  if ( m_pSourceNoiseMap == NULL
+  // A window of a tiled Noise map is copied into a Noise map, then rendered
+  // like any other Noise map.
+  NoiseMap sourceWindow;
+  const NoiseMap* pSourceNoiseMap = m_pSourceNoiseMap;
+  if (m_pSourceTiledNoiseMap != NULL) {
+    m_pSourceTiledNoiseMap->CopyToNoiseMap (sourceWindow, m_sourceWindowX,
+      m_sourceWindowY, m_sourceWindowWidth, m_sourceWindowHeight);
+    pSourceNoiseMap = &sourceWindow;
+  }
+
+  if ( pSourceNoiseMap == NULL
     || m_pDestImage == NULL
-    || m_pSourceNoiseMap->GetWidth  () <= 0
-    || m_pSourceNoiseMap->GetHeight () <= 0
+    || pSourceNoiseMap->GetWidth  () <= 0
+    || pSourceNoiseMap->GetHeight () <= 0
     || m_gradient.GetGradientPointCount () < 2) {
     throw noise::ExceptionInvalidParam ();
   }
 
-  int width  = m_pSourceNoiseMap->GetWidth  ();
-  int height = m_pSourceNoiseMap->GetHeight ();
+  int width  = pSourceNoiseMap->GetWidth  ();
+  int height = pSourceNoiseMap->GetHeight ();
 
   // If a background image was provided, make sure it is the same size the
   // source Noise map.
@@ -639,7 +1948,7 @@ void RendererImage::Render ()
     if (m_pBackgroundImage != NULL) {
       pBackground = m_pBackgroundImage->GetConstSlabPtr (y);
     }
-    const float* pSource = m_pSourceNoiseMap->GetConstSlabPtr (y);
+    const float* pSource = pSourceNoiseMap->GetConstSlabPtr (y);
     Color* pDest = m_pDestImage->GetSlabPtr (y);
     for (int x = 0; x < width; x++) {
 
@@ -698,8 +2007,8 @@ void RendererImage::Render ()
             yUpOffset   = 1;
           }
         }
-        yDownOffset *= m_pSourceNoiseMap->GetStride ();
-        yUpOffset   *= m_pSourceNoiseMap->GetStride ();
+        yDownOffset *= pSourceNoiseMap->GetStride ();
+        yUpOffset   *= pSourceNoiseMap->GetStride ();
 
         // Get the Noise value of the current point in the source Noise map
         // and the Noise values of its four-neighbors.
@@ -747,7 +2056,12 @@ RendererNormalMap::RendererNormalMap ():
   m_bumpHeight      (1.0),
   m_isWrapEnabled   (false),
   m_pDestImage      (NULL),
-  m_pSourceNoiseMap (NULL)
+  m_pSourceNoiseMap (NULL),
+  m_pSourceTiledNoiseMap (NULL),
+  m_sourceWindowHeight (0),
+  m_sourceWindowWidth  (0),
+  m_sourceWindowX (0),
+  m_sourceWindowY (0)
 {
 };
 
@@ -777,18 +2091,28 @@ Color RendererNormalMap::CalcNormalColor (double nc, double nr, double nu,
 
 void RendererNormalMap::Render ()
 {
-  if ( m_pSourceNoiseMap == NULL
+  // A window of a tiled Noise map is copied into a Noise map, then rendered
+  // like any other Noise map.
+  NoiseMap sourceWindow;
+  const NoiseMap* pSourceNoiseMap = m_pSourceNoiseMap;
+  if (m_pSourceTiledNoiseMap != NULL) {
+    m_pSourceTiledNoiseMap->CopyToNoiseMap (sourceWindow, m_sourceWindowX,
+      m_sourceWindowY, m_sourceWindowWidth, m_sourceWindowHeight);
+    pSourceNoiseMap = &sourceWindow;
+  }
+
+  if ( pSourceNoiseMap == NULL
     || m_pDestImage == NULL
-    || m_pSourceNoiseMap->GetWidth  () <= 0
-    || m_pSourceNoiseMap->GetHeight () <= 0) {
+    || pSourceNoiseMap->GetWidth  () <= 0
+    || pSourceNoiseMap->GetHeight () <= 0) {
     throw noise::ExceptionInvalidParam ();
   }
 
-  int width  = m_pSourceNoiseMap->GetWidth  ();
-  int height = m_pSourceNoiseMap->GetHeight ();
+  int width  = pSourceNoiseMap->GetWidth  ();
+  int height = pSourceNoiseMap->GetHeight ();
 
   for (int y = 0; y < height; y++) {
-    const float* pSource = m_pSourceNoiseMap->GetConstSlabPtr (y);
+    const float* pSource = pSourceNoiseMap->GetConstSlabPtr (y);
     Color* pDest = m_pDestImage->GetSlabPtr (y);
     for (int x = 0; x < width; x++) {
 
@@ -818,7 +2142,7 @@ void RendererNormalMap::Render ()
           yUpOffset = 1;
         }
       }
-      yUpOffset *= m_pSourceNoiseMap->GetStride ();
+      yUpOffset *= pSourceNoiseMap->GetStride ();
 
       // Get the Noise value of the current point in the source Noise map
       // and the Noise values of its right and up neighbors.